@@ -0,0 +1,98 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Measures the scalability of the geoid height conversion over 1 to 32 threads.
+// usage: benchmark_geoid_height [conversions per thread]
+
+#include <GeographicLib/Geoid.hpp>
+#include <autoware/geography_utils/height.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+using HeightFunction = std::function<double(double, double, double)>;
+
+// returns the total number of conversions per second
+double run(const HeightFunction & convert, const int num_threads, const int num_conversions)
+{
+  std::atomic<bool> start{false};
+  std::atomic<int> ready{0};
+  std::vector<double> sums(num_threads, 0.0);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < num_threads; ++i) {
+    threads.emplace_back([&, i]() {
+      ready.fetch_add(1);
+      while (!start.load()) {
+        std::this_thread::yield();
+      }
+      // each thread walks over its own area within 0.1 degrees
+      double sum = 0.0;
+      for (int j = 0; j < num_conversions; ++j) {
+        const double latitude = 35.0 + 0.01 * i + 1e-6 * (j % 1000);
+        const double longitude = 139.0 + 0.01 * i + 1e-6 * (j / 1000 % 1000);
+        sum += convert(10.0, latitude, longitude);
+      }
+      sums[i] = sum;
+    });
+  }
+  while (ready.load() < num_threads) {
+    std::this_thread::yield();
+  }
+
+  const auto start_time = std::chrono::steady_clock::now();
+  start.store(true);
+  for (auto & thread : threads) {
+    thread.join();
+  }
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start_time;
+  return static_cast<double>(num_threads) * num_conversions / elapsed.count();
+}
+}  // namespace
+
+int main(int argc, char * argv[])
+{
+  const int num_conversions = argc > 1 ? std::atoi(argv[1]) : 100000;
+
+  // baseline: a single geoid serialized behind a mutex
+  std::mutex mutex;
+  GeographicLib::Geoid locked_geoid("egm2008-1");
+  // cSpell: ignore ELLIPSOIDTOGEOID
+  const HeightFunction locked = [&](double height, double latitude, double longitude) {
+    std::lock_guard<std::mutex> lock(mutex);
+    return locked_geoid.ConvertHeight(
+      latitude, longitude, height, GeographicLib::Geoid::ELLIPSOIDTOGEOID);
+  };
+
+  const autoware::geography_utils::GeoidHeightConverter per_thread_converter;
+  const HeightFunction per_thread = [&](double height, double latitude, double longitude) {
+    return per_thread_converter.convert_wgs84_to_egm2008(height, latitude, longitude);
+  };
+
+  std::printf("%8s %20s %20s\n", "threads", "mutex [conv/s]", "per-thread [conv/s]");
+  for (const int num_threads : {1, 2, 4, 8, 16, 32}) {
+    const double locked_rate = run(locked, num_threads, num_conversions);
+    const double per_thread_rate = run(per_thread, num_threads, num_conversions);
+    std::printf("%8d %20.0f %20.0f\n", num_threads, locked_rate, per_thread_rate);
+  }
+  return 0;
+}
@@ -0,0 +1,90 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Measures the decode time of the tiles of a tiled geoid file and the latency of geoid_height with
+// the tiles of the area cached, compared with GeographicLib::Geoid.
+// usage: benchmark_geoid_tile [path of the tiled geoid file to write] [repetitions]
+
+#include <GeographicLib/Geoid.hpp>
+#include <autoware/geography_utils/geoid_tile.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace
+{
+template <class FunctionT>
+double measure_ns(const int repetitions, FunctionT && function)
+{
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < repetitions; ++i) {
+    function(i);
+  }
+  const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+  return elapsed.count() / repetitions;
+}
+}  // namespace
+
+int main(int argc, char * argv[])
+{
+  namespace geography_utils = autoware::geography_utils;
+
+  const std::string path =
+    argc > 1 ? argv[1]
+             : (std::filesystem::temp_directory_path() / "benchmark_geoid_tile.awgt").string();
+  const int repetitions = argc > 2 ? std::atoi(argv[2]) : 100000;
+
+  // 1 x 1.5 degrees of egm2008-1 around Tokyo, as in the README
+  const GeographicLib::Geoid geoid("egm2008-1");
+  geography_utils::GeoidTileGridInfo info;
+  info.south_latitude = 35.0;
+  info.west_longitude = 139.0;
+  info.num_rows = 61;
+  info.num_columns = 91;
+  geography_utils::write_geoid_tile_file(
+    path, info, [&geoid](const double latitude, const double longitude) {
+      return geoid(latitude, longitude);
+    });
+  const geography_utils::GeoidTileFile tile_file(path);
+
+  std::vector<int32_t> values;
+  double sum = 0.0;
+  const double decode_ns = measure_ns(repetitions, [&](const int i) {
+    tile_file.decode_tile(static_cast<std::size_t>(i) % tile_file.num_tiles(), values);
+    sum += values.back();
+  });
+
+  // walks over a single cell, so that the tiles stay cached
+  const auto latitude = [](const int i) { return 35.5 + 1e-3 * (i % 16) / 16.0; };
+  const auto longitude = [](const int i) { return 139.5 + 1e-3 * (i / 16 % 16) / 16.0; };
+  const double tile_ns = measure_ns(repetitions, [&](const int i) {
+    sum += tile_file.geoid_height(latitude(i), longitude(i));
+  });
+  const double geoid_ns =
+    measure_ns(repetitions, [&](const int i) { sum += geoid(latitude(i), longitude(i)); });
+
+  std::printf(
+    "tiles: %zu of %u x %u nodes\n", tile_file.num_tiles(), info.tile_size, info.tile_size);
+  std::printf("decode a tile:                    %10.0f ns\n", decode_ns);
+  std::printf("geoid_height, cached tiles:       %10.0f ns\n", tile_ns);
+  std::printf("GeographicLib::Geoid, cached:     %10.0f ns\n", geoid_ns);
+  std::printf("(checksum %f)\n", sum);
+
+  std::filesystem::remove(path);
+  return 0;
+}
@@ -0,0 +1,45 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Round-trips random points through every projector and reports the maximum error and the latency
+// distribution of project_forward and project_reverse.
+// usage: benchmark_projection_round_trip [number of points] [seed]
+
+#include "projection_round_trip.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+
+int main(int argc, char * argv[])
+{
+  namespace round_trip = autoware::geography_utils::round_trip;
+
+  const size_t num_points = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+  const auto seed = static_cast<uint32_t>(argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 0);
+
+  std::printf(
+    "%-20s %14s %14s | %-32s | %-32s\n", "projector", "max xy err [m]", "max z err [m]",
+    "forward p50/p99/p99.9/max [ns]", "reverse p50/p99/p99.9/max [ns]");
+  for (const auto & projector_case : round_trip::make_projector_cases()) {
+    const auto result = round_trip::run_round_trips(projector_case, num_points, seed);
+    const auto & forward = result.forward_latency;
+    const auto & reverse = result.reverse_latency;
+    std::printf(
+      "%-20s %14.3e %14.3e | %7.0f %7.0f %7.0f %8.0f | %7.0f %7.0f %7.0f %8.0f\n",
+      projector_case.name.c_str(), result.max_error.horizontal, result.max_error.vertical,
+      forward.p50, forward.p99, forward.p999, forward.max, reverse.p50, reverse.p99, reverse.p999,
+      reverse.max);
+  }
+  return 0;
+}
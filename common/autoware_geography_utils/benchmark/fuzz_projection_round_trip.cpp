@@ -0,0 +1,70 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// libFuzzer target which aborts when a round trip exceeds the error tolerance.
+// usage: fuzz_projection_round_trip [libFuzzer options] [corpus directory]
+
+#include "projection_round_trip.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+constexpr double tolerance = 0.001;  // [m]
+
+double to_unit_interval(const uint8_t * data)
+{
+  uint32_t value;
+  std::memcpy(&value, data, sizeof(value));
+  return static_cast<double>(value) / 4294967296.0;
+}
+}  // namespace
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t * data, size_t size)
+{
+  namespace round_trip = autoware::geography_utils::round_trip;
+  static const std::vector<round_trip::ProjectorCase> projector_cases =
+    round_trip::make_projector_cases();
+  static const std::vector<autoware::geography_utils::Projector> projectors = [] {
+    std::vector<autoware::geography_utils::Projector> projectors;
+    for (const auto & projector_case : projector_cases) {
+      projectors.push_back(
+        autoware::geography_utils::make_projector(projector_case.projector_info));
+    }
+    return projectors;
+  }();
+
+  if (size < 1 + 3 * sizeof(uint32_t)) {
+    return 0;
+  }
+  const size_t index = data[0] % projector_cases.size();
+  const auto local_point = round_trip::make_local_point(
+    projector_cases[index], to_unit_interval(data + 1), to_unit_interval(data + 5),
+    to_unit_interval(data + 9));
+
+  const auto error = round_trip::round_trip(projectors[index], local_point);
+  if (!(error.horizontal < tolerance && error.vertical < tolerance)) {
+    std::fprintf(
+      stderr, "%s: (%.6f, %.6f, %.6f) horizontal error %.3e, vertical error %.3e\n",
+      projector_cases[index].name.c_str(), local_point.x, local_point.y, local_point.z,
+      error.horizontal, error.vertical);
+    std::abort();
+  }
+  return 0;
+}
@@ -0,0 +1,227 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef PROJECTION_ROUND_TRIP_HPP_
+#define PROJECTION_ROUND_TRIP_HPP_
+
+#include <autoware/geography_utils/projector.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Round-trip harness shared by the unit test, the benchmark and the fuzz target.
+namespace autoware::geography_utils::round_trip
+{
+
+// grid square of the MGRS case and the edges of the UTM zone 54 around the origin of the others
+constexpr double mgrs_grid_size = 100000.0;
+constexpr double utm_zone_west = 138.0;
+constexpr double utm_zone_east = 144.0;
+
+struct ProjectorCase
+{
+  ProjectorCase(const std::string & name, const MapProjectorInfo & projector_info)
+  : name(name), projector_info(projector_info)
+  {
+    if (projector_info.projector_type == MapProjectorInfo::MGRS) {
+      return;
+    }
+    const Projector projector = make_projector(projector_info);
+    GeoPoint edge = projector_info.map_origin;
+    edge.longitude = utm_zone_west;
+    zone_west_edge_x = project_forward(edge, projector).x;
+    edge.longitude = utm_zone_east;
+    zone_east_edge_x = project_forward(edge, projector).x;
+  }
+
+  std::string name;
+  MapProjectorInfo projector_info;
+  double zone_west_edge_x{0.0};
+  double zone_east_edge_x{0.0};
+};
+
+inline std::vector<ProjectorCase> make_projector_cases()
+{
+  MapProjectorInfo mgrs;
+  mgrs.projector_type = MapProjectorInfo::MGRS;
+  mgrs.mgrs_grid = "54SUE";
+  mgrs.vertical_datum = MapProjectorInfo::WGS84;
+
+  MapProjectorInfo utm;
+  utm.projector_type = MapProjectorInfo::LOCAL_CARTESIAN_UTM;
+  utm.vertical_datum = MapProjectorInfo::WGS84;
+  utm.map_origin.latitude = 35.62426;
+  utm.map_origin.longitude = 139.74252;
+  utm.map_origin.altitude = 10.0;
+
+  MapProjectorInfo transverse_mercator = utm;
+  transverse_mercator.projector_type = MapProjectorInfo::TRANSVERSE_MERCATOR;
+
+  return {{"MGRS", mgrs}, {"LocalCartesianUTM", utm}, {"TransverseMercator", transverse_mercator}};
+}
+
+/**
+ * @brief Maps three numbers in [0, 1) to a local point in the valid area of the projector.
+ *
+ * A quarter of the points are pushed within a meter of the edges of the MGRS grid square or within
+ * a few meters of the UTM zone edges, where the edge cases have been found.
+ */
+inline LocalPoint make_local_point(
+  const ProjectorCase & projector_case, const double u, const double v, const double w)
+{
+  LocalPoint local_point;
+  local_point.z = -100.0 + 1000.0 * w;
+  const bool near_edge = w < 0.25;
+
+  if (projector_case.projector_info.projector_type == MapProjectorInfo::MGRS) {
+    local_point.x = u * mgrs_grid_size;
+    local_point.y = v * mgrs_grid_size;
+    if (near_edge) {
+      // within 1 m inside of the nearest edge
+      const double offset = 4.0 * w;
+      (u < 0.5 ? local_point.x : local_point.y) = v < 0.5 ? offset : mgrs_grid_size - offset;
+    }
+    return local_point;
+  }
+
+  // +-50 km around the origin, or within 5 m of the zone edges
+  local_point.x = -50000.0 + 100000.0 * u;
+  local_point.y = -50000.0 + 100000.0 * v;
+  if (near_edge) {
+    const double edge_x =
+      u < 0.5 ? projector_case.zone_west_edge_x : projector_case.zone_east_edge_x;
+    local_point.x = edge_x + (w - 0.125) * 40.0;
+  }
+  return local_point;
+}
+
+// distance between two geo points in meters, accurate enough for small errors
+inline double get_horizontal_distance(const GeoPoint & a, const GeoPoint & b)
+{
+  constexpr double meters_per_degree = 111319.49;
+  const double dy = (a.latitude - b.latitude) * meters_per_degree;
+  const double dx =
+    (a.longitude - b.longitude) * meters_per_degree * std::cos(a.latitude * M_PI / 180.0);
+  return std::hypot(dx, dy);
+}
+
+struct RoundTripError
+{
+  double horizontal{0.0};  // [m]
+  double vertical{0.0};    // [m]
+};
+
+// compares the local point reversed to the geo point and projected back, and the geo point
+// projected forward and reversed again
+inline RoundTripError get_round_trip_error(
+  const Projector & projector, const LocalPoint & local_point, const GeoPoint & geo_point,
+  const LocalPoint & converted_local_point)
+{
+  const GeoPoint converted_geo_point = project_reverse(converted_local_point, projector);
+
+  RoundTripError error;
+  error.horizontal = std::max(
+    std::hypot(converted_local_point.x - local_point.x, converted_local_point.y - local_point.y),
+    get_horizontal_distance(geo_point, converted_geo_point));
+  error.vertical = std::max(
+    std::abs(converted_local_point.z - local_point.z),
+    std::abs(converted_geo_point.altitude - geo_point.altitude));
+  return error;
+}
+
+inline RoundTripError round_trip(const Projector & projector, const LocalPoint & local_point)
+{
+  const GeoPoint geo_point = project_reverse(local_point, projector);
+  const LocalPoint converted_local_point = project_forward(geo_point, projector);
+  return get_round_trip_error(projector, local_point, geo_point, converted_local_point);
+}
+
+struct LatencyStatistics
+{
+  double p50{0.0};  // [ns]
+  double p99{0.0};
+  double p999{0.0};
+  double max{0.0};
+};
+
+inline LatencyStatistics get_latency_statistics(std::vector<double> latencies)
+{
+  LatencyStatistics statistics;
+  if (latencies.empty()) {
+    return statistics;
+  }
+  std::sort(latencies.begin(), latencies.end());
+  const auto at = [&](const double ratio) {
+    return latencies[static_cast<size_t>(ratio * static_cast<double>(latencies.size() - 1))];
+  };
+  statistics.p50 = at(0.5);
+  statistics.p99 = at(0.99);
+  statistics.p999 = at(0.999);
+  statistics.max = latencies.back();
+  return statistics;
+}
+
+struct RoundTripResult
+{
+  RoundTripError max_error;
+  LatencyStatistics forward_latency;
+  LatencyStatistics reverse_latency;
+};
+
+// round-trips random points, recording the maximum error and the latency of every call
+inline RoundTripResult run_round_trips(
+  const ProjectorCase & projector_case, const size_t num_points, const uint32_t seed)
+{
+  const Projector projector = make_projector(projector_case.projector_info);
+  std::mt19937 engine(seed);
+  std::uniform_real_distribution<double> distribution(0.0, 1.0);
+
+  RoundTripResult result;
+  std::vector<double> forward_latencies;
+  std::vector<double> reverse_latencies;
+  forward_latencies.reserve(num_points);
+  reverse_latencies.reserve(num_points);
+  for (size_t i = 0; i < num_points; ++i) {
+    const double u = distribution(engine);
+    const double v = distribution(engine);
+    const double w = distribution(engine);
+    const LocalPoint local_point = make_local_point(projector_case, u, v, w);
+
+    const auto t0 = std::chrono::steady_clock::now();
+    const GeoPoint geo_point = project_reverse(local_point, projector);
+    const auto t1 = std::chrono::steady_clock::now();
+    const LocalPoint converted_local_point = project_forward(geo_point, projector);
+    const auto t2 = std::chrono::steady_clock::now();
+    reverse_latencies.push_back(std::chrono::duration<double, std::nano>(t1 - t0).count());
+    forward_latencies.push_back(std::chrono::duration<double, std::nano>(t2 - t1).count());
+
+    const RoundTripError error =
+      get_round_trip_error(projector, local_point, geo_point, converted_local_point);
+    result.max_error.horizontal = std::max(result.max_error.horizontal, error.horizontal);
+    result.max_error.vertical = std::max(result.max_error.vertical, error.vertical);
+  }
+  result.forward_latency = get_latency_statistics(std::move(forward_latencies));
+  result.reverse_latency = get_latency_statistics(std::move(reverse_latencies));
+  return result;
+}
+
+}  // namespace autoware::geography_utils::round_trip
+
+#endif  // PROJECTION_ROUND_TRIP_HPP_
@@ -0,0 +1,115 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__GEOGRAPHY_UTILS__GEOID_TILE_HPP_
+#define AUTOWARE__GEOGRAPHY_UTILS__GEOID_TILE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace autoware::geography_utils
+{
+
+/**
+ * Tiled geoid grid file format (little endian)
+ *
+ *   magic "AWGT", uint32 version
+ *   float64 south latitude, west longitude, resolution [deg], scale [m]
+ *   uint32 number of rows and columns of grid nodes, tile size [nodes], reserved
+ *   index: for each tile in row-major order, uint64 byte offset and uint64 byte size
+ *   tiles
+ *
+ * The geoid height of each node is quantized to int32 with the scale. A tile stores its nodes in
+ * raster order as the int32 value of the first node followed by int16 deltas, where each delta is
+ * taken from the left neighbor, or from the node above for the first node of a row.
+ */
+struct GeoidTileGridInfo
+{
+  double south_latitude{0.0};
+  double west_longitude{0.0};
+  double resolution{1.0 / 60.0};
+  double scale{0.001};
+  uint32_t num_rows{0};
+  uint32_t num_columns{0};
+  uint32_t tile_size{64};
+
+  [[nodiscard]] uint32_t num_tile_rows() const { return (num_rows + tile_size - 1) / tile_size; }
+  [[nodiscard]] uint32_t num_tile_columns() const
+  {
+    return (num_columns + tile_size - 1) / tile_size;
+  }
+};
+
+// throws std::overflow_error if a delta does not fit in int16
+[[nodiscard]] std::vector<uint8_t> encode_geoid_tile(
+  const std::vector<int32_t> & values, const uint32_t num_rows, const uint32_t num_columns);
+void decode_geoid_tile(
+  const uint8_t * data, const std::size_t size, const uint32_t num_rows,
+  const uint32_t num_columns, std::vector<int32_t> & values);
+
+using GeoidSampler = std::function<double(const double latitude, const double longitude)>;
+
+// samples the geoid height at every grid node and writes the tiled file
+void write_geoid_tile_file(
+  const std::string & path, const GeoidTileGridInfo & info, const GeoidSampler & sample);
+
+/**
+ * @brief Read-only access to a tiled geoid grid file.
+ *
+ * The file is memory-mapped and tiles are decoded on demand into a small cache owned by the calling
+ * thread, so a single instance can be shared between threads without locking. Geoid heights are
+ * bilinearly interpolated between the grid nodes, which only reads the four nodes around the point
+ * from at most four tiles, whereas GeographicLib::Geoid interpolates cubically from twelve nodes by
+ * default, so the heights differ slightly from those of GeographicLib on the same grid. The
+ * interpolation errors of both methods are listed for each grid in the GeographicLib documentation.
+ */
+class GeoidTileFile
+{
+public:
+  explicit GeoidTileFile(const std::string & path);
+  ~GeoidTileFile();
+  GeoidTileFile(const GeoidTileFile &) = delete;
+  GeoidTileFile & operator=(const GeoidTileFile &) = delete;
+
+  [[nodiscard]] const GeoidTileGridInfo & info() const { return info_; }
+  [[nodiscard]] std::size_t num_tiles() const { return tile_offsets_.size(); }
+
+  [[nodiscard]] bool contains(const double latitude, const double longitude) const;
+
+  // throws std::out_of_range if the point is outside of the grid
+  [[nodiscard]] double geoid_height(const double latitude, const double longitude) const;
+
+  void decode_tile(const std::size_t tile_index, std::vector<int32_t> & values) const;
+
+private:
+  // position of the point in grid cells from the south west node, false if outside of the grid
+  [[nodiscard]] bool to_grid(
+    const double latitude, const double longitude, double & y, double & x) const;
+  [[nodiscard]] const std::vector<int32_t> & get_tile(const std::size_t tile_index) const;
+  [[nodiscard]] double get_node_height(const uint32_t row, const uint32_t column) const;
+
+  uint64_t id_;
+  GeoidTileGridInfo info_;
+  const uint8_t * data_{nullptr};
+  std::size_t data_size_{0};
+  std::vector<uint64_t> tile_offsets_;
+  std::vector<uint64_t> tile_sizes_;
+};
+
+}  // namespace autoware::geography_utils
+
+#endif  // AUTOWARE__GEOGRAPHY_UTILS__GEOID_TILE_HPP_
@@ -15,14 +15,69 @@
 #ifndef AUTOWARE__GEOGRAPHY_UTILS__HEIGHT_HPP_
 #define AUTOWARE__GEOGRAPHY_UTILS__HEIGHT_HPP_
 
+#include <memory>
 #include <string>
 
+namespace GeographicLib
+{
+class Geoid;
+}  // namespace GeographicLib
+
 namespace autoware::geography_utils
 {
+class GeoidTileFile;
 
 using HeightConversionFunction =
   double (*)(const double height, const double latitude, const double longitude);
 
+/**
+ * @brief Geoid height conversion which can be shared between threads without locking.
+ *
+ * GeographicLib::Geoid keeps an interpolation cache and is not thread-safe unless the whole grid
+ * is loaded into memory. By default, every thread calling this converter gets its own
+ * GeographicLib::Geoid, created on its first call, which reads the grid file through its own
+ * cache. If share_full_grid is true, the whole grid is instead loaded once on construction and
+ * shared read-only by all threads, trading memory (about 470 MB for egm2008-1) for no per-thread
+ * state at all. A converter created with from_tile_file reads the geoid from a tiled geoid file
+ * (see geoid_tile.hpp) instead, and from the fallback geoid, if any, outside of its area.
+ */
+class GeoidHeightConverter
+{
+public:
+  explicit GeoidHeightConverter(
+    const std::string & geoid_name = "egm2008-1", const std::string & geoid_path = "",
+    const bool share_full_grid = false);
+
+  // throws std::out_of_range for points outside of the tiles if fallback_geoid_name is empty
+  [[nodiscard]] static GeoidHeightConverter from_tile_file(
+    const std::string & path, const std::string & fallback_geoid_name = "",
+    const std::string & fallback_geoid_path = "");
+
+  // height of the geoid above the WGS84 ellipsoid
+  [[nodiscard]] double geoid_height(const double latitude, const double longitude) const;
+
+  [[nodiscard]] double convert_wgs84_to_egm2008(
+    const double height, const double latitude, const double longitude) const;
+  [[nodiscard]] double convert_egm2008_to_wgs84(
+    const double height, const double latitude, const double longitude) const;
+
+private:
+  struct Impl;
+
+  explicit GeoidHeightConverter(std::shared_ptr<const Impl> impl);
+
+  [[nodiscard]] const GeographicLib::Geoid & geoid() const;
+
+  std::shared_ptr<const Impl> impl_;
+};
+
+// name of the environment variable giving the tiled geoid file of the process-wide converter
+constexpr const char * geoid_tile_file_environment_variable = "AUTOWARE_GEOID_TILE_FILE";
+
+// returns the process-wide converter for egm2008-1 used by the functions below, which reads the
+// tiled geoid file given by AUTOWARE_GEOID_TILE_FILE, if set, and egm2008-1 outside of its area
+const GeoidHeightConverter & get_egm2008_converter();
+
 double convert_wgs84_to_egm2008(const double height, const double latitude, const double longitude);
 double convert_egm2008_to_wgs84(const double height, const double latitude, const double longitude);
 double convert_height(
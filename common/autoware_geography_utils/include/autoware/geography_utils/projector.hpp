@@ -0,0 +1,197 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__GEOGRAPHY_UTILS__PROJECTOR_HPP_
+#define AUTOWARE__GEOGRAPHY_UTILS__PROJECTOR_HPP_
+
+#include <autoware_lanelet2_extension/projection/mgrs_projector.hpp>
+#include <autoware_lanelet2_extension/projection/transverse_mercator_projector.hpp>
+
+#include <autoware_map_msgs/msg/map_projector_info.hpp>
+#include <geographic_msgs/msg/geo_point.hpp>
+#include <geometry_msgs/msg/point.hpp>
+
+#include <lanelet2_projection/UTM.h>
+
+#include <string>
+#include <variant>
+#include <vector>
+
+namespace autoware::geography_utils
+{
+using MapProjectorInfo = autoware_map_msgs::msg::MapProjectorInfo;
+using GeoPoint = geographic_msgs::msg::GeoPoint;
+using LocalPoint = geometry_msgs::msg::Point;
+
+namespace detail
+{
+inline lanelet::Origin to_lanelet_origin(const GeoPoint & map_origin)
+{
+  return lanelet::Origin{
+    lanelet::GPSPoint{map_origin.latitude, map_origin.longitude, map_origin.altitude}};
+}
+
+inline LocalPoint to_local_point(const lanelet::BasicPoint3d & point)
+{
+  LocalPoint local_point;
+  local_point.x = point.x();
+  local_point.y = point.y();
+  local_point.z = point.z();
+  return local_point;
+}
+
+inline GeoPoint to_geo_point(const lanelet::GPSPoint & point)
+{
+  GeoPoint geo_point;
+  geo_point.latitude = point.lat;
+  geo_point.longitude = point.lon;
+  geo_point.altitude = point.ele;
+  return geo_point;
+}
+}  // namespace detail
+
+// The projector classes below hold the lanelet2 projector by value, so that calls are resolved at
+// compile time without virtual dispatch or dynamic_cast. They behave the same as project_forward
+// and project_reverse with the corresponding MapProjectorInfo.
+//
+// They are not thread-safe: lanelet2's MGRSProjector::forward stores the grid of the last point in
+// a mutable member, so a projector must not be shared between threads calling forward. Copy it, or
+// call make_projector, for each thread instead.
+
+class MGRSProjector final
+{
+public:
+  static constexpr int precision = 9;  // set precision as 100 micro meter
+
+  explicit MGRSProjector(const std::string & mgrs_grid) : mgrs_grid_(mgrs_grid)
+  {
+    projector_.setMGRSCode(mgrs_grid_);
+  }
+
+  [[nodiscard]] LocalPoint forward(const GeoPoint & geo_point) const
+  {
+    // note that the altitude is ignored in MGRS projection conventionally
+    return detail::to_local_point(projector_.forward(
+      lanelet::GPSPoint{geo_point.latitude, geo_point.longitude, geo_point.altitude}, precision));
+  }
+
+  [[nodiscard]] GeoPoint reverse(const LocalPoint & local_point) const
+  {
+    // note that the z is ignored in MGRS projection conventionally
+    return detail::to_geo_point(projector_.reverse(
+      lanelet::BasicPoint3d{local_point.x, local_point.y, local_point.z}, mgrs_grid_));
+  }
+
+  [[nodiscard]] const lanelet::projection::MGRSProjector & lanelet_projector() const
+  {
+    return projector_;
+  }
+
+private:
+  std::string mgrs_grid_;
+  lanelet::projection::MGRSProjector projector_{};
+};
+
+// Projector with the map origin and altitude compensation shared by the UTM and transverse
+// mercator projections
+template <class LaneletProjectorT>
+class OriginBasedProjector final
+{
+public:
+  explicit OriginBasedProjector(const GeoPoint & map_origin)
+  : origin_altitude_(map_origin.altitude), projector_(detail::to_lanelet_origin(map_origin))
+  {
+  }
+
+  [[nodiscard]] LocalPoint forward(const GeoPoint & geo_point) const
+  {
+    // note that the original projector does not compensate for the altitude offset
+    LocalPoint local_point = detail::to_local_point(projector_.forward(
+      lanelet::GPSPoint{geo_point.latitude, geo_point.longitude, geo_point.altitude}));
+    local_point.z = geo_point.altitude - origin_altitude_;
+    return local_point;
+  }
+
+  [[nodiscard]] GeoPoint reverse(const LocalPoint & local_point) const
+  {
+    GeoPoint geo_point = detail::to_geo_point(
+      projector_.reverse(lanelet::BasicPoint3d{local_point.x, local_point.y, local_point.z}));
+    geo_point.altitude = local_point.z + origin_altitude_;
+    return geo_point;
+  }
+
+  [[nodiscard]] const LaneletProjectorT & lanelet_projector() const { return projector_; }
+
+private:
+  double origin_altitude_;
+  LaneletProjectorT projector_;
+};
+
+using LocalCartesianUTMProjector = OriginBasedProjector<lanelet::projection::UtmProjector>;
+using TransverseMercatorProjector =
+  OriginBasedProjector<lanelet::projection::TransverseMercatorProjector>;
+
+using Projector =
+  std::variant<MGRSProjector, LocalCartesianUTMProjector, TransverseMercatorProjector>;
+
+// resolves the projector type once so that the following projections do not need to, and throws
+// std::invalid_argument for an unsupported type
+[[nodiscard]] Projector make_projector(const MapProjectorInfo & projector_info);
+
+[[nodiscard]] inline LocalPoint project_forward(
+  const GeoPoint & geo_point, const Projector & projector)
+{
+  return std::visit([&](const auto & p) { return p.forward(geo_point); }, projector);
+}
+
+[[nodiscard]] inline GeoPoint project_reverse(
+  const LocalPoint & local_point, const Projector & projector)
+{
+  return std::visit([&](const auto & p) { return p.reverse(local_point); }, projector);
+}
+
+// the projector type is dispatched once outside the loop
+[[nodiscard]] inline std::vector<LocalPoint> project_forward(
+  const std::vector<GeoPoint> & geo_points, const Projector & projector)
+{
+  return std::visit(
+    [&](const auto & p) {
+      std::vector<LocalPoint> local_points;
+      local_points.reserve(geo_points.size());
+      for (const auto & geo_point : geo_points) {
+        local_points.push_back(p.forward(geo_point));
+      }
+      return local_points;
+    },
+    projector);
+}
+
+[[nodiscard]] inline std::vector<GeoPoint> project_reverse(
+  const std::vector<LocalPoint> & local_points, const Projector & projector)
+{
+  return std::visit(
+    [&](const auto & p) {
+      std::vector<GeoPoint> geo_points;
+      geo_points.reserve(local_points.size());
+      for (const auto & local_point : local_points) {
+        geo_points.push_back(p.reverse(local_point));
+      }
+      return geo_points;
+    },
+    projector);
+}
+
+}  // namespace autoware::geography_utils
+
+#endif  // AUTOWARE__GEOGRAPHY_UTILS__PROJECTOR_HPP_
@@ -0,0 +1,107 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__GEOGRAPHY_UTILS__TILE_INDEX_HPP_
+#define AUTOWARE__GEOGRAPHY_UTILS__TILE_INDEX_HPP_
+
+#include <autoware_map_msgs/msg/map_projector_info.hpp>
+#include <geometry_msgs/msg/point.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace autoware::geography_utils
+{
+using MapProjectorInfo = autoware_map_msgs::msg::MapProjectorInfo;
+using LocalPoint = geometry_msgs::msg::Point;
+
+struct TileId
+{
+  int32_t x{0};
+  int32_t y{0};
+
+  bool operator==(const TileId & other) const { return x == other.x && y == other.y; }
+  bool operator!=(const TileId & other) const { return !(*this == other); }
+};
+
+struct GeoBoundingBox
+{
+  double min_latitude{0.0};
+  double min_longitude{0.0};
+  double max_latitude{0.0};
+  double max_longitude{0.0};
+
+  [[nodiscard]] bool intersects(const GeoBoundingBox & other) const
+  {
+    return min_latitude <= other.max_latitude && other.min_latitude <= max_latitude &&
+           min_longitude <= other.max_longitude && other.min_longitude <= max_longitude;
+  }
+};
+
+/**
+ * @brief Square tiles of `tile_size` meters laid out on the projected map frame.
+ *
+ * Tile (i, j) covers the local area [i * tile_size, (i + 1) * tile_size) x
+ * [j * tile_size, (j + 1) * tile_size). The geodetic bounds of every tile in the coverage area are
+ * computed once on construction and stored row-major, so that converting a geodetic rectangle into
+ * tile IDs does not require any projection.
+ *
+ * The geodetic bounds of a tile are taken from its four corners. Tiles crossing the antimeridian or
+ * the poles are not supported. The projection must be continuous over the coverage area, which is
+ * checked on the boundary of the area: with MGRS, the area must stay within the 100 km grid square,
+ * as the coordinates wrap at its edges. Otherwise, the constructor throws std::invalid_argument.
+ */
+class TileIndex
+{
+public:
+  TileIndex(
+    const MapProjectorInfo & projector_info, const double tile_size,
+    const GeoBoundingBox & coverage);
+
+  [[nodiscard]] TileId to_tile_id(const LocalPoint & local_point) const;
+  [[nodiscard]] LocalPoint to_local_origin(const TileId & tile_id) const;
+  [[nodiscard]] const GeoBoundingBox & to_geo_bounding_box(const TileId & tile_id) const;
+
+  // returns the tiles in the coverage area overlapping the given box, ordered row by row
+  [[nodiscard]] std::vector<TileId> query(const GeoBoundingBox & geo_bounding_box) const;
+
+  [[nodiscard]] bool contains(const TileId & tile_id) const;
+  [[nodiscard]] double tile_size() const { return tile_size_; }
+  [[nodiscard]] TileId min_tile_id() const { return min_tile_id_; }
+  [[nodiscard]] TileId max_tile_id() const;
+  [[nodiscard]] std::size_t size() const { return tile_bounds_.size(); }
+
+private:
+  [[nodiscard]] std::size_t to_array_index(const int32_t column, const int32_t row) const;
+
+  double tile_size_;
+  TileId min_tile_id_;
+  int32_t num_columns_{0};
+  int32_t num_rows_{0};
+
+  // geodetic bounds of each tile, row-major
+  std::vector<GeoBoundingBox> tile_bounds_;
+
+  // conservative and monotonic latitude range of each row and longitude range of each column,
+  // used to narrow down the candidate tiles with binary search
+  std::vector<double> row_min_latitudes_;
+  std::vector<double> row_max_latitudes_;
+  std::vector<double> column_min_longitudes_;
+  std::vector<double> column_max_longitudes_;
+};
+
+}  // namespace autoware::geography_utils
+
+#endif  // AUTOWARE__GEOGRAPHY_UTILS__TILE_INDEX_HPP_
@@ -0,0 +1,355 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <autoware/geography_utils/geoid_tile.hpp>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace autoware::geography_utils
+{
+
+namespace
+{
+constexpr std::array<char, 4> magic{'A', 'W', 'G', 'T'};
+constexpr uint32_t version = 1;
+constexpr std::size_t header_size = 56;
+constexpr std::size_t index_entry_size = 16;
+
+// number of decoded tiles kept by each thread, enough for the four nodes around a point
+constexpr std::size_t tile_cache_size = 4;
+
+std::atomic<uint64_t> next_file_id{0};
+
+template <class T>
+void append(std::vector<uint8_t> & buffer, const T value)
+{
+  const auto * bytes = reinterpret_cast<const uint8_t *>(&value);
+  buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+}
+
+template <class T>
+T read(const uint8_t * data, const std::size_t offset)
+{
+  T value;
+  std::memcpy(&value, data + offset, sizeof(T));
+  return value;
+}
+
+std::size_t get_encoded_tile_size(const uint32_t num_rows, const uint32_t num_columns)
+{
+  return sizeof(int32_t) + (static_cast<std::size_t>(num_rows) * num_columns - 1) * sizeof(int16_t);
+}
+}  // namespace
+
+std::vector<uint8_t> encode_geoid_tile(
+  const std::vector<int32_t> & values, const uint32_t num_rows, const uint32_t num_columns)
+{
+  if (values.size() != static_cast<std::size_t>(num_rows) * num_columns || values.empty()) {
+    throw std::invalid_argument("Invalid geoid tile size");
+  }
+
+  std::vector<uint8_t> buffer;
+  buffer.reserve(get_encoded_tile_size(num_rows, num_columns));
+  append<int32_t>(buffer, values.front());
+  for (uint32_t row = 0; row < num_rows; ++row) {
+    for (uint32_t column = 0; column < num_columns; ++column) {
+      if (row == 0 && column == 0) {
+        continue;
+      }
+      const std::size_t index = static_cast<std::size_t>(row) * num_columns + column;
+      const std::size_t reference = column == 0 ? index - num_columns : index - 1;
+      const int64_t delta = static_cast<int64_t>(values[index]) - values[reference];
+      if (
+        delta < std::numeric_limits<int16_t>::min() ||
+        delta > std::numeric_limits<int16_t>::max()) {
+        throw std::overflow_error(
+          "Geoid height difference between neighboring nodes exceeds int16: " +
+          std::to_string(delta));
+      }
+      append<int16_t>(buffer, static_cast<int16_t>(delta));
+    }
+  }
+  return buffer;
+}
+
+void decode_geoid_tile(
+  const uint8_t * data, const std::size_t size, const uint32_t num_rows,
+  const uint32_t num_columns, std::vector<int32_t> & values)
+{
+  if (num_rows == 0 || num_columns == 0 || size != get_encoded_tile_size(num_rows, num_columns)) {
+    throw std::invalid_argument("Invalid encoded geoid tile size");
+  }
+
+  values.resize(static_cast<std::size_t>(num_rows) * num_columns);
+  values[0] = read<int32_t>(data, 0);
+  const uint8_t * delta = data + sizeof(int32_t);
+  for (uint32_t row = 0; row < num_rows; ++row) {
+    int32_t * row_values = values.data() + static_cast<std::size_t>(row) * num_columns;
+    if (row > 0) {
+      const int32_t * previous_row_values = row_values - num_columns;
+      row_values[0] = previous_row_values[0] + read<int16_t>(delta, 0);
+      delta += sizeof(int16_t);
+    }
+    for (uint32_t column = 1; column < num_columns; ++column) {
+      row_values[column] = row_values[column - 1] + read<int16_t>(delta, 0);
+      delta += sizeof(int16_t);
+    }
+  }
+}
+
+void write_geoid_tile_file(
+  const std::string & path, const GeoidTileGridInfo & info, const GeoidSampler & sample)
+{
+  if (info.num_rows < 2 || info.num_columns < 2 || info.tile_size == 0 || !(info.scale > 0.0)) {
+    throw std::invalid_argument("Invalid geoid tile grid");
+  }
+
+  const uint32_t num_tile_rows = info.num_tile_rows();
+  const uint32_t num_tile_columns = info.num_tile_columns();
+  const std::size_t num_tiles = static_cast<std::size_t>(num_tile_rows) * num_tile_columns;
+
+  std::vector<uint8_t> header;
+  header.insert(header.end(), magic.begin(), magic.end());
+  append<uint32_t>(header, version);
+  append<double>(header, info.south_latitude);
+  append<double>(header, info.west_longitude);
+  append<double>(header, info.resolution);
+  append<double>(header, info.scale);
+  append<uint32_t>(header, info.num_rows);
+  append<uint32_t>(header, info.num_columns);
+  append<uint32_t>(header, info.tile_size);
+  append<uint32_t>(header, 0);
+
+  std::vector<uint8_t> index;
+  std::vector<uint8_t> payload;
+  uint64_t offset = header_size + num_tiles * index_entry_size;
+  std::vector<int32_t> values;
+  for (uint32_t tile_row = 0; tile_row < num_tile_rows; ++tile_row) {
+    for (uint32_t tile_column = 0; tile_column < num_tile_columns; ++tile_column) {
+      const uint32_t row_begin = tile_row * info.tile_size;
+      const uint32_t column_begin = tile_column * info.tile_size;
+      const uint32_t num_rows = std::min(info.tile_size, info.num_rows - row_begin);
+      const uint32_t num_columns = std::min(info.tile_size, info.num_columns - column_begin);
+
+      values.clear();
+      for (uint32_t row = row_begin; row < row_begin + num_rows; ++row) {
+        for (uint32_t column = column_begin; column < column_begin + num_columns; ++column) {
+          const double height = sample(
+            info.south_latitude + row * info.resolution,
+            info.west_longitude + column * info.resolution);
+          values.push_back(static_cast<int32_t>(std::lround(height / info.scale)));
+        }
+      }
+
+      const std::vector<uint8_t> tile = encode_geoid_tile(values, num_rows, num_columns);
+      append<uint64_t>(index, offset);
+      append<uint64_t>(index, tile.size());
+      payload.insert(payload.end(), tile.begin(), tile.end());
+      offset += tile.size();
+    }
+  }
+
+  std::ofstream ofs(path, std::ios::binary | std::ios::trunc);
+  if (!ofs) {
+    throw std::runtime_error("Failed to open " + path);
+  }
+  for (const auto * buffer : {&header, &index, &payload}) {
+    ofs.write(
+      reinterpret_cast<const char *>(buffer->data()), static_cast<std::streamsize>(buffer->size()));
+  }
+  if (!ofs) {
+    throw std::runtime_error("Failed to write " + path);
+  }
+}
+
+GeoidTileFile::GeoidTileFile(const std::string & path) : id_(next_file_id.fetch_add(1))
+{
+  const int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error("Failed to open " + path);
+  }
+  struct stat file_stat = {};
+  if (::fstat(fd, &file_stat) != 0 || static_cast<std::size_t>(file_stat.st_size) < header_size) {
+    ::close(fd);
+    throw std::runtime_error("Invalid geoid tile file: " + path);
+  }
+  data_size_ = static_cast<std::size_t>(file_stat.st_size);
+  void * data = ::mmap(nullptr, data_size_, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (data == MAP_FAILED) {
+    throw std::runtime_error("Failed to map " + path);
+  }
+  data_ = static_cast<const uint8_t *>(data);
+
+  try {
+    if (
+      std::memcmp(data_, magic.data(), magic.size()) != 0 ||
+      read<uint32_t>(data_, 4) != version) {
+      throw std::runtime_error("Unsupported geoid tile file: " + path);
+    }
+    info_.south_latitude = read<double>(data_, 8);
+    info_.west_longitude = read<double>(data_, 16);
+    info_.resolution = read<double>(data_, 24);
+    info_.scale = read<double>(data_, 32);
+    info_.num_rows = read<uint32_t>(data_, 40);
+    info_.num_columns = read<uint32_t>(data_, 44);
+    info_.tile_size = read<uint32_t>(data_, 48);
+    if (info_.num_rows < 2 || info_.num_columns < 2 || info_.tile_size == 0) {
+      throw std::runtime_error("Invalid geoid tile grid: " + path);
+    }
+
+    // compared by division, as the sizes read from the file may overflow
+    const std::size_t num_tiles =
+      static_cast<std::size_t>(info_.num_tile_rows()) * info_.num_tile_columns();
+    if (num_tiles > (data_size_ - header_size) / index_entry_size) {
+      throw std::runtime_error("Truncated geoid tile index: " + path);
+    }
+    tile_offsets_.resize(num_tiles);
+    tile_sizes_.resize(num_tiles);
+    for (std::size_t i = 0; i < num_tiles; ++i) {
+      tile_offsets_[i] = read<uint64_t>(data_, header_size + i * index_entry_size);
+      tile_sizes_[i] = read<uint64_t>(data_, header_size + i * index_entry_size + 8);
+      if (tile_offsets_[i] > data_size_ || tile_sizes_[i] > data_size_ - tile_offsets_[i]) {
+        throw std::runtime_error("Truncated geoid tile: " + path);
+      }
+    }
+  } catch (...) {
+    ::munmap(const_cast<uint8_t *>(data_), data_size_);
+    throw;
+  }
+}
+
+GeoidTileFile::~GeoidTileFile()
+{
+  ::munmap(const_cast<uint8_t *>(data_), data_size_);
+}
+
+void GeoidTileFile::decode_tile(const std::size_t tile_index, std::vector<int32_t> & values) const
+{
+  const uint32_t tile_row = static_cast<uint32_t>(tile_index / info_.num_tile_columns());
+  const uint32_t tile_column = static_cast<uint32_t>(tile_index % info_.num_tile_columns());
+  const uint32_t num_rows = std::min(info_.tile_size, info_.num_rows - tile_row * info_.tile_size);
+  const uint32_t num_columns =
+    std::min(info_.tile_size, info_.num_columns - tile_column * info_.tile_size);
+  decode_geoid_tile(
+    data_ + tile_offsets_.at(tile_index), tile_sizes_.at(tile_index), num_rows, num_columns,
+    values);
+}
+
+const std::vector<int32_t> & GeoidTileFile::get_tile(const std::size_t tile_index) const
+{
+  struct CachedTile
+  {
+    uint64_t file_id{std::numeric_limits<uint64_t>::max()};
+    std::size_t tile_index{0};
+    std::vector<int32_t> values;
+  };
+  thread_local std::array<CachedTile, tile_cache_size> cache;
+  thread_local std::size_t next_slot = 0;
+
+  for (const auto & cached_tile : cache) {
+    if (cached_tile.file_id == id_ && cached_tile.tile_index == tile_index) {
+      return cached_tile.values;
+    }
+  }
+
+  CachedTile & slot = cache[next_slot];
+  next_slot = (next_slot + 1) % tile_cache_size;
+  slot.file_id = std::numeric_limits<uint64_t>::max();
+  decode_tile(tile_index, slot.values);
+  slot.file_id = id_;
+  slot.tile_index = tile_index;
+  return slot.values;
+}
+
+double GeoidTileFile::get_node_height(const uint32_t row, const uint32_t column) const
+{
+  const uint32_t tile_row = row / info_.tile_size;
+  const uint32_t tile_column = column / info_.tile_size;
+  const uint32_t tile_num_columns =
+    std::min(info_.tile_size, info_.num_columns - tile_column * info_.tile_size);
+  const auto & values =
+    get_tile(static_cast<std::size_t>(tile_row) * info_.num_tile_columns() + tile_column);
+  const std::size_t index =
+    static_cast<std::size_t>(row % info_.tile_size) * tile_num_columns + column % info_.tile_size;
+  return values[index] * info_.scale;
+}
+
+bool GeoidTileFile::to_grid(
+  const double latitude, const double longitude, double & y, double & x) const
+{
+  y = (latitude - info_.south_latitude) / info_.resolution;
+  x = std::fmod(longitude - info_.west_longitude, 360.0);
+  if (x < 0.0) {
+    x += 360.0;
+  }
+  x /= info_.resolution;
+
+  // allow the rounding error of points on the edges of the grid
+  constexpr double edge_tolerance = 1e-6;
+  const double max_y = info_.num_rows - 1;
+  const double max_x = info_.num_columns - 1;
+  if (!(-edge_tolerance <= y && y <= max_y + edge_tolerance && x <= max_x + edge_tolerance)) {
+    return false;
+  }
+  y = std::clamp(y, 0.0, max_y);
+  x = std::min(x, max_x);
+  return true;
+}
+
+bool GeoidTileFile::contains(const double latitude, const double longitude) const
+{
+  double y = 0.0;
+  double x = 0.0;
+  return to_grid(latitude, longitude, y, x);
+}
+
+double GeoidTileFile::geoid_height(const double latitude, const double longitude) const
+{
+  double y = 0.0;
+  double x = 0.0;
+  if (!to_grid(latitude, longitude, y, x)) {
+    throw std::out_of_range(
+      "Point (" + std::to_string(latitude) + ", " + std::to_string(longitude) +
+      ") is outside of the geoid tile grid");
+  }
+
+  // the last cell includes the upper and right edges of the grid
+  const auto row = std::min(static_cast<uint32_t>(y), info_.num_rows - 2);
+  const auto column = std::min(static_cast<uint32_t>(x), info_.num_columns - 2);
+  const double fy = y - row;
+  const double fx = x - column;
+
+  const double h00 = get_node_height(row, column);
+  const double h01 = get_node_height(row, column + 1);
+  const double h10 = get_node_height(row + 1, column);
+  const double h11 = get_node_height(row + 1, column + 1);
+  return (1.0 - fy) * ((1.0 - fx) * h00 + fx * h01) + fy * ((1.0 - fx) * h10 + fx * h11);
+}
+
+}  // namespace autoware::geography_utils
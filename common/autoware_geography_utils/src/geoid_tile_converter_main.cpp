@@ -0,0 +1,83 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <GeographicLib/Geoid.hpp>
+#include <autoware/geography_utils/geoid_tile.hpp>
+
+#include <cmath>
+#include <cstdio>
+#include <exception>
+#include <string>
+
+namespace
+{
+void print_usage(const char * program)
+{
+  std::fprintf(
+    stderr,
+    "usage: %s <output> <south> <west> <north> <east> [geoid name] [resolution arc-minutes] "
+    "[tile size]\n"
+    "  Extracts the area [south, north] x [west, east] in degrees of a GeographicLib geoid "
+    "(egm2008-1 by default)\n"
+    "  into a tiled geoid file readable by GeoidHeightConverter::from_tile_file.\n",
+    program);
+}
+}  // namespace
+
+int main(int argc, char * argv[])
+{
+  if (argc < 6) {
+    print_usage(argv[0]);
+    return 1;
+  }
+
+  try {
+    const std::string output = argv[1];
+    const double south = std::stod(argv[2]);
+    const double west = std::stod(argv[3]);
+    const double north = std::stod(argv[4]);
+    const double east = std::stod(argv[5]);
+    const std::string geoid_name = argc > 6 ? argv[6] : "egm2008-1";
+    const double resolution = (argc > 7 ? std::stod(argv[7]) : 1.0) / 60.0;
+
+    autoware::geography_utils::GeoidTileGridInfo info;
+    info.resolution = resolution;
+    if (argc > 8) {
+      info.tile_size = static_cast<uint32_t>(std::stoul(argv[8]));
+    }
+    // align the area to the grid of the geoid so that the nodes are sampled without interpolation
+    info.south_latitude = std::floor(south / resolution) * resolution;
+    info.west_longitude = std::floor(west / resolution) * resolution;
+    info.num_rows =
+      static_cast<uint32_t>(std::ceil((north - info.south_latitude) / resolution)) + 1;
+    info.num_columns =
+      static_cast<uint32_t>(std::ceil((east - info.west_longitude) / resolution)) + 1;
+
+    // bilinear interpolation returns the node values at the nodes
+    const GeographicLib::Geoid geoid(geoid_name, "", false /* cubic */);
+    autoware::geography_utils::write_geoid_tile_file(
+      output, info,
+      [&geoid](const double latitude, const double longitude) {
+        return geoid(latitude, longitude);
+      });
+
+    std::printf(
+      "wrote %u x %u nodes in %u x %u tiles to %s\n", info.num_rows, info.num_columns,
+      info.num_tile_rows(), info.num_tile_columns(), output.c_str());
+  } catch (const std::exception & e) {
+    std::fprintf(stderr, "error: %s\n", e.what());
+    return 1;
+  }
+  return 0;
+}
@@ -13,28 +13,138 @@
 // limitations under the License.
 
 #include <GeographicLib/Geoid.hpp>
+#include <autoware/geography_utils/geoid_tile.hpp>
 #include <autoware/geography_utils/height.hpp>
 
+#include <algorithm>
+#include <cstdlib>
 #include <map>
+#include <memory>
 #include <stdexcept>
 #include <string>
 #include <utility>
+#include <vector>
 
 namespace autoware::geography_utils
 {
 
+struct GeoidHeightConverter::Impl
+{
+  std::string geoid_name;
+  std::string geoid_path;
+  std::unique_ptr<const GeographicLib::Geoid> shared_geoid;
+  std::unique_ptr<const GeoidTileFile> tile_file;
+};
+
+GeoidHeightConverter::GeoidHeightConverter(
+  const std::string & geoid_name, const std::string & geoid_path, const bool share_full_grid)
+{
+  auto impl = std::make_shared<Impl>();
+  impl->geoid_name = geoid_name;
+  impl->geoid_path = geoid_path;
+  if (share_full_grid) {
+    // a thread-safe geoid caches the whole grid and never modifies it afterwards
+    impl->shared_geoid = std::make_unique<const GeographicLib::Geoid>(
+      geoid_name, geoid_path, true /* cubic */, true /* threadsafe */);
+  } else {
+    // open the grid once here so that an invalid geoid is reported on construction
+    [[maybe_unused]] const GeographicLib::Geoid geoid(geoid_name, geoid_path);
+  }
+  impl_ = std::move(impl);
+}
+
+GeoidHeightConverter::GeoidHeightConverter(std::shared_ptr<const Impl> impl)
+: impl_(std::move(impl))
+{
+}
+
+GeoidHeightConverter GeoidHeightConverter::from_tile_file(
+  const std::string & path, const std::string & fallback_geoid_name,
+  const std::string & fallback_geoid_path)
+{
+  auto impl = std::make_shared<Impl>();
+  impl->geoid_name = fallback_geoid_name;
+  impl->geoid_path = fallback_geoid_path;
+  impl->tile_file = std::make_unique<const GeoidTileFile>(path);
+  return GeoidHeightConverter(std::move(impl));
+}
+
+const GeographicLib::Geoid & GeoidHeightConverter::geoid() const
+{
+  if (impl_->shared_geoid) {
+    return *impl_->shared_geoid;
+  }
+
+  // the geoids of this thread, keyed by converter
+  // entries of destroyed converters are released on the next insertion
+  struct ThreadGeoid
+  {
+    const Impl * key;
+    std::weak_ptr<const Impl> owner;
+    std::unique_ptr<const GeographicLib::Geoid> geoid;
+  };
+  thread_local std::vector<ThreadGeoid> thread_geoids;
+
+  for (const auto & thread_geoid : thread_geoids) {
+    if (thread_geoid.key == impl_.get() && !thread_geoid.owner.expired()) {
+      return *thread_geoid.geoid;
+    }
+  }
+
+  thread_geoids.erase(
+    std::remove_if(
+      thread_geoids.begin(), thread_geoids.end(),
+      [](const ThreadGeoid & thread_geoid) { return thread_geoid.owner.expired(); }),
+    thread_geoids.end());
+  thread_geoids.push_back(ThreadGeoid{
+    impl_.get(), impl_,
+    std::make_unique<const GeographicLib::Geoid>(impl_->geoid_name, impl_->geoid_path)});
+  return *thread_geoids.back().geoid;
+}
+
+double GeoidHeightConverter::geoid_height(const double latitude, const double longitude) const
+{
+  if (impl_->tile_file) {
+    if (impl_->geoid_name.empty() || impl_->tile_file->contains(latitude, longitude)) {
+      return impl_->tile_file->geoid_height(latitude, longitude);
+    }
+  }
+  return geoid()(latitude, longitude);
+}
+
+double GeoidHeightConverter::convert_wgs84_to_egm2008(
+  const double height, const double latitude, const double longitude) const
+{
+  return height - geoid_height(latitude, longitude);
+}
+
+double GeoidHeightConverter::convert_egm2008_to_wgs84(
+  const double height, const double latitude, const double longitude) const
+{
+  return height + geoid_height(latitude, longitude);
+}
+
+const GeoidHeightConverter & get_egm2008_converter()
+{
+  static const GeoidHeightConverter converter = []() {
+    // like GEOGRAPHICLIB_GEOID_PATH, so that convert_height reads the tiles without code changes
+    const char * const tile_file = std::getenv(geoid_tile_file_environment_variable);
+    if (tile_file && *tile_file) {
+      return GeoidHeightConverter::from_tile_file(tile_file, "egm2008-1");
+    }
+    return GeoidHeightConverter("egm2008-1");
+  }();
+  return converter;
+}
+
 double convert_wgs84_to_egm2008(const double height, const double latitude, const double longitude)
 {
-  GeographicLib::Geoid egm2008("egm2008-1");
-  // cSpell: ignore ELLIPSOIDTOGEOID
-  return egm2008.ConvertHeight(latitude, longitude, height, GeographicLib::Geoid::ELLIPSOIDTOGEOID);
+  return get_egm2008_converter().convert_wgs84_to_egm2008(height, latitude, longitude);
 }
 
 double convert_egm2008_to_wgs84(const double height, const double latitude, const double longitude)
 {
-  GeographicLib::Geoid egm2008("egm2008-1");
-  // cSpell: ignore GEOIDTOELLIPSOID
-  return egm2008.ConvertHeight(latitude, longitude, height, GeographicLib::Geoid::GEOIDTOELLIPSOID);
+  return get_egm2008_converter().convert_egm2008_to_wgs84(height, latitude, longitude);
 }
 
 double convert_height(
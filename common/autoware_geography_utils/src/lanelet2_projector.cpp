@@ -12,48 +12,25 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
-#include <GeographicLib/Geoid.hpp>
 #include <autoware/geography_utils/lanelet2_projector.hpp>
-#include <autoware_lanelet2_extension/projection/mgrs_projector.hpp>
-#include <autoware_lanelet2_extension/projection/transverse_mercator_projector.hpp>
-
-#include <lanelet2_projection/UTM.h>
+#include <autoware/geography_utils/projector.hpp>
 
 #include <memory>
-#include <string>
+#include <type_traits>
+#include <variant>
 
 namespace autoware::geography_utils
 {
 
 std::unique_ptr<lanelet::Projector> get_lanelet2_projector(const MapProjectorInfo & projector_info)
 {
-  if (projector_info.projector_type == MapProjectorInfo::LOCAL_CARTESIAN_UTM) {
-    const lanelet::GPSPoint position{
-      projector_info.map_origin.latitude, projector_info.map_origin.longitude,
-      projector_info.map_origin.altitude};
-    const lanelet::Origin origin{position};
-    const lanelet::projection::UtmProjector projector{origin};
-    return std::make_unique<lanelet::projection::UtmProjector>(projector);
-  }
-
-  if (projector_info.projector_type == MapProjectorInfo::MGRS) {
-    lanelet::projection::MGRSProjector projector{};
-    projector.setMGRSCode(projector_info.mgrs_grid);
-    return std::make_unique<lanelet::projection::MGRSProjector>(projector);
-  }
-
-  if (projector_info.projector_type == MapProjectorInfo::TRANSVERSE_MERCATOR) {
-    const lanelet::GPSPoint position{
-      projector_info.map_origin.latitude, projector_info.map_origin.longitude,
-      projector_info.map_origin.altitude};
-    const lanelet::Origin origin{position};
-    const lanelet::projection::TransverseMercatorProjector projector{origin};
-    return std::make_unique<lanelet::projection::TransverseMercatorProjector>(projector);
-  }
-
-  throw std::invalid_argument(
-    "Invalid map projector type: " + projector_info.projector_type +
-    ". Currently supported types: MGRS, LocalCartesianUTM, and TransverseMercator");
+  // copies the lanelet2 projector resolved by make_projector
+  return std::visit(
+    [](const auto & projector) -> std::unique_ptr<lanelet::Projector> {
+      using LaneletProjector = std::decay_t<decltype(projector.lanelet_projector())>;
+      return std::make_unique<LaneletProjector>(projector.lanelet_projector());
+    },
+    make_projector(projector_info));
 }
 
 }  // namespace autoware::geography_utils
@@ -12,83 +12,41 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
-#include <GeographicLib/Geoid.hpp>
-#include <autoware/geography_utils/lanelet2_projector.hpp>
 #include <autoware/geography_utils/projection.hpp>
-#include <autoware_lanelet2_extension/projection/mgrs_projector.hpp>
+#include <autoware/geography_utils/projector.hpp>
 
-#include <memory>
+#include <stdexcept>
 
 namespace autoware::geography_utils
 {
 
-[[nodiscard]] Eigen::Vector3d to_basic_point_3d_pt(const LocalPoint src)
+Projector make_projector(const MapProjectorInfo & projector_info)
 {
-  return Eigen::Vector3d{src.x, src.y, src.z};
-}
-
-LocalPoint project_forward(const GeoPoint & geo_point, const MapProjectorInfo & projector_info)
-{
-  std::unique_ptr<lanelet::Projector> projector = get_lanelet2_projector(projector_info);
-  const lanelet::GPSPoint position{geo_point.latitude, geo_point.longitude, geo_point.altitude};
+  if (projector_info.projector_type == MapProjectorInfo::LOCAL_CARTESIAN_UTM) {
+    return LocalCartesianUTMProjector{projector_info.map_origin};
+  }
 
-  lanelet::BasicPoint3d projected_local_point;
   if (projector_info.projector_type == MapProjectorInfo::MGRS) {
-    constexpr int mgrs_precision = 9;  // set precision as 100 micro meter
-    const auto mgrs_projector = dynamic_cast<lanelet::projection::MGRSProjector *>(projector.get());
-
-    // project x and y using projector
-    // note that the altitude is ignored in MGRS projection conventionally
-    projected_local_point = mgrs_projector->forward(position, mgrs_precision);
-  } else {
-    // project x and y using projector
-    // note that the original projector such as UTM projector does not compensate for the altitude
-    // offset
-    projected_local_point = projector->forward(position);
+    return MGRSProjector{projector_info.mgrs_grid};
+  }
 
-    // correct z based on the map origin
-    // note that the converted altitude in local point is in the same vertical datum as the geo
-    // point
-    projected_local_point.z() = geo_point.altitude - projector_info.map_origin.altitude;
+  if (projector_info.projector_type == MapProjectorInfo::TRANSVERSE_MERCATOR) {
+    return TransverseMercatorProjector{projector_info.map_origin};
   }
 
-  LocalPoint local_point;
-  local_point.x = projected_local_point.x();
-  local_point.y = projected_local_point.y();
-  local_point.z = projected_local_point.z();
+  throw std::invalid_argument(
+    "Invalid map projector type: " + projector_info.projector_type +
+    ". Currently supported types: MGRS, LocalCartesianUTM, and TransverseMercator");
+}
 
-  return local_point;
+LocalPoint project_forward(const GeoPoint & geo_point, const MapProjectorInfo & projector_info)
+{
+  return project_forward(geo_point, make_projector(projector_info));
 }
 
 GeoPoint project_reverse(const LocalPoint & local_point, const MapProjectorInfo & projector_info)
 {
-  std::unique_ptr<lanelet::Projector> projector = get_lanelet2_projector(projector_info);
-
-  lanelet::GPSPoint projected_gps_point;
-  if (projector_info.projector_type == MapProjectorInfo::MGRS) {
-    const auto * mgrs_projector =
-      dynamic_cast<lanelet::projection::MGRSProjector *>(projector.get());
-    // project latitude and longitude using projector
-    // note that the z is ignored in MGRS projection conventionally
-    projected_gps_point =
-      mgrs_projector->reverse(to_basic_point_3d_pt(local_point), projector_info.mgrs_grid);
-  } else {
-    // project latitude and longitude using projector
-    // note that the original projector such as UTM projector does not compensate for the altitude
-    // offset
-    projected_gps_point = projector->reverse(to_basic_point_3d_pt(local_point));
-
-    // correct altitude based on the map origin
-    // note that the converted altitude in local point is in the same vertical datum as the geo
-    // point
-    projected_gps_point.ele = local_point.z + projector_info.map_origin.altitude;
-  }
-
-  GeoPoint geo_point;
-  geo_point.latitude = projected_gps_point.lat;
-  geo_point.longitude = projected_gps_point.lon;
-  geo_point.altitude = projected_gps_point.ele;
-  return geo_point;
+  return project_reverse(local_point, make_projector(projector_info));
 }
 
 }  // namespace autoware::geography_utils
@@ -0,0 +1,245 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <autoware/geography_utils/projector.hpp>
+#include <autoware/geography_utils/tile_index.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace autoware::geography_utils
+{
+
+namespace
+{
+// number of points sampled on each edge of the coverage area to find its extent in the local frame
+constexpr int coverage_edge_samples = 16;
+
+// tolerance of the round trip of the sampled points [deg], far below the size of a grid square
+constexpr double round_trip_tolerance = 1e-6;
+
+GeoPoint to_geo_point(const double latitude, const double longitude)
+{
+  GeoPoint geo_point;
+  geo_point.latitude = latitude;
+  geo_point.longitude = longitude;
+  geo_point.altitude = 0.0;
+  return geo_point;
+}
+}  // namespace
+
+TileIndex::TileIndex(
+  const MapProjectorInfo & projector_info, const double tile_size,
+  const GeoBoundingBox & coverage)
+: tile_size_(tile_size)
+{
+  if (!(tile_size > 0.0)) {
+    throw std::invalid_argument("Invalid tile size: " + std::to_string(tile_size));
+  }
+  if (
+    coverage.min_latitude > coverage.max_latitude ||
+    coverage.min_longitude > coverage.max_longitude) {
+    throw std::invalid_argument("Invalid coverage area: min is larger than max");
+  }
+
+  const Projector projector = make_projector(projector_info);
+
+  // find the extent of the coverage area in the local frame
+  // note that the edges of a geodetic rectangle are curved in the projected frame
+  double min_x = std::numeric_limits<double>::max();
+  double min_y = std::numeric_limits<double>::max();
+  double max_x = std::numeric_limits<double>::lowest();
+  double max_y = std::numeric_limits<double>::lowest();
+  const auto expand = [&](const double latitude, const double longitude) {
+    const LocalPoint p = project_forward(to_geo_point(latitude, longitude), projector);
+    // MGRS coordinates wrap at the edges of the 100 km grid square, where the tiles would no longer
+    // be laid out monotonically, and the point then projects back into the wrong square
+    const GeoPoint q = project_reverse(p, projector);
+    if (
+      std::abs(q.latitude - latitude) > round_trip_tolerance ||
+      std::abs(q.longitude - longitude) > round_trip_tolerance) {
+      throw std::invalid_argument(
+        "Coverage area is not projected continuously, e.g. it leaves the MGRS grid square: (" +
+        std::to_string(latitude) + ", " + std::to_string(longitude) + ")");
+    }
+    min_x = std::min(min_x, p.x);
+    min_y = std::min(min_y, p.y);
+    max_x = std::max(max_x, p.x);
+    max_y = std::max(max_y, p.y);
+  };
+  for (int i = 0; i <= coverage_edge_samples; ++i) {
+    const double ratio = static_cast<double>(i) / coverage_edge_samples;
+    const double latitude =
+      coverage.min_latitude + ratio * (coverage.max_latitude - coverage.min_latitude);
+    const double longitude =
+      coverage.min_longitude + ratio * (coverage.max_longitude - coverage.min_longitude);
+    expand(latitude, coverage.min_longitude);
+    expand(latitude, coverage.max_longitude);
+    expand(coverage.min_latitude, longitude);
+    expand(coverage.max_latitude, longitude);
+  }
+
+  min_tile_id_.x = static_cast<int32_t>(std::floor(min_x / tile_size_));
+  min_tile_id_.y = static_cast<int32_t>(std::floor(min_y / tile_size_));
+  num_columns_ = static_cast<int32_t>(std::floor(max_x / tile_size_)) - min_tile_id_.x + 1;
+  num_rows_ = static_cast<int32_t>(std::floor(max_y / tile_size_)) - min_tile_id_.y + 1;
+
+  // project the tile corners back once
+  const int32_t num_corner_columns = num_columns_ + 1;
+  std::vector<GeoPoint> corners;
+  corners.reserve(static_cast<std::size_t>(num_corner_columns) * (num_rows_ + 1));
+  for (int32_t row = 0; row <= num_rows_; ++row) {
+    for (int32_t column = 0; column <= num_columns_; ++column) {
+      LocalPoint corner;
+      corner.x = (min_tile_id_.x + column) * tile_size_;
+      corner.y = (min_tile_id_.y + row) * tile_size_;
+      corner.z = 0.0;
+      corners.push_back(project_reverse(corner, projector));
+    }
+  }
+  const auto corner_at = [&](const int32_t column, const int32_t row) -> const GeoPoint & {
+    return corners[static_cast<std::size_t>(row) * num_corner_columns + column];
+  };
+
+  tile_bounds_.resize(static_cast<std::size_t>(num_columns_) * num_rows_);
+  row_min_latitudes_.assign(num_rows_, std::numeric_limits<double>::max());
+  row_max_latitudes_.assign(num_rows_, std::numeric_limits<double>::lowest());
+  column_min_longitudes_.assign(num_columns_, std::numeric_limits<double>::max());
+  column_max_longitudes_.assign(num_columns_, std::numeric_limits<double>::lowest());
+  for (int32_t row = 0; row < num_rows_; ++row) {
+    for (int32_t column = 0; column < num_columns_; ++column) {
+      GeoBoundingBox & bounds = tile_bounds_[to_array_index(column, row)];
+      bounds.min_latitude = std::numeric_limits<double>::max();
+      bounds.min_longitude = std::numeric_limits<double>::max();
+      bounds.max_latitude = std::numeric_limits<double>::lowest();
+      bounds.max_longitude = std::numeric_limits<double>::lowest();
+      for (const auto & corner :
+           {corner_at(column, row), corner_at(column + 1, row), corner_at(column, row + 1),
+            corner_at(column + 1, row + 1)}) {
+        bounds.min_latitude = std::min(bounds.min_latitude, corner.latitude);
+        bounds.min_longitude = std::min(bounds.min_longitude, corner.longitude);
+        bounds.max_latitude = std::max(bounds.max_latitude, corner.latitude);
+        bounds.max_longitude = std::max(bounds.max_longitude, corner.longitude);
+      }
+      row_min_latitudes_[row] = std::min(row_min_latitudes_[row], bounds.min_latitude);
+      row_max_latitudes_[row] = std::max(row_max_latitudes_[row], bounds.max_latitude);
+      column_min_longitudes_[column] =
+        std::min(column_min_longitudes_[column], bounds.min_longitude);
+      column_max_longitudes_[column] =
+        std::max(column_max_longitudes_[column], bounds.max_longitude);
+    }
+  }
+
+  // widen the ranges so that the max values are non-decreasing and the min values are
+  // non-increasing from the end, which allows binary search on them
+  for (int32_t row = 1; row < num_rows_; ++row) {
+    row_max_latitudes_[row] = std::max(row_max_latitudes_[row], row_max_latitudes_[row - 1]);
+  }
+  for (int32_t row = num_rows_ - 2; row >= 0; --row) {
+    row_min_latitudes_[row] = std::min(row_min_latitudes_[row], row_min_latitudes_[row + 1]);
+  }
+  for (int32_t column = 1; column < num_columns_; ++column) {
+    column_max_longitudes_[column] =
+      std::max(column_max_longitudes_[column], column_max_longitudes_[column - 1]);
+  }
+  for (int32_t column = num_columns_ - 2; column >= 0; --column) {
+    column_min_longitudes_[column] =
+      std::min(column_min_longitudes_[column], column_min_longitudes_[column + 1]);
+  }
+}
+
+TileId TileIndex::to_tile_id(const LocalPoint & local_point) const
+{
+  TileId tile_id;
+  tile_id.x = static_cast<int32_t>(std::floor(local_point.x / tile_size_));
+  tile_id.y = static_cast<int32_t>(std::floor(local_point.y / tile_size_));
+  return tile_id;
+}
+
+LocalPoint TileIndex::to_local_origin(const TileId & tile_id) const
+{
+  LocalPoint local_point;
+  local_point.x = tile_id.x * tile_size_;
+  local_point.y = tile_id.y * tile_size_;
+  local_point.z = 0.0;
+  return local_point;
+}
+
+const GeoBoundingBox & TileIndex::to_geo_bounding_box(const TileId & tile_id) const
+{
+  if (!contains(tile_id)) {
+    throw std::out_of_range(
+      "Tile (" + std::to_string(tile_id.x) + ", " + std::to_string(tile_id.y) +
+      ") is out of the coverage area");
+  }
+  return tile_bounds_[to_array_index(tile_id.x - min_tile_id_.x, tile_id.y - min_tile_id_.y)];
+}
+
+std::vector<TileId> TileIndex::query(const GeoBoundingBox & geo_bounding_box) const
+{
+  std::vector<TileId> tile_ids;
+  if (tile_bounds_.empty()) {
+    return tile_ids;
+  }
+
+  const auto row_begin = static_cast<int32_t>(
+    std::lower_bound(
+      row_max_latitudes_.begin(), row_max_latitudes_.end(), geo_bounding_box.min_latitude) -
+    row_max_latitudes_.begin());
+  const auto row_end = static_cast<int32_t>(
+    std::upper_bound(
+      row_min_latitudes_.begin(), row_min_latitudes_.end(), geo_bounding_box.max_latitude) -
+    row_min_latitudes_.begin());
+  const auto column_begin = static_cast<int32_t>(
+    std::lower_bound(
+      column_max_longitudes_.begin(), column_max_longitudes_.end(),
+      geo_bounding_box.min_longitude) -
+    column_max_longitudes_.begin());
+  const auto column_end = static_cast<int32_t>(
+    std::upper_bound(
+      column_min_longitudes_.begin(), column_min_longitudes_.end(),
+      geo_bounding_box.max_longitude) -
+    column_min_longitudes_.begin());
+
+  for (int32_t row = row_begin; row < row_end; ++row) {
+    for (int32_t column = column_begin; column < column_end; ++column) {
+      if (tile_bounds_[to_array_index(column, row)].intersects(geo_bounding_box)) {
+        tile_ids.push_back(TileId{min_tile_id_.x + column, min_tile_id_.y + row});
+      }
+    }
+  }
+  return tile_ids;
+}
+
+bool TileIndex::contains(const TileId & tile_id) const
+{
+  return min_tile_id_.x <= tile_id.x && tile_id.x < min_tile_id_.x + num_columns_ &&
+         min_tile_id_.y <= tile_id.y && tile_id.y < min_tile_id_.y + num_rows_;
+}
+
+TileId TileIndex::max_tile_id() const
+{
+  return TileId{min_tile_id_.x + num_columns_ - 1, min_tile_id_.y + num_rows_ - 1};
+}
+
+std::size_t TileIndex::to_array_index(const int32_t column, const int32_t row) const
+{
+  return static_cast<std::size_t>(row) * num_columns_ + column;
+}
+
+}  // namespace autoware::geography_utils
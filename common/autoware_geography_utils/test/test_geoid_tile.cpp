@@ -0,0 +1,142 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <autoware/geography_utils/geoid_tile.hpp>
+#include <autoware/geography_utils/height.hpp>
+
+#include <gtest/gtest.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+// smooth synthetic geoid which is linear between the nodes
+double synthetic_geoid_height(const double latitude, const double longitude)
+{
+  return 36.0 + 0.5 * (latitude - 35.0) - 0.25 * (longitude - 139.0);
+}
+
+autoware::geography_utils::GeoidTileGridInfo make_grid_info()
+{
+  autoware::geography_utils::GeoidTileGridInfo info;
+  info.south_latitude = 35.0;
+  info.west_longitude = 139.0;
+  info.resolution = 1.0 / 60.0;
+  info.num_rows = 70;
+  info.num_columns = 130;
+  info.tile_size = 32;
+  return info;
+}
+
+// unique even for concurrent runs of the test
+std::string make_temporary_path()
+{
+  std::string path =
+    (std::filesystem::temp_directory_path() / "test_geoid_tile_XXXXXX.awgt").string();
+  const int fd = ::mkstemps(path.data(), 5);
+  if (fd < 0) {
+    throw std::runtime_error("Failed to create a temporary file");
+  }
+  ::close(fd);
+  return path;
+}
+}  // namespace
+
+TEST(GeographyUtilsGeoidTile, EncodeDecode)
+{
+  const std::vector<int32_t> values{1000, 1010, 990, -5000, -5001, 32767 - 5001};
+
+  const auto encoded = autoware::geography_utils::encode_geoid_tile(values, 2, 3);
+  EXPECT_EQ(encoded.size(), sizeof(int32_t) + 5 * sizeof(int16_t));
+
+  std::vector<int32_t> decoded;
+  autoware::geography_utils::decode_geoid_tile(encoded.data(), encoded.size(), 2, 3, decoded);
+  EXPECT_EQ(decoded, values);
+
+  EXPECT_THROW(
+    autoware::geography_utils::decode_geoid_tile(encoded.data(), encoded.size(), 3, 3, decoded),
+    std::invalid_argument);
+}
+
+TEST(GeographyUtilsGeoidTile, EncodeOverflow)
+{
+  EXPECT_THROW(
+    static_cast<void>(autoware::geography_utils::encode_geoid_tile({0, 40000}, 1, 2)),
+    std::overflow_error);
+}
+
+TEST(GeographyUtilsGeoidTile, WriteAndRead)
+{
+  const auto info = make_grid_info();
+  const std::string path = make_temporary_path();
+  autoware::geography_utils::write_geoid_tile_file(path, info, synthetic_geoid_height);
+
+  {
+    const autoware::geography_utils::GeoidTileFile tile_file(path);
+    EXPECT_EQ(tile_file.info().num_rows, info.num_rows);
+    EXPECT_EQ(tile_file.info().num_columns, info.num_columns);
+    EXPECT_EQ(tile_file.num_tiles(), 3u * 5u);
+
+    // points inside tiles, on tile borders and on the edges of the grid
+    for (const double latitude : {35.0, 35.2, 35.5333333, 35.9, 35.0 + 69.0 / 60.0}) {
+      for (const double longitude : {139.0, 139.01, 139.5333333, 140.2, 139.0 + 129.0 / 60.0}) {
+        EXPECT_NEAR(
+          tile_file.geoid_height(latitude, longitude), synthetic_geoid_height(latitude, longitude),
+          info.scale);
+      }
+    }
+
+    EXPECT_THROW(
+      static_cast<void>(tile_file.geoid_height(34.9, 139.5)), std::out_of_range);
+    EXPECT_THROW(
+      static_cast<void>(tile_file.geoid_height(35.5, 141.5)), std::out_of_range);
+  }
+
+  const auto converter = autoware::geography_utils::GeoidHeightConverter::from_tile_file(path);
+  const double geoid_height = synthetic_geoid_height(35.5, 139.5);
+  EXPECT_NEAR(converter.convert_wgs84_to_egm2008(10.0, 35.5, 139.5), 10.0 - geoid_height, 0.001);
+  EXPECT_NEAR(converter.convert_egm2008_to_wgs84(10.0, 35.5, 139.5), 10.0 + geoid_height, 0.001);
+  EXPECT_THROW(static_cast<void>(converter.geoid_height(34.0, 139.5)), std::out_of_range);
+
+  // outside of the tiles, the fallback geoid is used
+  const auto fallback_converter =
+    autoware::geography_utils::GeoidHeightConverter::from_tile_file(path, "egm2008-1");
+  const autoware::geography_utils::GeoidHeightConverter geoid_converter("egm2008-1");
+  EXPECT_NEAR(fallback_converter.geoid_height(35.5, 139.5), geoid_height, 0.001);
+  EXPECT_DOUBLE_EQ(
+    fallback_converter.geoid_height(34.0, 139.5), geoid_converter.geoid_height(34.0, 139.5));
+
+  std::filesystem::remove(path);
+}
+
+TEST(GeographyUtilsGeoidTile, TruncatedFile)
+{
+  const std::string path = make_temporary_path();
+  autoware::geography_utils::write_geoid_tile_file(path, make_grid_info(), synthetic_geoid_height);
+  std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+  EXPECT_THROW(autoware::geography_utils::GeoidTileFile{path}, std::runtime_error);
+  std::filesystem::remove(path);
+}
+
+TEST(GeographyUtilsGeoidTile, InvalidFile)
+{
+  EXPECT_THROW(
+    autoware::geography_utils::GeoidTileFile("/nonexistent/geoid.awgt"), std::runtime_error);
+}
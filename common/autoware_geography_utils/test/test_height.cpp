@@ -18,6 +18,8 @@
 
 #include <stdexcept>
 #include <string>
+#include <thread>
+#include <vector>
 
 // Test case to verify if same source and target datums return original height
 TEST(GeographyUtils, SameSourceTargetDatum)
@@ -84,3 +86,33 @@ TEST(GeographyUtils, InvalidTargetDatum)
     autoware::geography_utils::convert_height(height, latitude, longitude, "WGS84", "INVALID2"),
     std::invalid_argument);
 }
+
+// Test case to verify that a converter shared between threads gives the same results
+TEST(GeographyUtils, GeoidHeightConverterMultiThread)
+{
+  const autoware::geography_utils::GeoidHeightConverter converter;
+  const double height = 10.0;
+  const double expected_height = converter.convert_wgs84_to_egm2008(height, 35.0, 139.0);
+
+  constexpr size_t num_threads = 4;
+  std::vector<double> converted_heights(num_threads);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < num_threads; ++i) {
+    threads.emplace_back([&converter, &converted_heights, i, height]() {
+      // move around to invalidate the interpolation cache of each thread
+      for (int j = 0; j < 100; ++j) {
+        static_cast<void>(converter.geoid_height(35.0 + 0.01 * j, 139.0 + 0.01 * j));
+      }
+      converted_heights[i] = converter.convert_wgs84_to_egm2008(height, 35.0, 139.0);
+    });
+  }
+  for (auto & thread : threads) {
+    thread.join();
+  }
+
+  for (const double converted_height : converted_heights) {
+    EXPECT_DOUBLE_EQ(expected_height, converted_height);
+  }
+  EXPECT_DOUBLE_EQ(
+    height, converter.convert_egm2008_to_wgs84(expected_height, 35.0, 139.0));
+}
@@ -0,0 +1,34 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "projection_round_trip.hpp"
+
+#include <gtest/gtest.h>
+
+namespace round_trip = autoware::geography_utils::round_trip;
+
+// Round-trips random points, including points near the grid and zone edges, for every projector.
+// Run benchmark_projection_round_trip for millions of points and the latency distribution.
+TEST(GeographyUtilsProjectionRoundTrip, RandomPoints)
+{
+  constexpr size_t num_points = 10000;
+  constexpr uint32_t seed = 0;
+
+  for (const auto & projector_case : round_trip::make_projector_cases()) {
+    const auto result = round_trip::run_round_trips(projector_case, num_points, seed);
+    // MGRS coordinates are rounded to 100 micro meters
+    EXPECT_LT(result.max_error.horizontal, 0.001) << projector_case.name;
+    EXPECT_LT(result.max_error.vertical, 0.001) << projector_case.name;
+  }
+}
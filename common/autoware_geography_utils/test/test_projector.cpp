@@ -0,0 +1,111 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <autoware/geography_utils/projection.hpp>
+#include <autoware/geography_utils/projector.hpp>
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <variant>
+#include <vector>
+
+TEST(GeographyUtilsProjector, MakeProjector)
+{
+  autoware_map_msgs::msg::MapProjectorInfo projector_info;
+  projector_info.map_origin.latitude = 35.62426;
+  projector_info.map_origin.longitude = 139.74252;
+  projector_info.mgrs_grid = "54SUE";
+
+  projector_info.projector_type = autoware_map_msgs::msg::MapProjectorInfo::MGRS;
+  EXPECT_TRUE(std::holds_alternative<autoware::geography_utils::MGRSProjector>(
+    autoware::geography_utils::make_projector(projector_info)));
+
+  projector_info.projector_type = autoware_map_msgs::msg::MapProjectorInfo::LOCAL_CARTESIAN_UTM;
+  EXPECT_TRUE(std::holds_alternative<autoware::geography_utils::LocalCartesianUTMProjector>(
+    autoware::geography_utils::make_projector(projector_info)));
+
+  projector_info.projector_type = autoware_map_msgs::msg::MapProjectorInfo::TRANSVERSE_MERCATOR;
+  EXPECT_TRUE(std::holds_alternative<autoware::geography_utils::TransverseMercatorProjector>(
+    autoware::geography_utils::make_projector(projector_info)));
+
+  projector_info.projector_type = "INVALID_TYPE";
+  EXPECT_THROW(
+    static_cast<void>(autoware::geography_utils::make_projector(projector_info)),
+    std::invalid_argument);
+}
+
+TEST(GeographyUtilsProjector, MatchesProjectionFunctions)
+{
+  geographic_msgs::msg::GeoPoint geo_point;
+  geo_point.latitude = 35.62426;
+  geo_point.longitude = 139.74252;
+  geo_point.altitude = 10.0;
+
+  autoware_map_msgs::msg::MapProjectorInfo projector_info;
+  projector_info.mgrs_grid = "54SUE";
+  projector_info.map_origin.latitude = 35.0;
+  projector_info.map_origin.longitude = 139.0;
+  projector_info.map_origin.altitude = -10.0;
+
+  for (const auto & projector_type :
+       {autoware_map_msgs::msg::MapProjectorInfo::MGRS,
+        autoware_map_msgs::msg::MapProjectorInfo::LOCAL_CARTESIAN_UTM,
+        autoware_map_msgs::msg::MapProjectorInfo::TRANSVERSE_MERCATOR}) {
+    projector_info.projector_type = projector_type;
+    const auto projector = autoware::geography_utils::make_projector(projector_info);
+
+    const auto expected_local_point =
+      autoware::geography_utils::project_forward(geo_point, projector_info);
+    const auto local_point = autoware::geography_utils::project_forward(geo_point, projector);
+    EXPECT_DOUBLE_EQ(local_point.x, expected_local_point.x);
+    EXPECT_DOUBLE_EQ(local_point.y, expected_local_point.y);
+    EXPECT_DOUBLE_EQ(local_point.z, expected_local_point.z);
+
+    const auto expected_geo_point =
+      autoware::geography_utils::project_reverse(local_point, projector_info);
+    const auto converted_geo_point =
+      autoware::geography_utils::project_reverse(local_point, projector);
+    EXPECT_DOUBLE_EQ(converted_geo_point.latitude, expected_geo_point.latitude);
+    EXPECT_DOUBLE_EQ(converted_geo_point.longitude, expected_geo_point.longitude);
+    EXPECT_DOUBLE_EQ(converted_geo_point.altitude, expected_geo_point.altitude);
+  }
+}
+
+TEST(GeographyUtilsProjector, ProjectBatch)
+{
+  autoware::geography_utils::MGRSProjector projector{"54SUE"};
+
+  std::vector<geographic_msgs::msg::GeoPoint> geo_points(3);
+  for (size_t i = 0; i < geo_points.size(); ++i) {
+    geo_points[i].latitude = 35.62426 + 0.001 * static_cast<double>(i);
+    geo_points[i].longitude = 139.74252;
+  }
+
+  const auto local_points = autoware::geography_utils::project_forward(geo_points, projector);
+  ASSERT_EQ(local_points.size(), geo_points.size());
+  for (size_t i = 0; i < geo_points.size(); ++i) {
+    const auto local_point = projector.forward(geo_points[i]);
+    EXPECT_DOUBLE_EQ(local_points[i].x, local_point.x);
+    EXPECT_DOUBLE_EQ(local_points[i].y, local_point.y);
+  }
+
+  const auto converted_geo_points =
+    autoware::geography_utils::project_reverse(local_points, projector);
+  ASSERT_EQ(converted_geo_points.size(), geo_points.size());
+  for (size_t i = 0; i < geo_points.size(); ++i) {
+    EXPECT_NEAR(converted_geo_points[i].latitude, geo_points[i].latitude, 0.0001);
+    EXPECT_NEAR(converted_geo_points[i].longitude, geo_points[i].longitude, 0.0001);
+  }
+}
@@ -0,0 +1,146 @@
+// Copyright 2024 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <autoware/geography_utils/projection.hpp>
+#include <autoware/geography_utils/tile_index.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+autoware_map_msgs::msg::MapProjectorInfo make_mgrs_projector_info()
+{
+  autoware_map_msgs::msg::MapProjectorInfo projector_info;
+  projector_info.projector_type = autoware_map_msgs::msg::MapProjectorInfo::MGRS;
+  projector_info.mgrs_grid = "54SUE";
+  projector_info.vertical_datum = autoware_map_msgs::msg::MapProjectorInfo::WGS84;
+  return projector_info;
+}
+
+autoware::geography_utils::GeoBoundingBox make_coverage()
+{
+  autoware::geography_utils::GeoBoundingBox coverage;
+  coverage.min_latitude = 35.60;
+  coverage.min_longitude = 139.72;
+  coverage.max_latitude = 35.65;
+  coverage.max_longitude = 139.77;
+  return coverage;
+}
+}  // namespace
+
+TEST(GeographyUtilsTileIndex, ToTileId)
+{
+  const autoware::geography_utils::TileIndex tile_index(
+    make_mgrs_projector_info(), 1000.0, make_coverage());
+
+  geometry_msgs::msg::Point local_point;
+  local_point.x = 86128.0;
+  local_point.y = 43002.0;
+  const auto tile_id = tile_index.to_tile_id(local_point);
+
+  EXPECT_EQ(tile_id.x, 86);
+  EXPECT_EQ(tile_id.y, 43);
+  EXPECT_TRUE(tile_index.contains(tile_id));
+}
+
+TEST(GeographyUtilsTileIndex, GeoBoundingBoxContainsPoint)
+{
+  const auto projector_info = make_mgrs_projector_info();
+  const autoware::geography_utils::TileIndex tile_index(projector_info, 1000.0, make_coverage());
+
+  geographic_msgs::msg::GeoPoint geo_point;
+  geo_point.latitude = 35.62426;
+  geo_point.longitude = 139.74252;
+  geo_point.altitude = 0.0;
+
+  const auto tile_id =
+    tile_index.to_tile_id(autoware::geography_utils::project_forward(geo_point, projector_info));
+  const auto & bounds = tile_index.to_geo_bounding_box(tile_id);
+
+  EXPECT_LE(bounds.min_latitude, geo_point.latitude);
+  EXPECT_GE(bounds.max_latitude, geo_point.latitude);
+  EXPECT_LE(bounds.min_longitude, geo_point.longitude);
+  EXPECT_GE(bounds.max_longitude, geo_point.longitude);
+}
+
+TEST(GeographyUtilsTileIndex, QueryMatchesProjectedCorners)
+{
+  const auto projector_info = make_mgrs_projector_info();
+  const autoware::geography_utils::TileIndex tile_index(projector_info, 1000.0, make_coverage());
+
+  autoware::geography_utils::GeoBoundingBox query;
+  query.min_latitude = 35.620;
+  query.min_longitude = 139.740;
+  query.max_latitude = 35.630;
+  query.max_longitude = 139.750;
+
+  const std::vector<autoware::geography_utils::TileId> tile_ids = tile_index.query(query);
+  ASSERT_FALSE(tile_ids.empty());
+
+  // every corner of the query box must be covered by one of the returned tiles
+  for (const double latitude : {query.min_latitude, query.max_latitude}) {
+    for (const double longitude : {query.min_longitude, query.max_longitude}) {
+      geographic_msgs::msg::GeoPoint geo_point;
+      geo_point.latitude = latitude;
+      geo_point.longitude = longitude;
+      const auto tile_id = tile_index.to_tile_id(
+        autoware::geography_utils::project_forward(geo_point, projector_info));
+      EXPECT_NE(std::find(tile_ids.begin(), tile_ids.end(), tile_id), tile_ids.end());
+    }
+  }
+
+  // every returned tile must overlap the query box
+  for (const auto & tile_id : tile_ids) {
+    EXPECT_TRUE(tile_index.to_geo_bounding_box(tile_id).intersects(query));
+  }
+}
+
+TEST(GeographyUtilsTileIndex, QueryOutsideCoverage)
+{
+  const autoware::geography_utils::TileIndex tile_index(
+    make_mgrs_projector_info(), 1000.0, make_coverage());
+
+  autoware::geography_utils::GeoBoundingBox query;
+  query.min_latitude = 36.0;
+  query.min_longitude = 140.0;
+  query.max_latitude = 36.1;
+  query.max_longitude = 140.1;
+
+  EXPECT_TRUE(tile_index.query(query).empty());
+  EXPECT_THROW(
+    static_cast<void>(tile_index.to_geo_bounding_box(autoware::geography_utils::TileId{0, 0})),
+    std::out_of_range);
+}
+
+TEST(GeographyUtilsTileIndex, InvalidTileSize)
+{
+  EXPECT_THROW(
+    autoware::geography_utils::TileIndex(make_mgrs_projector_info(), 0.0, make_coverage()),
+    std::invalid_argument);
+}
+
+TEST(GeographyUtilsTileIndex, CoverageLeavingTheMGRSGridSquare)
+{
+  // 54SUE ends at about 139.87 degrees east at this latitude
+  auto coverage = make_coverage();
+  coverage.min_longitude = 139.85;
+  coverage.max_longitude = 139.95;
+  EXPECT_THROW(
+    autoware::geography_utils::TileIndex(make_mgrs_projector_info(), 1000.0, coverage),
+    std::invalid_argument);
+}
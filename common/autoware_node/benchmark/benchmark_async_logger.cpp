@@ -0,0 +1,100 @@
+// Copyright 2024 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Compares the execution time of a 1 ms monitored timer callback logging a formatted line
+// through RCLCPP_INFO and through the asynchronous logger, and without logging.
+//
+// usage: benchmark_async_logger [duration_s] 2> /dev/null
+
+#include <autoware/node/async_logger.hpp>
+#include <autoware/node/node.hpp>
+#include <rclcpp/rclcpp.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <future>
+#include <memory>
+#include <string>
+
+using namespace std::chrono_literals;
+
+namespace
+{
+enum class LoggingMode { Disabled, Synchronous, Asynchronous };
+
+const char * to_string(const LoggingMode mode)
+{
+  switch (mode) {
+    case LoggingMode::Disabled:
+      return "disabled";
+    case LoggingMode::Synchronous:
+      return "rclcpp";
+    case LoggingMode::Asynchronous:
+      return "async";
+  }
+  return "";
+}
+
+void run(const std::chrono::seconds duration, const LoggingMode mode)
+{
+  auto node = std::make_shared<autoware::node::Node>("benchmark_async_logger");
+  uint64_t count = 0;
+  double value = 0.0;
+  const auto timer = node->create_monitored_timer("control", 1ms, [&]() {
+    ++count;
+    value += 0.1;
+    if (mode == LoggingMode::Synchronous) {
+      RCLCPP_INFO(
+        node->get_logger(), "control cycle %lu: value %.3f from %s",
+        static_cast<unsigned long>(count), value, node->get_name());  // NOLINT
+    } else if (mode == LoggingMode::Asynchronous) {
+      AUTOWARE_ASYNC_INFO(
+        node->get_async_logger(), "control cycle %lu: value %.3f from %s",
+        static_cast<unsigned long>(count), value, node->get_name());  // NOLINT
+    }
+  });
+
+  rclcpp::executors::SingleThreadedExecutor executor;
+  executor.add_node(node->get_node_base_interface());
+  executor.spin_until_future_complete(std::promise<void>().get_future(), duration);
+
+  for (const auto & snapshot : node->get_callback_latency_snapshots()) {
+    const auto & execution_time = snapshot.execution_time;
+    std::printf(
+      "%-10s %8lu %10.2f %10.2f %10.2f %10.2f\n", to_string(mode),
+      static_cast<unsigned long>(execution_time.count),  // NOLINT
+      execution_time.percentile(50.0) / 1e3, execution_time.percentile(99.0) / 1e3,
+      execution_time.percentile(99.9) / 1e3, execution_time.max / 1e3);
+  }
+}
+}  // namespace
+
+int main(int argc, char ** argv)
+{
+  std::chrono::seconds duration{5};
+  if (argc > 1) {
+    duration = std::chrono::seconds(std::atoll(argv[1]));
+  }
+
+  rclcpp::init(1, argv);
+  std::printf(
+    "%-10s %8s %10s %10s %10s %10s\n", "logging", "count", "p50[us]", "p99[us]", "p99.9[us]",
+    "max[us]");
+  run(duration, LoggingMode::Disabled);
+  run(duration, LoggingMode::Synchronous);
+  run(duration, LoggingMode::Asynchronous);
+  rclcpp::shutdown();
+  return 0;
+}
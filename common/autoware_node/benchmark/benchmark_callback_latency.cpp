@@ -0,0 +1,118 @@
+// Copyright 2024 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Measures the overhead of the monitored timers and subscriptions of a node per callback, i.e.
+// what create_monitored_timer() and create_monitored_subscription() add to an empty callback
+// compared to create_wall_timer() and create_subscription(), with the default parameters, without
+// the resource usage, whose two thread CPU clock reads are system calls, and without the callback
+// latency recording either. The callbacks are executed through the timers and subscriptions, as
+// an executor does, so that the whole wrappers are measured. The target of the recording is below
+// 100 ns per callback.
+//
+// usage: benchmark_callback_latency [callbacks] 2> /dev/null
+
+#include <autoware/node/node.hpp>
+#include <rclcpp/rclcpp.hpp>
+
+#include <diagnostic_msgs/msg/key_value.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+
+namespace
+{
+template <typename CallbackT>
+double measure(const size_t callbacks, CallbackT && callback)
+{
+  const auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < callbacks; ++i) {
+    callback();
+  }
+  const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+  return elapsed.count() / static_cast<double>(callbacks);
+}
+}  // namespace
+
+int main(int argc, char ** argv)
+{
+  using diagnostic_msgs::msg::KeyValue;
+  using namespace std::chrono_literals;
+
+  size_t callbacks = 1000000;
+  if (argc > 1) {
+    callbacks = static_cast<size_t>(std::atoll(argv[1]));
+  }
+
+  rclcpp::init(1, argv);
+  auto node = std::make_shared<autoware::node::Node>("benchmark_callback_latency");
+  volatile size_t counter = 0;
+  const auto count = [&counter]() { counter = counter + 1; };
+  const auto count_message = [&counter](const KeyValue::ConstSharedPtr) { counter = counter + 1; };
+
+  // the timers never expire by themselves, and the subscriptions are not spun
+  const auto timer = node->create_wall_timer(1h, count);
+  const auto monitored_timer = node->create_monitored_timer("benchmark", 1h, count);
+  const auto subscription = node->create_subscription<KeyValue>("~/input", 1, count_message);
+  const auto monitored_subscription =
+    node->create_monitored_subscription<KeyValue>("~/monitored_input", 1, count_message);
+
+  std::shared_ptr<void> message = std::make_shared<KeyValue>();
+  rclcpp::MessageInfo message_info;
+  message_info.get_rmw_message_info().received_timestamp =
+    std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::system_clock::now().time_since_epoch())
+      .count();
+  const auto execute_timer = [callbacks](const rclcpp::TimerBase::SharedPtr & timer) {
+    return measure(callbacks, [&timer]() { timer->execute_callback(); });
+  };
+  const auto execute_subscription =
+    [callbacks, &message, &message_info](const rclcpp::SubscriptionBase::SharedPtr & subscription) {
+      return measure(callbacks, [&]() { subscription->handle_message(message, message_info); });
+    };
+
+  const double timer_time = execute_timer(timer);
+  const double subscription_time = execute_subscription(subscription);
+  const double monitored_timer_time = execute_timer(monitored_timer);
+  const double monitored_subscription_time = execute_subscription(monitored_subscription);
+  node->set_parameter(rclcpp::Parameter("resource_usage.enabled", false));
+  const double unaccounted_timer_time = execute_timer(monitored_timer);
+  const double unaccounted_subscription_time = execute_subscription(monitored_subscription);
+  node->set_parameter(rclcpp::Parameter("callback_latency.enabled", false));
+  const double disabled_timer_time = execute_timer(monitored_timer);
+  const double disabled_subscription_time = execute_subscription(monitored_subscription);
+
+  std::printf("%-14s %-24s %16s %16s\n", "callback", "wrapper", "time/call[ns]", "overhead[ns]");
+  const auto print = [](const char * callback, const char * wrapper, double time, double plain) {
+    std::printf("%-14s %-24s %16.1f %16.1f\n", callback, wrapper, time, time - plain);
+  };
+  print("timer", "plain", timer_time, timer_time);
+  print("timer", "monitored", monitored_timer_time, timer_time);
+  print("timer", "no resource usage", unaccounted_timer_time, timer_time);
+  print("timer", "no recording", disabled_timer_time, timer_time);
+  print("subscription", "plain", subscription_time, subscription_time);
+  print("subscription", "monitored", monitored_subscription_time, subscription_time);
+  print("subscription", "no resource usage", unaccounted_subscription_time, subscription_time);
+  print("subscription", "no recording", disabled_subscription_time, subscription_time);
+  std::printf(
+    "resource usage costs %.1f ns per callback\n", monitored_timer_time - unaccounted_timer_time);
+  std::printf(
+    "overhead of the recording %s the target of 100 ns per callback\n",
+    unaccounted_timer_time - timer_time < 100.0 ? "meets" : "misses");
+
+  node.reset();
+  rclcpp::shutdown();
+  return 0;
+}
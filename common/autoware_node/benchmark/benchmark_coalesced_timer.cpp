@@ -0,0 +1,144 @@
+// Copyright 2024 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Compares a container-like process of nodes with low-rate periodic tasks on wall timers and on
+// coalesced timers: the callbacks run, the context switches and the CPU time of the process, the
+// wakeups of the executor, and the wakeups of the coalescer thread. The coalesced timers do not
+// save the wakeups of the executor: every expiration is posted to the task completion queue of
+// its node, which allocates the task and the node of the queue on the coalescer thread and
+// triggers the guard condition waking up the executor.
+//
+// usage: benchmark_coalesced_timer [num_nodes] [duration_s] 2> /dev/null
+
+#include <autoware/node/node.hpp>
+#include <autoware/node/timer_coalescer.hpp>
+#include <rclcpp/rclcpp.hpp>
+
+#include <sys/resource.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+namespace
+{
+rusage get_usage()
+{
+  rusage usage{};
+  getrusage(RUSAGE_SELF, &usage);
+  return usage;
+}
+
+// spins like SingleThreadedExecutor, counting the returns from the wait for work
+class CountingExecutor : public rclcpp::executors::SingleThreadedExecutor
+{
+public:
+  void spin_for(const std::chrono::nanoseconds duration)
+  {
+    const auto deadline = std::chrono::steady_clock::now() + duration;
+    while (rclcpp::ok(context_)) {
+      rclcpp::AnyExecutable any_executable;
+      if (get_next_ready_executable(any_executable)) {
+        execute_any_executable(any_executable);
+        ++execution_count;
+        continue;
+      }
+      const auto remaining = deadline - std::chrono::steady_clock::now();
+      if (remaining <= std::chrono::nanoseconds::zero()) {
+        return;
+      }
+      wait_for_work(remaining);
+      ++wakeup_count;
+    }
+  }
+
+  uint64_t wakeup_count{0};
+  uint64_t execution_count{0};
+};
+
+double to_seconds(const timeval & time)
+{
+  return static_cast<double>(time.tv_sec) + static_cast<double>(time.tv_usec) * 1e-6;
+}
+
+void run(const size_t num_nodes, const std::chrono::seconds duration, const bool coalesced)
+{
+  std::vector<std::shared_ptr<autoware::node::Node>> nodes;
+  std::vector<rclcpp::TimerBase::SharedPtr> timers;
+  std::vector<autoware::node::CoalescedTimer::SharedPtr> coalesced_timers;
+  CountingExecutor executor;
+  uint64_t count = 0;
+  for (size_t i = 0; i < num_nodes; ++i) {
+    nodes.push_back(
+      std::make_shared<autoware::node::Node>("benchmark_coalesced_timer_" + std::to_string(i)));
+    executor.add_node(nodes.back()->get_node_base_interface());
+    // diagnostics, heartbeat and housekeeping
+    for (const auto period : {100ms, 200ms, 1000ms}) {
+      if (coalesced) {
+        coalesced_timers.push_back(
+          nodes.back()->create_coalesced_timer(period, [&count]() { ++count; }));
+      } else {
+        timers.push_back(nodes.back()->create_wall_timer(period, [&count]() { ++count; }));
+      }
+    }
+  }
+
+  const auto statistics_before = autoware::node::TimerCoalescer::get_instance().get_statistics();
+  const auto usage_before = get_usage();
+  executor.spin_for(duration);
+  const auto usage_after = get_usage();
+  const auto statistics_after = autoware::node::TimerCoalescer::get_instance().get_statistics();
+
+  const double seconds = static_cast<double>(duration.count());
+  const auto switches = usage_after.ru_nvcsw + usage_after.ru_nivcsw - usage_before.ru_nvcsw -
+                        usage_before.ru_nivcsw;
+  // the wall timers have no coalescer thread
+  const uint64_t coalescer_wakeups =
+    coalesced ? statistics_after.wakeup_count - statistics_before.wakeup_count : 0;
+  const double cpu_time = to_seconds(usage_after.ru_utime) + to_seconds(usage_after.ru_stime) -
+                          to_seconds(usage_before.ru_utime) - to_seconds(usage_before.ru_stime);
+  std::printf(
+    "%-10s %8zu %12.0f %12.0f %12.0f %12.0f %12.0f %10.3f\n", coalesced ? "coalesced" : "wall",
+    num_nodes, static_cast<double>(count) / seconds, static_cast<double>(switches) / seconds,
+    static_cast<double>(executor.wakeup_count) / seconds,
+    static_cast<double>(executor.execution_count) / seconds,
+    static_cast<double>(coalescer_wakeups) / seconds, cpu_time / seconds);
+}
+}  // namespace
+
+int main(int argc, char ** argv)
+{
+  size_t num_nodes = 200;
+  std::chrono::seconds duration{10};
+  if (argc > 1) {
+    num_nodes = static_cast<size_t>(std::atoll(argv[1]));
+  }
+  if (argc > 2) {
+    duration = std::chrono::seconds(std::atoll(argv[2]));
+  }
+
+  rclcpp::init(1, argv);
+  std::printf(
+    "%-10s %8s %12s %12s %12s %12s %12s %10s\n", "timers", "nodes", "callbacks/s", "switches/s",
+    "wakeups/s", "executions/s", "coalescer/s", "cpu");
+  run(num_nodes, duration, false);
+  run(num_nodes, duration, true);
+  rclcpp::shutdown();
+  return 0;
+}
@@ -0,0 +1,118 @@
+// Copyright 2024 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Compares the throughput of a single-threaded executor running a service server and clients
+// which keep a number of calls in flight, written as coroutines and as chained callbacks.
+//
+// usage: benchmark_coroutine [duration_s] 2> /dev/null
+
+#include <autoware/node/coroutine.hpp>
+#include <autoware/node/node.hpp>
+#include <rclcpp/rclcpp.hpp>
+
+#include <std_srvs/srv/set_bool.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <future>
+#include <memory>
+
+using namespace std::chrono_literals;
+using std_srvs::srv::SetBool;
+
+namespace
+{
+autoware::node::Coroutine<> call_in_loop(
+  autoware::node::Node & node, rclcpp::Client<SetBool>::SharedPtr client, const bool & running,
+  uint64_t & count)
+{
+  while (running) {
+    auto response = co_await autoware::node::async_call<SetBool>(
+      node, client, std::make_shared<SetBool::Request>());
+    if (response) {
+      ++count;
+    }
+  }
+}
+
+void call_with_callbacks(
+  rclcpp::Client<SetBool>::SharedPtr client, const bool & running, uint64_t & count)
+{
+  client->async_send_request(
+    std::make_shared<SetBool::Request>(),
+    [client, &running, &count](rclcpp::Client<SetBool>::SharedFuture future) {
+      if (future.get()) {
+        ++count;
+      }
+      if (running) {
+        call_with_callbacks(client, running, count);
+      }
+    });
+}
+
+void run(const std::chrono::seconds duration, const size_t in_flight, const bool coroutine)
+{
+  auto server_node = std::make_shared<autoware::node::Node>("benchmark_coroutine_server");
+  const auto service = server_node->create_service<SetBool>(
+    "benchmark_coroutine",
+    [](const SetBool::Request::SharedPtr request, SetBool::Response::SharedPtr response) {
+      response->success = request->data;
+    });
+  auto client_node = std::make_shared<autoware::node::Node>("benchmark_coroutine_client");
+  auto client = client_node->create_client<SetBool>("benchmark_coroutine");
+
+  rclcpp::executors::SingleThreadedExecutor executor;
+  executor.add_node(server_node->get_node_base_interface());
+  executor.add_node(client_node->get_node_base_interface());
+  client->wait_for_service(1s);
+
+  bool running = true;
+  uint64_t count = 0;
+  for (size_t i = 0; i < in_flight; ++i) {
+    if (coroutine) {
+      autoware::node::spawn(call_in_loop(*client_node, client, running, count));
+    } else {
+      call_with_callbacks(client, running, count);
+    }
+  }
+  executor.spin_until_future_complete(std::promise<void>().get_future(), duration);
+
+  // let the calls in flight finish before their nodes are destroyed
+  running = false;
+  executor.spin_until_future_complete(std::promise<void>().get_future(), 100ms);
+
+  std::printf(
+    "%-10s %10zu %12.0f\n", coroutine ? "coroutine" : "callback", in_flight,
+    static_cast<double>(count) / static_cast<double>(duration.count()));
+}
+}  // namespace
+
+int main(int argc, char ** argv)
+{
+  std::chrono::seconds duration{5};
+  if (argc > 1) {
+    duration = std::chrono::seconds(std::atoll(argv[1]));
+  }
+
+  rclcpp::init(1, argv);
+  std::printf("%-10s %10s %12s\n", "client", "in flight", "calls/s");
+  for (const size_t in_flight : {1, 10, 100, 1000}) {
+    run(duration, in_flight, false);
+    run(duration, in_flight, true);
+  }
+  rclcpp::shutdown();
+  return 0;
+}
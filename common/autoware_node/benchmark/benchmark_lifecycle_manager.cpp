@@ -0,0 +1,93 @@
+// Copyright 2024 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Measures the cost of many nodes with their own lifecycle services or with the lifecycle
+// manager: construction time, resident memory and the services and topics seen in the graph.
+// Run it once per mode, so that the memory of one mode does not hide the other.
+//
+// usage: benchmark_lifecycle_manager [num_nodes] [services|manager]
+
+#include <autoware/node/node.hpp>
+#include <rclcpp/rclcpp.hpp>
+
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+// resident set size in MiB
+double get_rss()
+{
+  std::ifstream statm("/proc/self/statm");
+  size_t size = 0;
+  size_t resident = 0;
+  statm >> size >> resident;
+  return static_cast<double>(resident * sysconf(_SC_PAGESIZE)) / (1024.0 * 1024.0);
+}
+}  // namespace
+
+int main(int argc, char ** argv)
+{
+  const int num_nodes = argc > 1 ? std::atoi(argv[1]) : 200;
+  const std::string mode = argc > 2 ? argv[2] : "services";
+  rclcpp::init(1, argv);
+
+  rclcpp::NodeOptions options;
+  options.parameter_overrides({{"lifecycle_manager.enabled", mode == "manager"}});
+  auto observer = std::make_shared<rclcpp::Node>("observer");
+  const size_t base_services = observer->get_service_names_and_types().size();
+  const size_t base_topics = observer->get_topic_names_and_types().size();
+
+  const double rss_before = get_rss();
+  const auto start = std::chrono::steady_clock::now();
+  std::vector<std::shared_ptr<autoware::node::Node>> nodes;
+  for (int i = 0; i < num_nodes; ++i) {
+    nodes.push_back(
+      std::make_shared<autoware::node::Node>("node_" + std::to_string(i), "benchmark", options));
+  }
+  const double construction_time =
+    std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  const double rss_after = get_rss();
+
+  // wait for the graph to settle
+  size_t services = 0;
+  size_t topics = 0;
+  for (int i = 0; i < 50; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    const size_t current_services = observer->get_service_names_and_types().size();
+    const size_t current_topics = observer->get_topic_names_and_types().size();
+    if (i > 10 && current_services == services && current_topics == topics) {
+      break;
+    }
+    services = current_services;
+    topics = current_topics;
+  }
+
+  std::printf(
+    "%s: %d nodes constructed in %.1f ms, RSS +%.1f MiB, %zu services and %zu topics\n",
+    mode.c_str(), num_nodes, construction_time, rss_after - rss_before, services - base_services,
+    topics - base_topics);
+
+  nodes.clear();
+  rclcpp::shutdown();
+  return 0;
+}
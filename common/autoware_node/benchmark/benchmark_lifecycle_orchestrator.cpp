@@ -0,0 +1,115 @@
+// Copyright 2024 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Compares the time to configure and activate many nodes one after the other and with
+// LifecycleOrchestrator, each node depending on up to two nodes of the previous layers.
+//
+// usage: benchmark_lifecycle_orchestrator [num_nodes] [num_threads]
+
+#include <autoware/node/lifecycle_orchestrator.hpp>
+#include <autoware/node/node.hpp>
+#include <rclcpp/rclcpp.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+// node spending some time in its configuration, e.g. loading parameters
+class ConfiguringNode : public autoware::node::Node
+{
+public:
+  explicit ConfiguringNode(const std::string & name) : Node(name, "benchmark") {}
+
+  autoware::node::CallbackReturn on_configure(const rclcpp_lifecycle::State &) override
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    return autoware::node::CallbackReturn::SUCCESS;
+  }
+};
+
+std::vector<std::shared_ptr<ConfiguringNode>> make_nodes(const int num_nodes)
+{
+  std::vector<std::shared_ptr<ConfiguringNode>> nodes;
+  for (int i = 0; i < num_nodes; ++i) {
+    nodes.push_back(std::make_shared<ConfiguringNode>("node_" + std::to_string(i)));
+  }
+  return nodes;
+}
+
+double to_milliseconds(const std::chrono::nanoseconds duration)
+{
+  return std::chrono::duration<double, std::milli>(duration).count();
+}
+}  // namespace
+
+int main(int argc, char ** argv)
+{
+  const int num_nodes = argc > 1 ? std::atoi(argv[1]) : 200;
+  const int num_threads =
+    argc > 2 ? std::atoi(argv[2]) : static_cast<int>(std::thread::hardware_concurrency());
+  rclcpp::init(1, argv);
+
+  {
+    const auto nodes = make_nodes(num_nodes);
+    const auto start = std::chrono::steady_clock::now();
+    for (const auto & node : nodes) {
+      node->configure();
+    }
+    for (const auto & node : nodes) {
+      node->activate();
+    }
+    std::printf(
+      "sequential:   %8.1f ms\n", to_milliseconds(std::chrono::steady_clock::now() - start));
+  }
+
+  {
+    const auto nodes = make_nodes(num_nodes);
+    autoware::node::LifecycleOrchestrator orchestrator(num_threads);
+    std::mt19937 engine(0);
+    for (int i = 0; i < num_nodes; ++i) {
+      std::vector<std::string> dependencies;
+      for (int j = 0; j < 2 && i > 0; ++j) {
+        std::uniform_int_distribution<int> distribution(std::max(0, i - 20), i - 1);
+        dependencies.push_back(nodes[distribution(engine)]->get_fully_qualified_name());
+      }
+      orchestrator.add_node(nodes[i], dependencies);
+    }
+
+    const auto configure_result = orchestrator.configure();
+    const auto activate_result = orchestrator.activate();
+    std::printf(
+      "orchestrated: %8.1f ms (configure %.1f ms, activate %.1f ms, %zu waves)\n",
+      to_milliseconds(configure_result.duration + activate_result.duration),
+      to_milliseconds(configure_result.duration), to_milliseconds(activate_result.duration),
+      configure_result.waves.size());
+    for (size_t i = 0; i < configure_result.waves.size(); ++i) {
+      const auto & wave = configure_result.waves[i];
+      std::printf(
+        "  configure wave %3zu: %4zu nodes %8.2f ms, slowest %s %.2f ms\n", i,
+        wave.node_names.size(), to_milliseconds(wave.duration), wave.slowest_node_name.c_str(),
+        to_milliseconds(wave.slowest_duration));
+    }
+  }
+
+  rclcpp::shutdown();
+  return 0;
+}
@@ -0,0 +1,91 @@
+// Copyright 2024 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Compares the time to read a double and a string parameter in callbacks through get_parameter()
+// and through parameter handles, from one thread and from several threads at once.
+//
+// usage: benchmark_parameter_handle [reads_per_thread] 2> /dev/null
+
+#include <autoware/node/node.hpp>
+#include <rclcpp/rclcpp.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+template <typename ReadT>
+double measure(const size_t num_threads, const size_t reads, ReadT && read)
+{
+  const auto start = std::chrono::steady_clock::now();
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < num_threads; ++i) {
+    threads.emplace_back([&read, reads]() {
+      size_t checksum = 0;
+      for (size_t j = 0; j < reads; ++j) {
+        checksum += read();
+      }
+      // keeps the reads from being optimized out
+      if (checksum == 1) {
+        std::printf("\n");
+      }
+    });
+  }
+  for (auto & thread : threads) {
+    thread.join();
+  }
+  const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+  return elapsed.count() / static_cast<double>(reads);
+}
+}  // namespace
+
+int main(int argc, char ** argv)
+{
+  size_t reads = 1000000;
+  if (argc > 1) {
+    reads = static_cast<size_t>(std::atoll(argv[1]));
+  }
+
+  rclcpp::init(1, argv);
+  auto node = std::make_shared<autoware::node::Node>("benchmark_parameter_handle");
+  const auto gain = node->declare_parameter_handle<double>("gain", 1.0);
+  const auto frame_id = node->declare_parameter_handle<std::string>("frame_id", "base_link");
+
+  std::printf("%-24s %8s %14s\n", "read", "threads", "time/read[ns]");
+  for (const size_t num_threads : {1, 4}) {
+    const auto print = [num_threads](const char * label, const double time) {
+      std::printf("%-24s %8zu %14.1f\n", label, num_threads, time);
+    };
+    print("get_parameter double", measure(num_threads, reads, [&node]() {
+            return static_cast<size_t>(node->get_parameter("gain").as_double());
+          }));
+    print("handle double", measure(num_threads, reads, [&gain]() {
+            return static_cast<size_t>(gain->get());
+          }));
+    print("get_parameter string", measure(num_threads, reads, [&node]() {
+            return node->get_parameter("frame_id").as_string().size();
+          }));
+    print("handle string", measure(num_threads, reads, [&frame_id]() {
+            return frame_id->read([](const std::string & value) { return value.size(); });
+          }));
+  }
+  node.reset();
+  rclcpp::shutdown();
+  return 0;
+}
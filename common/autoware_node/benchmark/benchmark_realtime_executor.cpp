@@ -0,0 +1,134 @@
+// Copyright 2024 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Measures the wakeup jitter of a 1 ms control timer while a slow diagnostics timer and busy
+// threads load the CPUs, with a single-threaded executor and with RealtimeExecutor.
+//
+// usage: benchmark_realtime_executor [priority] [cpu] [num_load_threads] [duration_s]
+
+#include <autoware/node/node.hpp>
+#include <autoware/node/realtime_executor.hpp>
+#include <rclcpp/rclcpp.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+namespace
+{
+struct BenchmarkConfig
+{
+  int64_t priority{80};
+  int64_t cpu{-1};
+  int num_load_threads{static_cast<int>(std::thread::hardware_concurrency())};
+  std::chrono::seconds duration{5};
+};
+
+void busy_wait(const std::chrono::nanoseconds duration)
+{
+  const auto end = std::chrono::steady_clock::now() + duration;
+  while (std::chrono::steady_clock::now() < end) {
+  }
+}
+
+void run(const BenchmarkConfig & config, const bool realtime)
+{
+  rclcpp::NodeOptions options;
+  std::vector<int64_t> cpu_affinity;
+  if (config.cpu >= 0) {
+    cpu_affinity.push_back(config.cpu);
+  }
+  options.parameter_overrides(
+    {{"realtime.control.priority", config.priority},
+     {"realtime.control.cpu_affinity", cpu_affinity}});
+  auto node = std::make_shared<autoware::node::Node>("benchmark_realtime_executor", "", options);
+
+  const auto control_group =
+    realtime ? node->create_realtime_callback_group("control") : nullptr;
+  const auto control_timer = node->create_monitored_timer("control", 1ms, []() {}, control_group);
+  const auto diagnostics_timer =
+    node->create_wall_timer(10ms, []() { busy_wait(std::chrono::milliseconds(5)); });
+
+  std::atomic<bool> running{true};
+  std::vector<std::thread> load_threads;
+  for (int i = 0; i < config.num_load_threads; ++i) {
+    load_threads.emplace_back([&running]() {
+      while (running) {
+        busy_wait(1ms);
+      }
+    });
+  }
+
+  autoware::node::RealtimeExecutor realtime_executor;
+  rclcpp::executors::SingleThreadedExecutor single_threaded_executor;
+  std::thread spin_thread;
+  if (realtime) {
+    realtime_executor.add_node(node);
+    spin_thread = std::thread([&realtime_executor]() { realtime_executor.spin(); });
+  } else {
+    single_threaded_executor.add_node(node->get_node_base_interface());
+    spin_thread = std::thread([&single_threaded_executor]() { single_threaded_executor.spin(); });
+  }
+
+  std::this_thread::sleep_for(config.duration);
+  realtime ? realtime_executor.cancel() : single_threaded_executor.cancel();
+  spin_thread.join();
+  running = false;
+  for (auto & load_thread : load_threads) {
+    load_thread.join();
+  }
+
+  for (const auto & snapshot : node->get_callback_latency_snapshots()) {
+    const auto & jitter = snapshot.queueing_delay;
+    std::printf(
+      "%-16s %-14s %8lu %10.1f %10.1f %10.1f %10.1f\n",
+      realtime ? "realtime" : "single_threaded", snapshot.name.c_str(),
+      static_cast<unsigned long>(jitter.count), jitter.percentile(50.0) / 1e3,  // NOLINT
+      jitter.percentile(99.0) / 1e3, jitter.percentile(99.9) / 1e3, jitter.max / 1e3);
+  }
+}
+}  // namespace
+
+int main(int argc, char ** argv)
+{
+  BenchmarkConfig config;
+  if (argc > 1) {
+    config.priority = std::atoll(argv[1]);
+  }
+  if (argc > 2) {
+    config.cpu = std::atoll(argv[2]);
+  }
+  if (argc > 3) {
+    config.num_load_threads = std::atoi(argv[3]);
+  }
+  if (argc > 4) {
+    config.duration = std::chrono::seconds(std::atoll(argv[4]));
+  }
+
+  rclcpp::init(1, argv);
+  std::printf(
+    "%-16s %-14s %8s %10s %10s %10s %10s\n", "executor", "callback", "count", "p50[us]",
+    "p99[us]", "p99.9[us]", "max[us]");
+  run(config, false);
+  run(config, true);
+  rclcpp::shutdown();
+  return 0;
+}
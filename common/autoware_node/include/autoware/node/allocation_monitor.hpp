@@ -0,0 +1,77 @@
+// Copyright 2024 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__NODE__ALLOCATION_MONITOR_HPP_
+#define AUTOWARE__NODE__ALLOCATION_MONITOR_HPP_
+
+#include "autoware/node/visibility_control.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace autoware::node
+{
+
+enum class AllocationPolicy : uint8_t { Report, Abort };
+
+/**
+ * @brief Detector of heap allocations on the real-time threads of a node.
+ *
+ * Allocations are only seen if malloc is intercepted, by defining the hook of malloc_hook.hpp in
+ * the executable. They are counted, or abort the process, if they happen on a thread guarded by
+ * the monitor while it is armed and past its warm-up period, so that the policy of a node only
+ * applies to its own threads. on_allocation() itself never allocates.
+ */
+class AllocationMonitor
+{
+public:
+  AUTOWARE_NODE_PUBLIC AllocationMonitor(
+    const AllocationPolicy policy, const std::chrono::nanoseconds warmup) noexcept;
+
+  AllocationMonitor(const AllocationMonitor &) = delete;
+  AllocationMonitor & operator=(const AllocationMonitor &) = delete;
+
+  // arm until disarm(), ignoring the allocations during the warm-up period
+  AUTOWARE_NODE_PUBLIC void arm() noexcept;
+  AUTOWARE_NODE_PUBLIC void disarm() noexcept;
+  AUTOWARE_NODE_PUBLIC bool is_armed() const noexcept;
+
+  AUTOWARE_NODE_PUBLIC uint64_t get_allocation_count() const noexcept;
+  AUTOWARE_NODE_PUBLIC std::size_t get_last_allocation_size() const noexcept;
+  AUTOWARE_NODE_PUBLIC void reset() noexcept;
+
+  // guard the calling thread with the monitor, which must outlive the guard, or nullptr to stop
+  AUTOWARE_NODE_PUBLIC static void set_thread_monitor(AllocationMonitor * monitor) noexcept;
+  AUTOWARE_NODE_PUBLIC static AllocationMonitor * get_thread_monitor() noexcept;
+
+  // called by the malloc hook for every allocation, checked against the monitor of the thread
+  AUTOWARE_NODE_PUBLIC static void on_allocation(const std::size_t size) noexcept;
+  AUTOWARE_NODE_PUBLIC static bool is_hook_installed() noexcept;
+
+private:
+  void record(const std::size_t size) noexcept;
+
+  const AllocationPolicy policy_;
+  const std::chrono::nanoseconds warmup_;
+  std::atomic<bool> armed_{false};
+  std::atomic<int64_t> armed_time_{0};  // [ns] of the steady clock
+  std::atomic<uint64_t> allocation_count_{0};
+  std::atomic<std::size_t> last_allocation_size_{0};
+};
+
+}  // namespace autoware::node
+
+#endif  // AUTOWARE__NODE__ALLOCATION_MONITOR_HPP_
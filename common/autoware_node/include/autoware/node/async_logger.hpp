@@ -0,0 +1,295 @@
+// Copyright 2024 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__NODE__ASYNC_LOGGER_HPP_
+#define AUTOWARE__NODE__ASYNC_LOGGER_HPP_
+
+#include "autoware/node/visibility_control.hpp"
+
+#include <rcutils/logging.h>
+#include <rcutils/time.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace autoware::node
+{
+
+// static state of a logging statement
+struct LogSite
+{
+  LogSite(const char * file, const char * function, const size_t line, const int64_t period)
+  : file(file), function(function), line(line), throttle_period(period)
+  {
+  }
+
+  const char * const file;
+  const char * const function;
+  const size_t line;
+  const int64_t throttle_period;  // [ns], 0 to never throttle
+  std::atomic<int64_t> next_time{0};
+  std::atomic<uint64_t> suppressed_count{0};
+};
+
+namespace async_logger_detail
+{
+// strings are copied, as they may not outlive the formatting on the background thread
+struct StoredString
+{
+  static constexpr size_t capacity = 96;
+  char data[capacity];
+};
+
+inline StoredString store(const char * value)
+{
+  StoredString stored;
+  std::strncpy(stored.data, value ? value : "(null)", StoredString::capacity - 1);
+  stored.data[StoredString::capacity - 1] = '\0';
+  return stored;
+}
+inline StoredString store(char * value) { return store(static_cast<const char *>(value)); }
+template <typename T>
+std::enable_if_t<std::is_arithmetic_v<T> || std::is_enum_v<T> || std::is_pointer_v<T>, T> store(
+  const T value)
+{
+  return value;
+}
+
+inline const char * load(const StoredString & value) { return value.data; }
+template <typename T>
+T load(const T value)
+{
+  return value;
+}
+}  // namespace async_logger_detail
+
+struct LogRecord
+{
+  static constexpr size_t arguments_capacity = 384;
+
+  const LogSite * site;
+  const char * logger_name;
+  const char * format;
+  int severity;
+  uint64_t suppressed_count;
+  // system time of the log call, which the output shows instead of the time of the write
+  rcutils_time_point_value_t timestamp;
+  void (*format_function)(const LogRecord & record, char * buffer, size_t size);
+  alignas(std::max_align_t) unsigned char arguments[arguments_capacity];
+};
+
+/**
+ * @brief Process-wide bounded lock-free queue of log records, formatted and written through
+ * the rcutils output handler by a background thread, with the time of the log call.
+ *
+ * Pushing never blocks: records are dropped, and counted, when the queue is full.
+ */
+class AsyncLogBuffer
+{
+public:
+  static constexpr size_t capacity = 1024;  // power of two
+
+  AUTOWARE_NODE_PUBLIC static AsyncLogBuffer & get_instance();
+  AUTOWARE_NODE_PUBLIC ~AsyncLogBuffer();
+
+  // fills a free record with `fill(LogRecord &)`, or returns false if the queue is full
+  template <typename FillT>
+  bool try_push(FillT && fill)
+  {
+    size_t position = enqueue_position_.load(std::memory_order_relaxed);
+    Cell * cell = nullptr;
+    while (true) {
+      cell = &cells_[position & (capacity - 1)];
+      const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+      const auto difference =
+        static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+      if (difference == 0) {
+        if (enqueue_position_.compare_exchange_weak(
+              position, position + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (difference < 0) {
+        dropped_count_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+      } else {
+        position = enqueue_position_.load(std::memory_order_relaxed);
+      }
+    }
+    fill(cell->record);
+    cell->sequence.store(position + 1, std::memory_order_release);
+    return true;
+  }
+
+  // blocks until the records pushed so far are written
+  AUTOWARE_NODE_PUBLIC void flush();
+
+  uint64_t get_dropped_count() const { return dropped_count_.load(std::memory_order_relaxed); }
+
+private:
+  struct Cell
+  {
+    std::atomic<size_t> sequence;
+    LogRecord record;
+  };
+
+  AsyncLogBuffer();
+  void run();
+  // writes the available records and returns their number
+  size_t write_records();
+
+  std::unique_ptr<Cell[]> cells_;
+  alignas(64) std::atomic<size_t> enqueue_position_{0};
+  alignas(64) std::atomic<size_t> dequeue_position_{0};
+  std::atomic<uint64_t> dropped_count_{0};
+  uint64_t reported_dropped_count_{0};
+
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  bool flush_requested_{false};
+  bool stop_requested_{false};
+  std::thread thread_;
+};
+
+/**
+ * @brief Logger formatting its records lazily on the background thread of AsyncLogBuffer.
+ *
+ * The arguments are copied into the record, with C strings truncated to 95 characters, and the
+ * format string must be a literal. Use it through the AUTOWARE_ASYNC_* macros, which check the
+ * severity level of the logger first.
+ */
+class AsyncLogger
+{
+public:
+  explicit AsyncLogger(std::string name) : name_(std::move(name)) {}
+  AUTOWARE_NODE_PUBLIC ~AsyncLogger();
+
+  AsyncLogger(const AsyncLogger &) = delete;
+  AsyncLogger & operator=(const AsyncLogger &) = delete;
+
+  const std::string & get_name() const { return name_; }
+
+  bool is_enabled_for(const int severity) const
+  {
+    return rcutils_logging_logger_is_enabled_for(name_.c_str(), severity);
+  }
+
+  template <typename... Args>
+  void log(LogSite & site, const int severity, const char * format, const Args &... args)
+  {
+    uint64_t suppressed_count = 0;
+    if (site.throttle_period > 0) {
+      const int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            std::chrono::steady_clock::now().time_since_epoch())
+                            .count();
+      int64_t next_time = site.next_time.load(std::memory_order_relaxed);
+      if (
+        now < next_time ||
+        !site.next_time.compare_exchange_strong(next_time, now + site.throttle_period)) {
+        site.suppressed_count.fetch_add(1, std::memory_order_relaxed);
+        return;
+      }
+      suppressed_count = site.suppressed_count.exchange(0, std::memory_order_relaxed);
+    }
+
+    using Stored = std::tuple<decltype(async_logger_detail::store(args))...>;
+    static_assert(sizeof(Stored) <= LogRecord::arguments_capacity, "too many log arguments");
+    // the records are overwritten without being destroyed
+    static_assert(std::is_trivially_destructible_v<Stored>, "unsupported log argument");
+    used_.store(true, std::memory_order_relaxed);
+    AsyncLogBuffer::get_instance().try_push([&](LogRecord & record) {
+      record.site = &site;
+      record.logger_name = name_.c_str();
+      record.format = format;
+      record.severity = severity;
+      record.suppressed_count = suppressed_count;
+      if (rcutils_system_time_now(&record.timestamp) != RCUTILS_RET_OK) {
+        record.timestamp = 0;
+      }
+      record.format_function = &format_record<Stored>;
+      new (record.arguments) Stored(async_logger_detail::store(args)...);
+    });
+  }
+
+private:
+  template <typename Stored>
+  static void format_record(const LogRecord & record, char * buffer, const size_t size)
+  {
+    const auto & arguments = *std::launder(reinterpret_cast<const Stored *>(record.arguments));
+    std::apply(
+      [&](const auto &... stored) {
+// the format string is checked by the compiler at the call site instead
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wformat-security"
+#pragma GCC diagnostic ignored "-Wformat-nonliteral"
+        std::snprintf(buffer, size, record.format, async_logger_detail::load(stored)...);
+#pragma GCC diagnostic pop
+      },
+      arguments);
+  }
+
+  const std::string name_;
+  std::atomic<bool> used_{false};
+};
+
+}  // namespace autoware::node
+
+// NOLINTBEGIN(cppcoreguidelines-macro-usage)
+#define AUTOWARE_ASYNC_LOG_THROTTLE(logger, severity, period_ms, ...)                          \
+  do {                                                                                        \
+    if ((logger).is_enabled_for(severity)) {                                                  \
+      static ::autoware::node::LogSite autoware_async_log_site(                               \
+        __FILE__, __func__, __LINE__, static_cast<int64_t>(period_ms) * 1000000);             \
+      if (false) {                                                                            \
+        /* checks the format against the arguments */                                        \
+        std::printf(__VA_ARGS__);                                                             \
+      }                                                                                       \
+      (logger).log(autoware_async_log_site, severity, __VA_ARGS__);                           \
+    }                                                                                         \
+  } while (0)
+
+#define AUTOWARE_ASYNC_DEBUG(logger, ...) \
+  AUTOWARE_ASYNC_LOG_THROTTLE(logger, RCUTILS_LOG_SEVERITY_DEBUG, 0, __VA_ARGS__)
+#define AUTOWARE_ASYNC_INFO(logger, ...) \
+  AUTOWARE_ASYNC_LOG_THROTTLE(logger, RCUTILS_LOG_SEVERITY_INFO, 0, __VA_ARGS__)
+#define AUTOWARE_ASYNC_WARN(logger, ...) \
+  AUTOWARE_ASYNC_LOG_THROTTLE(logger, RCUTILS_LOG_SEVERITY_WARN, 0, __VA_ARGS__)
+#define AUTOWARE_ASYNC_ERROR(logger, ...) \
+  AUTOWARE_ASYNC_LOG_THROTTLE(logger, RCUTILS_LOG_SEVERITY_ERROR, 0, __VA_ARGS__)
+#define AUTOWARE_ASYNC_FATAL(logger, ...) \
+  AUTOWARE_ASYNC_LOG_THROTTLE(logger, RCUTILS_LOG_SEVERITY_FATAL, 0, __VA_ARGS__)
+
+#define AUTOWARE_ASYNC_INFO_THROTTLE(logger, period_ms, ...) \
+  AUTOWARE_ASYNC_LOG_THROTTLE(logger, RCUTILS_LOG_SEVERITY_INFO, period_ms, __VA_ARGS__)
+#define AUTOWARE_ASYNC_WARN_THROTTLE(logger, period_ms, ...) \
+  AUTOWARE_ASYNC_LOG_THROTTLE(logger, RCUTILS_LOG_SEVERITY_WARN, period_ms, __VA_ARGS__)
+#define AUTOWARE_ASYNC_ERROR_THROTTLE(logger, period_ms, ...) \
+  AUTOWARE_ASYNC_LOG_THROTTLE(logger, RCUTILS_LOG_SEVERITY_ERROR, period_ms, __VA_ARGS__)
+// NOLINTEND(cppcoreguidelines-macro-usage)
+
+#endif  // AUTOWARE__NODE__ASYNC_LOGGER_HPP_
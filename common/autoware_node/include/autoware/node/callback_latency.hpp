@@ -0,0 +1,109 @@
+// Copyright 2024 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__NODE__CALLBACK_LATENCY_HPP_
+#define AUTOWARE__NODE__CALLBACK_LATENCY_HPP_
+
+#include "autoware/node/latency_histogram.hpp"
+#include "autoware/node/visibility_control.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace autoware::node
+{
+
+struct CallbackLatencyStatistics
+{
+  explicit CallbackLatencyStatistics(std::string name) : name(std::move(name)) {}
+
+  const std::string name;
+  LatencyHistogram execution_time;
+  // time from the arrival of the message or the scheduled time of the timer to the callback start
+  LatencyHistogram queueing_delay;
+};
+
+struct CallbackLatencySnapshot
+{
+  std::string name;
+  LatencyHistogramSnapshot execution_time;
+  LatencyHistogramSnapshot queueing_delay;
+};
+
+/**
+ * @brief Collects the latency statistics of the callbacks of a node.
+ *
+ * Registration takes a lock, but recording only touches the atomics of the statistics.
+ */
+class CallbackLatencyMonitor
+{
+public:
+  AUTOWARE_NODE_PUBLIC std::shared_ptr<CallbackLatencyStatistics> add(const std::string & name);
+  AUTOWARE_NODE_PUBLIC std::vector<CallbackLatencySnapshot> snapshot() const;
+  AUTOWARE_NODE_PUBLIC void reset();
+
+  void set_enabled(const bool enabled) noexcept
+  {
+    enabled_.store(enabled, std::memory_order_relaxed);
+  }
+  bool is_enabled() const noexcept { return enabled_.load(std::memory_order_relaxed); }
+
+  // invokes the callback and records its execution time if enabled
+  template <typename CallbackT, typename... Args>
+  void invoke(CallbackLatencyStatistics & statistics, CallbackT & callback, Args &&... args) const
+  {
+    if (!is_enabled()) {
+      callback(std::forward<Args>(args)...);
+      return;
+    }
+    invoke_since(
+      std::chrono::steady_clock::now(), statistics, callback, std::forward<Args>(args)...);
+  }
+
+  // same as invoke, with the start time read by the caller, which saves a clock read when the
+  // caller also measures the queueing delay
+  template <typename CallbackT, typename... Args>
+  void invoke_since(
+    const std::chrono::steady_clock::time_point start, CallbackLatencyStatistics & statistics,
+    CallbackT & callback, Args &&... args) const
+  {
+    if (!is_enabled()) {
+      callback(std::forward<Args>(args)...);
+      return;
+    }
+    callback(std::forward<Args>(args)...);
+    const auto end = std::chrono::steady_clock::now();
+    statistics.execution_time.record(to_nanoseconds(end - start));
+  }
+
+  static uint64_t to_nanoseconds(const std::chrono::nanoseconds duration) noexcept
+  {
+    return duration.count() > 0 ? static_cast<uint64_t>(duration.count()) : 0;
+  }
+
+private:
+  std::atomic<bool> enabled_{true};
+  mutable std::mutex mutex_;
+  std::vector<std::shared_ptr<CallbackLatencyStatistics>> statistics_;
+};
+
+}  // namespace autoware::node
+
+#endif  // AUTOWARE__NODE__CALLBACK_LATENCY_HPP_
@@ -0,0 +1,394 @@
+// Copyright 2024 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__NODE__COROUTINE_HPP_
+#define AUTOWARE__NODE__COROUTINE_HPP_
+
+// the rest of the package is C++17, this header is for the nodes built as C++20
+#if !defined(__cpp_impl_coroutine)
+#error "autoware/node/coroutine.hpp requires C++20 coroutines"
+#endif
+
+#include "autoware/node/node.hpp"
+
+#include <rclcpp/rclcpp.hpp>
+
+#include <rcutils/logging_macros.h>
+
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace autoware::node
+{
+
+template <typename T = void>
+class Coroutine;
+
+namespace coroutine_detail
+{
+struct PromiseBase
+{
+  struct FinalAwaiter
+  {
+    bool await_ready() const noexcept { return false; }
+    template <typename PromiseT>
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<PromiseT> handle) noexcept
+    {
+      auto & promise = handle.promise();
+      if (promise.continuation) {
+        return promise.continuation;
+      }
+      if (promise.detached) {
+        handle.destroy();
+      }
+      return std::noop_coroutine();
+    }
+    void await_resume() const noexcept {}
+  };
+
+  std::suspend_always initial_suspend() const noexcept { return {}; }
+  FinalAwaiter final_suspend() const noexcept { return {}; }
+
+  void unhandled_exception()
+  {
+    if (!detached) {
+      exception = std::current_exception();
+      return;
+    }
+    try {
+      throw;
+    } catch (const std::exception & e) {
+      RCUTILS_LOG_ERROR_NAMED("autoware_node", "Spawned coroutine threw: %s", e.what());
+    } catch (...) {
+      RCUTILS_LOG_ERROR_NAMED("autoware_node", "Spawned coroutine threw.");
+    }
+  }
+
+  void rethrow_if_failed() const
+  {
+    if (exception) {
+      std::rethrow_exception(exception);
+    }
+  }
+
+  std::coroutine_handle<> continuation;
+  bool detached{false};
+  std::exception_ptr exception;
+};
+
+template <typename T>
+struct Promise : PromiseBase
+{
+  Coroutine<T> get_return_object();
+  template <typename U>
+  void return_value(U && result)
+  {
+    value.emplace(std::forward<U>(result));
+  }
+  T take_result()
+  {
+    rethrow_if_failed();
+    return std::move(*value);
+  }
+
+  std::optional<T> value;
+};
+
+template <>
+struct Promise<void> : PromiseBase
+{
+  Coroutine<void> get_return_object();
+  void return_void() const noexcept {}
+  void take_result() const { rethrow_if_failed(); }
+};
+
+/**
+ * @brief State shared by an awaitable and the callbacks which may complete it. The first callback
+ * completing it resumes the coroutine, and the callbacks of an abandoned coroutine do nothing.
+ */
+template <typename ResultT>
+struct AwaitState
+{
+  bool complete(ResultT value)
+  {
+    if (completed.exchange(true)) {
+      return false;
+    }
+    result = std::move(value);
+    std::vector<std::shared_ptr<void>> released;
+    {
+      // the entities are destroyed before the coroutine can create the next ones
+      std::lock_guard<std::mutex> lock(mutex);
+      released.swap(entities);
+    }
+    released.clear();
+    handle.resume();
+    return true;
+  }
+
+  void keep(std::shared_ptr<void> entity)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!completed) {
+      entities.push_back(std::move(entity));
+    }
+  }
+
+  std::atomic<bool> completed{false};
+  std::coroutine_handle<> handle;
+  ResultT result{};
+  std::mutex mutex;
+  // timers and subscriptions alive until the completion
+  std::vector<std::shared_ptr<void>> entities;
+};
+
+// one-shot timer completing the state with a default result
+template <typename ResultT>
+void add_timeout(
+  Node & node, std::shared_ptr<AwaitState<ResultT>> state, const std::chrono::nanoseconds timeout)
+{
+  std::weak_ptr<AwaitState<ResultT>> weak_state = state;
+  state->keep(node.create_wall_timer(timeout, [weak_state](rclcpp::TimerBase & timer) {
+    timer.cancel();
+    if (const auto locked_state = weak_state.lock()) {
+      locked_state->complete(ResultT{});
+    }
+  }));
+}
+
+template <typename ResultT>
+class Awaitable
+{
+public:
+  explicit Awaitable(std::shared_ptr<AwaitState<ResultT>> state) : state_(std::move(state)) {}
+
+  bool await_ready() const noexcept { return false; }
+  ResultT await_resume() { return std::move(state_->result); }
+
+protected:
+  std::shared_ptr<AwaitState<ResultT>> state_;
+};
+}  // namespace coroutine_detail
+
+/**
+ * @brief Coroutine of the callbacks of a node. It starts when it is awaited by another coroutine
+ * or spawned.
+ */
+template <typename T>
+class [[nodiscard]] Coroutine
+{
+public:
+  using promise_type = coroutine_detail::Promise<T>;
+
+  explicit Coroutine(std::coroutine_handle<promise_type> handle) : handle_(handle) {}
+  Coroutine(Coroutine && other) noexcept : handle_(std::exchange(other.handle_, {})) {}
+  Coroutine & operator=(Coroutine && other) noexcept
+  {
+    if (this != &other) {
+      if (handle_) {
+        handle_.destroy();
+      }
+      handle_ = std::exchange(other.handle_, {});
+    }
+    return *this;
+  }
+  ~Coroutine()
+  {
+    if (handle_) {
+      handle_.destroy();
+    }
+  }
+
+  bool await_ready() const noexcept { return false; }
+  std::coroutine_handle<> await_suspend(std::coroutine_handle<> continuation) noexcept
+  {
+    handle_.promise().continuation = continuation;
+    return handle_;
+  }
+  T await_resume() { return handle_.promise().take_result(); }
+
+  // runs the coroutine until its first suspension, and frees it once it finishes
+  friend void spawn(Coroutine<void> && coroutine);
+
+private:
+  std::coroutine_handle<promise_type> handle_;
+};
+
+template <typename T>
+Coroutine<T> coroutine_detail::Promise<T>::get_return_object()
+{
+  return Coroutine<T>(std::coroutine_handle<Promise<T>>::from_promise(*this));
+}
+
+inline Coroutine<void> coroutine_detail::Promise<void>::get_return_object()
+{
+  return Coroutine<void>(std::coroutine_handle<Promise<void>>::from_promise(*this));
+}
+
+inline void spawn(Coroutine<void> && coroutine)
+{
+  const auto handle = std::exchange(coroutine.handle_, {});
+  handle.promise().detached = true;
+  handle.resume();
+}
+
+/**
+ * @brief Wait for the duration on a one-shot timer of the node, in its default callback group.
+ */
+inline auto async_sleep(Node & node, const std::chrono::nanoseconds duration)
+{
+  using State = coroutine_detail::AwaitState<bool>;
+  struct SleepAwaitable : coroutine_detail::Awaitable<bool>
+  {
+    SleepAwaitable(Node & node, const std::chrono::nanoseconds duration)
+    : Awaitable(std::make_shared<State>()), node(node), duration(duration)
+    {
+    }
+    void await_suspend(std::coroutine_handle<> handle)
+    {
+      state_->handle = handle;
+      coroutine_detail::add_timeout(node, state_, duration);
+    }
+    void await_resume() const noexcept {}
+
+    Node & node;
+    std::chrono::nanoseconds duration;
+  };
+  return SleepAwaitable(node, duration);
+}
+
+/**
+ * @brief Send the request and wait for the response without blocking the executor, so that a
+ * single-threaded executor keeps running the other callbacks, including the response callback of
+ * the client.
+ * @return response, or nullptr if the timeout (0 for none) expired first
+ */
+template <typename ServiceT>
+auto async_call(
+  Node & node, const typename rclcpp::Client<ServiceT>::SharedPtr & client,
+  typename ServiceT::Request::SharedPtr request,
+  const std::chrono::nanoseconds timeout = std::chrono::nanoseconds(0))
+{
+  using ResponseT = typename rclcpp::Client<ServiceT>::SharedResponse;
+  using State = coroutine_detail::AwaitState<ResponseT>;
+  struct CallAwaitable : coroutine_detail::Awaitable<ResponseT>
+  {
+    CallAwaitable(
+      Node & node, typename rclcpp::Client<ServiceT>::SharedPtr client,
+      typename ServiceT::Request::SharedPtr request, const std::chrono::nanoseconds timeout)
+    : coroutine_detail::Awaitable<ResponseT>(std::make_shared<State>()),
+      node(node),
+      client(std::move(client)),
+      request(std::move(request)),
+      timeout(timeout)
+    {
+    }
+
+    void await_suspend(std::coroutine_handle<> handle)
+    {
+      // the callbacks may resume the coroutine and destroy `this` from another thread
+      auto state = this->state_;
+      auto client = this->client;
+      auto request = std::move(this->request);
+      const auto timeout = this->timeout;
+      state->handle = handle;
+      if (timeout.count() > 0) {
+        coroutine_detail::add_timeout(node, state, timeout);
+      }
+      std::weak_ptr<State> weak_state = state;
+      const auto sent = client->async_send_request(
+        std::move(request), [weak_state](typename rclcpp::Client<ServiceT>::SharedFuture future) {
+          if (const auto locked_state = weak_state.lock()) {
+            locked_state->complete(future.get());
+          }
+        });
+      // otherwise, the client would keep the expired requests until the server responds
+      if (timeout.count() > 0) {
+        state->keep(std::shared_ptr<void>(nullptr, [client, request_id = sent.request_id](void *) {
+          client->remove_pending_request(request_id);
+        }));
+      }
+    }
+
+    Node & node;
+    typename rclcpp::Client<ServiceT>::SharedPtr client;
+    typename ServiceT::Request::SharedPtr request;
+    std::chrono::nanoseconds timeout;
+  };
+  return CallAwaitable(node, client, std::move(request), timeout);
+}
+
+/**
+ * @brief Wait for the next message on the topic with a temporary subscription of the node.
+ * @return message, or nullptr if the timeout (0 for none) expired first
+ */
+template <typename MessageT>
+auto async_wait_for_message(
+  Node & node, const std::string & topic_name, const rclcpp::QoS & qos,
+  const std::chrono::nanoseconds timeout = std::chrono::nanoseconds(0))
+{
+  using State = coroutine_detail::AwaitState<typename MessageT::ConstSharedPtr>;
+  struct MessageAwaitable : coroutine_detail::Awaitable<typename MessageT::ConstSharedPtr>
+  {
+    MessageAwaitable(
+      Node & node, const std::string & topic_name, const rclcpp::QoS & qos,
+      const std::chrono::nanoseconds timeout)
+    : coroutine_detail::Awaitable<typename MessageT::ConstSharedPtr>(std::make_shared<State>()),
+      node(node),
+      topic_name(topic_name),
+      qos(qos),
+      timeout(timeout)
+    {
+    }
+
+    void await_suspend(std::coroutine_handle<> handle)
+    {
+      auto state = this->state_;
+      auto & node = this->node;
+      const auto topic_name = this->topic_name;
+      const auto qos = this->qos;
+      const auto timeout = this->timeout;
+      state->handle = handle;
+      std::weak_ptr<State> weak_state = state;
+      auto subscription = node.template create_subscription<MessageT>(
+        topic_name, qos, [weak_state](typename MessageT::ConstSharedPtr message) {
+          if (const auto locked_state = weak_state.lock()) {
+            locked_state->complete(std::move(message));
+          }
+        });
+      if (timeout.count() > 0) {
+        coroutine_detail::add_timeout(node, state, timeout);
+      }
+      state->keep(std::move(subscription));
+    }
+
+    Node & node;
+    std::string topic_name;
+    rclcpp::QoS qos;
+    std::chrono::nanoseconds timeout;
+  };
+  return MessageAwaitable(node, topic_name, qos, timeout);
+}
+
+}  // namespace autoware::node
+
+#endif  // AUTOWARE__NODE__COROUTINE_HPP_
@@ -0,0 +1,284 @@
+// Copyright 2024 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__NODE__FLIGHT_RECORDER_HPP_
+#define AUTOWARE__NODE__FLIGHT_RECORDER_HPP_
+
+#include "autoware/node/visibility_control.hpp"
+
+#include <rclcpp/rclcpp.hpp>
+#include <rclcpp/serialization.hpp>
+#include <rcpputils/shared_library.hpp>
+#include <rosidl_runtime_cpp/traits.hpp>
+#include <rosidl_typesupport_cpp/message_type_support.hpp>
+
+#include <rosidl_runtime_c/message_type_support_struct.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace autoware::node
+{
+
+struct FlightRecord
+{
+  int64_t time{0};  // [ns] since the epoch of the system clock, when the message was received
+  size_t size{0};   // [byte] estimated memory held by the message
+  std::shared_ptr<const void> message;
+};
+
+/**
+ * @brief Preallocated ring of the last messages received on a topic.
+ *
+ * Only the shared pointers to the messages are kept, so recording does not copy the messages, but
+ * keeps up to max_messages of them alive, and at most max_bytes of them (0 for no limit) except
+ * the last one. They are serialized when a snapshot is written.
+ */
+class FlightRecorderTopic
+{
+public:
+  FlightRecorderTopic(
+    std::string topic_name, std::string type_name, const size_t max_messages,
+    const size_t max_bytes = 0)
+  : topic_name_(std::move(topic_name)),
+    type_name_(std::move(type_name)),
+    max_bytes_(max_bytes),
+    records_(std::max<size_t>(max_messages, 1))
+  {
+  }
+  virtual ~FlightRecorderTopic() = default;
+
+  void record(std::shared_ptr<const void> message, const int64_t time, const size_t size = 0)
+  {
+    std::shared_ptr<const void> released;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (size_ == records_.size()) {
+        evict(released);
+      }
+      FlightRecord & record = records_[(first_index_ + size_) % records_.size()];
+      record.time = time;
+      record.size = size;
+      record.message.swap(message);
+      ++size_;
+      total_bytes_ += size;
+      while (max_bytes_ > 0 && total_bytes_ > max_bytes_ && size_ > 1) {
+        evict(released);
+      }
+    }
+    // the first released message is freed after the lock
+  }
+
+  // records received since the given time, oldest first
+  AUTOWARE_NODE_PUBLIC std::vector<FlightRecord> get_records(const int64_t since) const;
+
+  virtual void serialize(const void * message, rclcpp::SerializedMessage & serialized) const = 0;
+
+  const std::string & get_topic_name() const { return topic_name_; }
+  const std::string & get_type_name() const { return type_name_; }
+  size_t get_capacity() const { return records_.size(); }
+  size_t get_max_bytes() const { return max_bytes_; }
+  size_t get_total_bytes() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return total_bytes_;
+  }
+
+protected:
+  // introspection type support of a message type, or nullptr if it is not available
+  AUTOWARE_NODE_PUBLIC static const rosidl_message_type_support_t * get_introspection(
+    const rosidl_message_type_support_t * type_support);
+  // [byte] memory held by the sequences and strings of a message, without serializing it
+  AUTOWARE_NODE_PUBLIC static size_t get_dynamic_size(
+    const void * message, const rosidl_message_type_support_t * introspection);
+
+private:
+  void evict(std::shared_ptr<const void> & released)
+  {
+    FlightRecord & record = records_[first_index_];
+    if (released) {
+      record.message.reset();
+    } else {
+      released.swap(record.message);
+    }
+    total_bytes_ -= record.size;
+    first_index_ = (first_index_ + 1) % records_.size();
+    --size_;
+  }
+
+  const std::string topic_name_;
+  const std::string type_name_;
+  const size_t max_bytes_;
+  mutable std::mutex mutex_;
+  std::vector<FlightRecord> records_;
+  size_t first_index_{0};
+  size_t size_{0};
+  size_t total_bytes_{0};
+};
+
+template <typename MessageT>
+class TypedFlightRecorderTopic : public FlightRecorderTopic
+{
+public:
+  TypedFlightRecorderTopic(
+    std::string topic_name, const size_t max_messages, const size_t max_bytes = 0)
+  : FlightRecorderTopic(
+      std::move(topic_name), rosidl_generator_traits::name<MessageT>(), max_messages, max_bytes),
+    introspection_(
+      get_introspection(rosidl_typesupport_cpp::get_message_type_support_handle<MessageT>()))
+  {
+  }
+
+  void record(const std::shared_ptr<const MessageT> & message, const int64_t time)
+  {
+    const size_t size = get_max_bytes() > 0 ? estimate_size(*message) : 0;
+    if (copy_messages_.load(std::memory_order_relaxed)) {
+      FlightRecorderTopic::record(std::make_shared<const MessageT>(*message), time, size);
+    } else {
+      FlightRecorderTopic::record(message, time, size);
+    }
+  }
+
+  /**
+   * @brief Copy the messages instead of keeping the received ones.
+   *
+   * Loaned messages are returned to the middleware after the callback, so the subscriptions which
+   * can loan messages must not keep them.
+   */
+  void set_copy_messages(const bool copy_messages)
+  {
+    copy_messages_.store(copy_messages, std::memory_order_relaxed);
+  }
+  bool get_copy_messages() const { return copy_messages_.load(std::memory_order_relaxed); }
+
+  void serialize(const void * message, rclcpp::SerializedMessage & serialized) const override
+  {
+    serialization_.serialize_message(static_cast<const MessageT *>(message), &serialized);
+  }
+
+private:
+  // the estimate walks the sequences of the message, as serializing it would cost as much as
+  // copying it in the callback
+  size_t estimate_size(const MessageT & message) const
+  {
+    return sizeof(MessageT) + (introspection_ ? get_dynamic_size(&message, introspection_) : 0);
+  }
+
+  const rosidl_message_type_support_t * const introspection_;
+  rclcpp::Serialization<MessageT> serialization_;
+  std::atomic<bool> copy_messages_{false};
+};
+
+/**
+ * @brief Writes the messages of a snapshot to a bag.
+ *
+ * The rosbag2 implementation lives in the autoware_node_flight_recorder package, which is loaded
+ * on demand so that nodes without a flight recorder do not depend on rosbag2.
+ */
+class FlightRecorderWriter
+{
+public:
+  virtual ~FlightRecorderWriter() = default;
+
+  virtual void open(const std::string & path) = 0;
+  virtual void create_topic(const std::string & topic_name, const std::string & type_name) = 0;
+  virtual void write(
+    const rclcpp::SerializedMessage & message, const std::string & topic_name,
+    const std::string & type_name, const int64_t time) = 0;
+};
+
+/**
+ * @brief Keeps the last messages of the recorded subscriptions of a node, and writes them to a
+ * rosbag2 bag on demand.
+ *
+ * snapshot() only copies the pointers to the messages of the last `duration`, and a background
+ * thread serializes and writes them with the writer of the autoware_node_flight_recorder library.
+ * The snapshots fail with an error if the library cannot be loaded.
+ */
+class FlightRecorder
+{
+public:
+  AUTOWARE_NODE_PUBLIC FlightRecorder(
+    std::string node_name, std::string directory, const std::chrono::nanoseconds duration,
+    const rclcpp::Logger & logger);
+  AUTOWARE_NODE_PUBLIC ~FlightRecorder();
+
+  FlightRecorder(const FlightRecorder &) = delete;
+  FlightRecorder & operator=(const FlightRecorder &) = delete;
+
+  template <typename MessageT>
+  std::shared_ptr<TypedFlightRecorderTopic<MessageT>> add_topic(
+    const std::string & topic_name, const size_t max_messages, const size_t max_bytes = 0)
+  {
+    auto topic =
+      std::make_shared<TypedFlightRecorderTopic<MessageT>>(topic_name, max_messages, max_bytes);
+    std::lock_guard<std::mutex> lock(mutex_);
+    topics_.push_back(topic);
+    return topic;
+  }
+
+  // returns the path of the bag which will be written
+  AUTOWARE_NODE_PUBLIC std::string snapshot(const std::string & reason);
+  // blocks until the requested snapshots are written
+  AUTOWARE_NODE_PUBLIC void wait_for_snapshots();
+
+  static int64_t now()
+  {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::system_clock::now().time_since_epoch())
+      .count();
+  }
+
+private:
+  struct Snapshot
+  {
+    std::string path;
+    std::vector<std::pair<std::shared_ptr<FlightRecorderTopic>, std::vector<FlightRecord>>> topics;
+  };
+
+  using CreateWriter = FlightRecorderWriter * (*)();
+
+  void run();
+  void write(const Snapshot & snapshot) const;
+
+  const std::string node_name_;
+  const std::string directory_;
+  const std::chrono::nanoseconds duration_;
+  const rclcpp::Logger logger_;
+  std::shared_ptr<rcpputils::SharedLibrary> writer_library_;
+  CreateWriter create_writer_{nullptr};
+
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  std::vector<std::shared_ptr<FlightRecorderTopic>> topics_;
+  std::deque<Snapshot> snapshots_;
+  bool writing_{false};
+  bool stop_requested_{false};
+  uint64_t snapshot_count_{0};
+  std::thread thread_;
+};
+
+}  // namespace autoware::node
+
+#endif  // AUTOWARE__NODE__FLIGHT_RECORDER_HPP_
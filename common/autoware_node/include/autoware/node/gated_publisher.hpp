@@ -0,0 +1,131 @@
+// Copyright 2024 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__NODE__GATED_PUBLISHER_HPP_
+#define AUTOWARE__NODE__GATED_PUBLISHER_HPP_
+
+#include <rclcpp/rclcpp.hpp>
+#include <rclcpp_lifecycle/lifecycle_publisher.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace autoware::node
+{
+
+/**
+ * @brief Lifecycle publisher telling cheaply whether a message would be delivered at all, so that
+ * expensive messages are only built when the publisher is active and has subscriptions.
+ *
+ * The subscription count is cached and only queried again after a graph event of the node, which
+ * the graph listener thread of the context raises, and once more graph_recheck_delay later, as
+ * DDS matches the endpoints asynchronously and may not count a new subscription yet on the event.
+ * Publishers with a transient local durability are not gated by the count, as late subscriptions
+ * still receive their messages.
+ */
+template <typename MessageT>
+class GatedPublisher
+{
+public:
+  using SharedPtr = std::shared_ptr<GatedPublisher<MessageT>>;
+  using PublisherT = rclcpp_lifecycle::LifecyclePublisher<MessageT>;
+
+  static constexpr std::chrono::milliseconds graph_recheck_delay{100};
+
+  GatedPublisher(std::shared_ptr<PublisherT> publisher, rclcpp::Event::SharedPtr graph_event)
+  : publisher_(std::move(publisher)),
+    graph_event_(std::move(graph_event)),
+    latched_(
+      publisher_->get_actual_qos().durability() == rclcpp::DurabilityPolicy::TransientLocal)
+  {
+    update_subscription_count();
+  }
+
+  bool should_publish()
+  {
+    if (!publisher_->is_activated()) {
+      return false;
+    }
+    if (latched_) {
+      return true;
+    }
+    if (graph_event_->check() && graph_event_->check_and_clear()) {
+      update_subscription_count();
+      recheck_time_.store(
+        now() + std::chrono::nanoseconds(graph_recheck_delay).count(), std::memory_order_relaxed);
+    } else if (const int64_t recheck_time = recheck_time_.load(std::memory_order_relaxed)) {
+      // the clock is only read while a recheck is pending
+      if (now() >= recheck_time && recheck_time_.exchange(0, std::memory_order_relaxed) != 0) {
+        update_subscription_count();
+      }
+    }
+    return subscription_count_.load(std::memory_order_relaxed) > 0;
+  }
+
+  /**
+   * @brief Publish the message returned by `factory()`, a MessageT or a std::unique_ptr<MessageT>,
+   * only if should_publish() is true.
+   * @return whether the message was built and published
+   */
+  template <
+    typename FactoryT, typename = std::enable_if_t<std::is_invocable_v<std::decay_t<FactoryT> &>>>
+  bool publish(FactoryT && factory)
+  {
+    if (!should_publish()) {
+      skipped_count_.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+    publisher_->publish(factory());
+    return true;
+  }
+
+  void publish(std::unique_ptr<MessageT> message) { publisher_->publish(std::move(message)); }
+  void publish(const MessageT & message) { publisher_->publish(message); }
+
+  size_t get_subscription_count() const
+  {
+    return subscription_count_.load(std::memory_order_relaxed);
+  }
+  // number of messages which were not built by publish(factory)
+  uint64_t get_skipped_count() const { return skipped_count_.load(std::memory_order_relaxed); }
+  const std::shared_ptr<PublisherT> & get_publisher() const { return publisher_; }
+
+private:
+  static int64_t now()
+  {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+  }
+
+  void update_subscription_count()
+  {
+    subscription_count_.store(publisher_->get_subscription_count(), std::memory_order_relaxed);
+  }
+
+  std::shared_ptr<PublisherT> publisher_;
+  rclcpp::Event::SharedPtr graph_event_;
+  const bool latched_;
+  std::atomic<size_t> subscription_count_{0};
+  std::atomic<int64_t> recheck_time_{0};  // [ns] of the steady clock, 0 if none is pending
+  std::atomic<uint64_t> skipped_count_{0};
+};
+
+}  // namespace autoware::node
+
+#endif  // AUTOWARE__NODE__GATED_PUBLISHER_HPP_
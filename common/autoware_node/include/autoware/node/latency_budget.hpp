@@ -0,0 +1,229 @@
+// Copyright 2024 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__NODE__LATENCY_BUDGET_HPP_
+#define AUTOWARE__NODE__LATENCY_BUDGET_HPP_
+
+#include "autoware/node/latency_histogram.hpp"
+#include "autoware/node/visibility_control.hpp"
+
+#include <rclcpp/rclcpp.hpp>
+#include <rclcpp_lifecycle/lifecycle_publisher.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace autoware::node
+{
+
+namespace latency_budget_detail
+{
+template <typename T, typename = void>
+struct has_header_stamp : std::false_type
+{
+};
+template <typename T>
+struct has_header_stamp<T, std::void_t<decltype(std::declval<const T &>().header.stamp.nanosec)>>
+: std::true_type
+{
+};
+}  // namespace latency_budget_detail
+
+// origin of the data of a message, the stamp of its header, or 0 if it has no header [ns]
+template <typename MessageT>
+int64_t get_origin_time(const MessageT & message)
+{
+  if constexpr (latency_budget_detail::has_header_stamp<MessageT>::value) {
+    return static_cast<int64_t>(message.header.stamp.sec) * 1000000000 +
+           static_cast<int64_t>(message.header.stamp.nanosec);
+  } else {
+    return 0;
+  }
+}
+
+struct LatencyBudgetStatistics
+{
+  LatencyBudgetStatistics(std::string name, const int64_t budget)
+  : name(std::move(name)), budget(budget)
+  {
+  }
+
+  const std::string name;
+  const int64_t budget;  // [ns] of the cumulative latency, 0 for none
+  // inputs: from the publication, outputs: from the start of the input callback
+  LatencyHistogram hop_latency;
+  // from the origin of the data
+  LatencyHistogram cumulative_latency;
+  std::atomic<uint64_t> overrun_count{0};
+};
+
+struct LatencyBudgetSnapshot
+{
+  std::string name;
+  int64_t budget{0};  // [ns]
+  LatencyHistogramSnapshot hop_latency;
+  LatencyHistogramSnapshot cumulative_latency;
+  uint64_t overrun_count{0};
+};
+
+/**
+ * @brief Measures the latency of the inputs and outputs of a node from the origin of their data.
+ *
+ * The origin is the header stamp of the messages. The monitored subscriptions fall back to the
+ * publication time for messages without header, and pass the origin of the input to the outputs
+ * published from their callbacks through a thread-local context, so that messages without header
+ * are attributed as well. Recording costs a clock read and a few relaxed atomic operations.
+ *
+ * The latencies are measured with the clock of the node, the clock of the header stamps, so that
+ * they stay meaningful under simulated time, e.g. when replaying a bag. The publication times of
+ * the middleware are system times, so they are not used under simulated time.
+ */
+class LatencyBudgetMonitor
+{
+public:
+  // the system clock is used without a clock
+  explicit LatencyBudgetMonitor(rclcpp::Clock::SharedPtr clock = nullptr)
+  : clock_(std::move(clock))
+  {
+  }
+
+  // sets the origin and the start of the input callback of the current thread
+  class OriginScope
+  {
+  public:
+    AUTOWARE_NODE_PUBLIC OriginScope(const int64_t origin, const int64_t start) noexcept;
+    AUTOWARE_NODE_PUBLIC ~OriginScope();
+
+    OriginScope(const OriginScope &) = delete;
+    OriginScope & operator=(const OriginScope &) = delete;
+
+  private:
+    int64_t previous_origin_;
+    int64_t previous_start_;
+  };
+
+  AUTOWARE_NODE_PUBLIC std::shared_ptr<LatencyBudgetStatistics> add(
+    const std::string & name, const int64_t budget);
+  AUTOWARE_NODE_PUBLIC std::vector<LatencyBudgetSnapshot> snapshot() const;
+
+  void set_enabled(const bool enabled) noexcept
+  {
+    enabled_.store(enabled, std::memory_order_relaxed);
+  }
+  bool is_enabled() const noexcept { return enabled_.load(std::memory_order_relaxed); }
+
+  // a value of 0 for the origin or the start of the hop is not recorded
+  static void record(
+    LatencyBudgetStatistics & statistics, const int64_t origin, const int64_t hop_start,
+    const int64_t now) noexcept
+  {
+    if (hop_start > 0) {
+      statistics.hop_latency.record(now > hop_start ? static_cast<uint64_t>(now - hop_start) : 0);
+    }
+    if (origin > 0) {
+      const int64_t latency = now - origin;
+      statistics.cumulative_latency.record(latency > 0 ? static_cast<uint64_t>(latency) : 0);
+      if (statistics.budget > 0 && latency > statistics.budget) {
+        statistics.overrun_count.fetch_add(1, std::memory_order_relaxed);
+      }
+    }
+  }
+
+  // time of the clock of the header stamps [ns]
+  int64_t now() const
+  {
+    if (clock_) {
+      return clock_->now().nanoseconds();
+    }
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::system_clock::now().time_since_epoch())
+      .count();
+  }
+  // whether the clock is simulated, so that the publication times are not comparable with it
+  bool is_sim_time() const { return clock_ && clock_->ros_time_is_active(); }
+  AUTOWARE_NODE_PUBLIC static int64_t get_current_origin() noexcept;
+  AUTOWARE_NODE_PUBLIC static int64_t get_current_start() noexcept;
+
+private:
+  const rclcpp::Clock::SharedPtr clock_;
+  std::atomic<bool> enabled_{true};
+  mutable std::mutex mutex_;
+  std::vector<std::shared_ptr<LatencyBudgetStatistics>> statistics_;
+};
+
+/**
+ * @brief Lifecycle publisher recording the latency of the published messages from their origin,
+ * and from the start of the input callback publishing them.
+ */
+template <typename MessageT>
+class MonitoredPublisher
+{
+public:
+  using SharedPtr = std::shared_ptr<MonitoredPublisher<MessageT>>;
+  using PublisherT = rclcpp_lifecycle::LifecyclePublisher<MessageT>;
+
+  MonitoredPublisher(
+    std::shared_ptr<PublisherT> publisher, std::shared_ptr<LatencyBudgetMonitor> monitor,
+    std::shared_ptr<LatencyBudgetStatistics> statistics)
+  : publisher_(std::move(publisher)),
+    monitor_(std::move(monitor)),
+    statistics_(std::move(statistics))
+  {
+  }
+
+  void publish(std::unique_ptr<MessageT> message)
+  {
+    record(*message);
+    publisher_->publish(std::move(message));
+  }
+
+  void publish(const MessageT & message)
+  {
+    record(message);
+    publisher_->publish(message);
+  }
+
+  bool is_activated() const { return publisher_->is_activated(); }
+  const std::shared_ptr<PublisherT> & get_publisher() const { return publisher_; }
+  const std::shared_ptr<LatencyBudgetStatistics> & get_statistics() const { return statistics_; }
+
+private:
+  void record(const MessageT & message)
+  {
+    if (!monitor_->is_enabled() || !publisher_->is_activated()) {
+      return;
+    }
+    int64_t origin = get_origin_time(message);
+    if (origin == 0) {
+      origin = LatencyBudgetMonitor::get_current_origin();
+    }
+    LatencyBudgetMonitor::record(
+      *statistics_, origin, LatencyBudgetMonitor::get_current_start(), monitor_->now());
+  }
+
+  std::shared_ptr<PublisherT> publisher_;
+  std::shared_ptr<LatencyBudgetMonitor> monitor_;
+  std::shared_ptr<LatencyBudgetStatistics> statistics_;
+};
+
+}  // namespace autoware::node
+
+#endif  // AUTOWARE__NODE__LATENCY_BUDGET_HPP_
@@ -0,0 +1,73 @@
+// Copyright 2024 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__NODE__LATENCY_HISTOGRAM_HPP_
+#define AUTOWARE__NODE__LATENCY_HISTOGRAM_HPP_
+
+#include "autoware/node/visibility_control.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace autoware::node
+{
+
+struct LatencyHistogramSnapshot
+{
+  uint64_t count{0};
+  uint64_t min{0};  // [ns]
+  uint64_t max{0};  // [ns]
+  double mean{0.0};  // [ns]
+  std::vector<uint64_t> bucket_counts;
+
+  // upper bound of the bucket containing the given percentile in [0, 100]
+  AUTOWARE_NODE_PUBLIC uint64_t percentile(const double percentile) const;
+};
+
+/**
+ * @brief Lock-free histogram of latencies in nanoseconds with HDR-style log-linear buckets.
+ *
+ * Every power of two is divided into 16 linear sub-buckets, so the relative error of the recorded
+ * values is below 6.25 %. Values from 2^40 ns (about 18 minutes) are saturated. record() only
+ * performs relaxed atomic operations and can be called from any thread.
+ */
+class LatencyHistogram
+{
+public:
+  static constexpr uint32_t sub_bucket_bits = 4;
+  static constexpr uint32_t max_magnitude = 40;
+  static constexpr std::size_t num_buckets = (max_magnitude - sub_bucket_bits + 1)
+                                             << sub_bucket_bits;
+
+  AUTOWARE_NODE_PUBLIC void record(const uint64_t value) noexcept;
+  AUTOWARE_NODE_PUBLIC LatencyHistogramSnapshot snapshot() const;
+  AUTOWARE_NODE_PUBLIC void reset() noexcept;
+
+  AUTOWARE_NODE_PUBLIC static std::size_t to_bucket_index(const uint64_t value) noexcept;
+  AUTOWARE_NODE_PUBLIC static uint64_t to_bucket_upper_bound(const std::size_t index) noexcept;
+
+private:
+  std::array<std::atomic<uint64_t>, num_buckets> bucket_counts_{};
+  std::atomic<uint64_t> count_{0};
+  std::atomic<uint64_t> sum_{0};
+  std::atomic<uint64_t> min_{UINT64_MAX};
+  std::atomic<uint64_t> max_{0};
+};
+
+}  // namespace autoware::node
+
+#endif  // AUTOWARE__NODE__LATENCY_HISTOGRAM_HPP_
@@ -0,0 +1,178 @@
+// Copyright 2024 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__NODE__LAZY_SUBSCRIPTION_HPP_
+#define AUTOWARE__NODE__LAZY_SUBSCRIPTION_HPP_
+
+#include <rclcpp/rclcpp.hpp>
+#include <rclcpp/waitable.hpp>
+
+#include <rcl/wait.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace autoware::node
+{
+
+class LazySubscriptionBase
+{
+public:
+  virtual ~LazySubscriptionBase() = default;
+
+  /**
+   * @brief Called by the node when its graph changes, and at the time returned by the previous
+   * call.
+   * @return time of the next update, i.e. of the recheck of the demand after a graph event, or of
+   * the release of the subscription if no demand appears until then
+   */
+  virtual std::optional<std::chrono::steady_clock::time_point> update(
+    bool graph_changed, std::chrono::steady_clock::time_point now) = 0;
+};
+
+/**
+ * @brief Waitable running a callback on the executor of a node when its graph changes.
+ *
+ * The graph listener of the process triggers the notify guard condition of the node after setting
+ * its graph events, which wakes up the executors of the node, so the waitable does not add any
+ * entity of its own to the wait set and only checks the event. Unlike the graph guard condition,
+ * the notify guard condition can be waited on by several wait sets.
+ */
+class GraphChangeWaitable : public rclcpp::Waitable
+{
+public:
+  GraphChangeWaitable(rclcpp::Event::SharedPtr graph_event, std::function<void()> callback)
+  : graph_event_(std::move(graph_event)), callback_(std::move(callback))
+  {
+  }
+
+  void add_to_wait_set(rcl_wait_set_t * /*wait_set*/) override {}
+  bool is_ready(rcl_wait_set_t * /*wait_set*/) override { return graph_event_->check(); }
+  std::shared_ptr<void> take_data() override { return nullptr; }
+  void execute(std::shared_ptr<void> & /*data*/) override
+  {
+    if (graph_event_->check_and_clear()) {
+      callback_();
+    }
+  }
+
+private:
+  const rclcpp::Event::SharedPtr graph_event_;
+  const std::function<void()> callback_;
+};
+
+/**
+ * @brief Subscription which exists only while at least one of its output publishers has
+ * subscriptions.
+ *
+ * It is created as soon as the demand appears, and destroyed once no output has had subscriptions
+ * for the hysteresis period, so that short gaps of the downstream nodes do not churn it.
+ */
+template <typename MessageT>
+class LazySubscription : public LazySubscriptionBase
+{
+public:
+  using SharedPtr = std::shared_ptr<LazySubscription<MessageT>>;
+  using SubscriptionT = rclcpp::Subscription<MessageT>;
+  using FactoryT = std::function<typename SubscriptionT::SharedPtr()>;
+
+  LazySubscription(
+    FactoryT factory, std::vector<rclcpp::PublisherBase::SharedPtr> outputs,
+    const std::chrono::nanoseconds hysteresis)
+  : factory_(std::move(factory)), outputs_(std::move(outputs)), hysteresis_(hysteresis)
+  {
+  }
+
+  // DDS matches the endpoints asynchronously, so that the subscription count may not have changed
+  // yet on a graph event, and is counted again after this delay
+  static constexpr std::chrono::milliseconds graph_recheck_delay{100};
+
+  std::optional<std::chrono::steady_clock::time_point> update(
+    const bool graph_changed, const std::chrono::steady_clock::time_point now) override
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const bool recheck = recheck_time_ && now >= *recheck_time_;
+    if (graph_changed || !updated_ || recheck) {
+      recheck_time_.reset();
+      if (graph_changed) {
+        recheck_time_ = now + graph_recheck_delay;
+      }
+      const bool had_demand = has_demand_;
+      has_demand_ = std::any_of(outputs_.begin(), outputs_.end(), [](const auto & output) {
+        return output->get_subscription_count() > 0;
+      });
+      if (had_demand && !has_demand_) {
+        demand_end_time_ = now;
+      }
+      updated_ = true;
+    }
+    if (has_demand_) {
+      if (!subscription_) {
+        subscription_ = factory_();
+        ++subscribe_count_;
+      }
+      return recheck_time_;
+    }
+    if (!subscription_) {
+      return recheck_time_;
+    }
+    if (now - demand_end_time_ >= hysteresis_) {
+      subscription_.reset();
+      return recheck_time_;
+    }
+    const auto release_time = demand_end_time_ + hysteresis_;
+    return recheck_time_ ? std::min(*recheck_time_, release_time) : release_time;
+  }
+
+  bool is_subscribed() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return subscription_ != nullptr;
+  }
+  typename SubscriptionT::SharedPtr get_subscription() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return subscription_;
+  }
+  // number of times the subscription was created
+  uint64_t get_subscribe_count() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return subscribe_count_;
+  }
+
+private:
+  const FactoryT factory_;
+  const std::vector<rclcpp::PublisherBase::SharedPtr> outputs_;
+  const std::chrono::nanoseconds hysteresis_;
+
+  mutable std::mutex mutex_;
+  typename SubscriptionT::SharedPtr subscription_;
+  bool updated_{false};
+  std::optional<std::chrono::steady_clock::time_point> recheck_time_;
+  bool has_demand_{false};
+  std::chrono::steady_clock::time_point demand_end_time_;
+  uint64_t subscribe_count_{0};
+};
+
+}  // namespace autoware::node
+
+#endif  // AUTOWARE__NODE__LAZY_SUBSCRIPTION_HPP_
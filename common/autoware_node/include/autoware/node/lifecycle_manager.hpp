@@ -0,0 +1,91 @@
+// Copyright 2024 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__NODE__LIFECYCLE_MANAGER_HPP_
+#define AUTOWARE__NODE__LIFECYCLE_MANAGER_HPP_
+
+#include "autoware/node/visibility_control.hpp"
+
+#include <rclcpp/rclcpp.hpp>
+
+#include <autoware_node_msgs/srv/change_node_state.hpp>
+#include <autoware_node_msgs/srv/get_node_states.hpp>
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace autoware::node
+{
+
+class Node;
+
+/**
+ * @brief Single lifecycle endpoint of a process, serving the transitions of the nodes registered
+ * with it instead of their own lifecycle services.
+ *
+ * The manager is created with the first node using it and destroyed with the last one. It serves
+ * `change_state` and `get_states` from a node named `lifecycle_manager_<pid>` in the
+ * `/autoware_node` namespace, spun by a thread of its own, on which the transitions run.
+ *
+ * The nodes are held by weak pointers, so that a node whose destruction has started is no longer
+ * found, and a node in transition is kept alive by the manager until the end of the transition.
+ */
+class LifecycleManager
+{
+public:
+  AUTOWARE_NODE_PUBLIC static std::shared_ptr<LifecycleManager> get_instance(
+    const rclcpp::Context::SharedPtr & context);
+  AUTOWARE_NODE_PUBLIC ~LifecycleManager();
+
+  LifecycleManager(const LifecycleManager &) = delete;
+  LifecycleManager & operator=(const LifecycleManager &) = delete;
+
+  // the node must be owned by a shared pointer
+  AUTOWARE_NODE_PUBLIC void add_node(const std::shared_ptr<Node> & node);
+  // removes the node, or the entries of the destroyed nodes with the same name
+  AUTOWARE_NODE_PUBLIC void remove_node(const Node & node);
+
+  AUTOWARE_NODE_PUBLIC std::string get_fully_qualified_name() const;
+
+private:
+  explicit LifecycleManager(const rclcpp::Context::SharedPtr & context);
+
+  void on_change_state(
+    const autoware_node_msgs::srv::ChangeNodeState::Request::SharedPtr request,
+    const autoware_node_msgs::srv::ChangeNodeState::Response::SharedPtr response);
+  void on_get_states(
+    const autoware_node_msgs::srv::GetNodeStates::Request::SharedPtr request,
+    const autoware_node_msgs::srv::GetNodeStates::Response::SharedPtr response);
+
+  rclcpp::Context::SharedPtr context_;
+  rclcpp::Node::SharedPtr node_;
+  rclcpp::Service<autoware_node_msgs::srv::ChangeNodeState>::SharedPtr change_state_service_;
+  rclcpp::Service<autoware_node_msgs::srv::GetNodeStates>::SharedPtr get_states_service_;
+  // shared with the thread, which outlives the manager if it destroys the last node
+  std::shared_ptr<rclcpp::executors::SingleThreadedExecutor> executor_;
+  std::shared_ptr<std::atomic<bool>> stop_requested_;
+  std::thread thread_;
+
+  // not held during the transitions, which may construct or destroy other nodes
+  std::mutex mutex_;
+  std::map<std::string, std::weak_ptr<Node>> nodes_;
+};
+
+}  // namespace autoware::node
+
+#endif  // AUTOWARE__NODE__LIFECYCLE_MANAGER_HPP_
@@ -0,0 +1,100 @@
+// Copyright 2024 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__NODE__LIFECYCLE_ORCHESTRATOR_HPP_
+#define AUTOWARE__NODE__LIFECYCLE_ORCHESTRATOR_HPP_
+
+#include "autoware/node/node.hpp"
+#include "autoware/node/visibility_control.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace autoware::node
+{
+
+enum class LifecycleTransition { Configure, Activate, Deactivate, Cleanup, Shutdown };
+
+struct WaveTiming
+{
+  std::vector<std::string> node_names;
+  std::chrono::nanoseconds duration{0};
+  // node which took the longest in the wave
+  std::string slowest_node_name;
+  std::chrono::nanoseconds slowest_duration{0};
+};
+
+struct OrchestrationResult
+{
+  bool success{true};
+  std::vector<WaveTiming> waves;
+  // nodes which did not reach the goal state, after which no wave was started
+  std::vector<std::string> failed_node_names;
+  std::chrono::nanoseconds duration{0};
+};
+
+/**
+ * @brief Transitions the nodes of a process in parallel waves following their dependencies.
+ *
+ * The nodes are grouped into waves by the length of their longest chain of dependencies, and the
+ * nodes of a wave are transitioned in parallel by calling their lifecycle callbacks directly,
+ * without a service round trip. Configure and activate run the waves from the dependencies to
+ * the dependents, the other transitions run them in reverse order.
+ */
+class LifecycleOrchestrator
+{
+public:
+  AUTOWARE_NODE_PUBLIC explicit LifecycleOrchestrator(
+    const std::size_t num_threads = std::thread::hardware_concurrency());
+
+  /**
+   * @brief Add a node, transitioned after the nodes with the given fully qualified names.
+   * @throws std::invalid_argument if a node with the same name has already been added
+   */
+  AUTOWARE_NODE_PUBLIC void add_node(
+    const std::shared_ptr<Node> & node, const std::vector<std::string> & dependencies = {});
+
+  /**
+   * @brief Nodes grouped by wave, from the dependencies to the dependents.
+   * @throws std::invalid_argument if a dependency is unknown or cyclic
+   */
+  AUTOWARE_NODE_PUBLIC std::vector<std::vector<std::shared_ptr<Node>>> get_waves() const;
+
+  AUTOWARE_NODE_PUBLIC OrchestrationResult transition(const LifecycleTransition transition);
+  OrchestrationResult configure() { return transition(LifecycleTransition::Configure); }
+  OrchestrationResult activate() { return transition(LifecycleTransition::Activate); }
+  OrchestrationResult deactivate() { return transition(LifecycleTransition::Deactivate); }
+  OrchestrationResult cleanup() { return transition(LifecycleTransition::Cleanup); }
+  OrchestrationResult shutdown() { return transition(LifecycleTransition::Shutdown); }
+
+private:
+  struct Entry
+  {
+    std::shared_ptr<Node> node;
+    std::vector<std::string> dependencies;
+  };
+
+  std::size_t num_threads_;
+  std::map<std::string, Entry> entries_;
+  std::vector<std::string> names_;  // in the order of addition
+};
+
+}  // namespace autoware::node
+
+#endif  // AUTOWARE__NODE__LIFECYCLE_ORCHESTRATOR_HPP_
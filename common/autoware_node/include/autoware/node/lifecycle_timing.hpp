@@ -0,0 +1,86 @@
+// Copyright 2024 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__NODE__LIFECYCLE_TIMING_HPP_
+#define AUTOWARE__NODE__LIFECYCLE_TIMING_HPP_
+
+#include "autoware/node/visibility_control.hpp"
+
+#include <rclcpp/rclcpp.hpp>
+
+#include <autoware_node_msgs/msg/lifecycle_timing_report.hpp>
+
+#include <chrono>
+#include <mutex>
+#include <string>
+
+namespace autoware::node
+{
+
+using autoware_node_msgs::msg::LifecycleTimingReport;
+
+struct TimingStart
+{
+  std::chrono::system_clock::time_point system_time;
+  std::chrono::steady_clock::time_point steady_time;
+
+  static TimingStart now()
+  {
+    return TimingStart{std::chrono::system_clock::now(), std::chrono::steady_clock::now()};
+  }
+};
+
+/**
+ * @brief Records the construction and the lifecycle transitions of a node, and publishes the
+ * report after each of them.
+ */
+class LifecycleTimingRecorder
+{
+public:
+  AUTOWARE_NODE_PUBLIC LifecycleTimingRecorder(
+    const std::string & node_name, const TimingStart & construction_start);
+
+  // the report is published after each record if set
+  AUTOWARE_NODE_PUBLIC void set_publisher(
+    rclcpp::Publisher<LifecycleTimingReport>::SharedPtr publisher);
+
+  // records the construction as ending now, unless it has already been recorded
+  AUTOWARE_NODE_PUBLIC void record_construction();
+  // records the construction of the derived class, from the end of the construction to now, as
+  // "construct_derived", or as "construct_derived_upper_bound" if now is only known to be after
+  // its end, unless it has already been recorded
+  AUTOWARE_NODE_PUBLIC void record_derived_construction(const bool upper_bound);
+  AUTOWARE_NODE_PUBLIC void record(
+    const std::string & label, const TimingStart & start, const bool success);
+
+  AUTOWARE_NODE_PUBLIC LifecycleTimingReport get_report() const;
+
+  // system time of the start of the process, from /proc with a resolution of a clock tick
+  AUTOWARE_NODE_PUBLIC static std::chrono::system_clock::time_point get_process_start_time();
+
+private:
+  void record_locked(const std::string & label, const TimingStart & start, const bool success);
+
+  mutable std::mutex mutex_;
+  const TimingStart construction_start_;
+  bool construction_recorded_{false};
+  TimingStart construction_end_;
+  bool derived_construction_recorded_{false};
+  LifecycleTimingReport report_;
+  rclcpp::Publisher<LifecycleTimingReport>::SharedPtr publisher_;
+};
+
+}  // namespace autoware::node
+
+#endif  // AUTOWARE__NODE__LIFECYCLE_TIMING_HPP_
@@ -0,0 +1,133 @@
+// Copyright 2024 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__NODE__LOANED_PUBLISHER_HPP_
+#define AUTOWARE__NODE__LOANED_PUBLISHER_HPP_
+
+#include <rclcpp/rclcpp.hpp>
+#include <rclcpp_lifecycle/lifecycle_publisher.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace autoware::node
+{
+
+struct LoanStatistics
+{
+  uint64_t loaned_count{0};  // messages borrowed from the middleware
+  uint64_t pooled_count{0};  // messages taken from the pool
+};
+
+/**
+ * @brief Lifecycle publisher filling messages in place, in memory loaned by the middleware if it
+ * supports it (e.g. shared memory transports) or in a reused message from a pool otherwise.
+ *
+ * The pooled messages keep the capacity of their containers between publishes, so the fallback
+ * path does not allocate in steady state as long as the topic has no intra-process subscription.
+ * Otherwise, rclcpp would copy a message published by reference for them, so the pooled message
+ * is handed over instead and the pool allocates a new one for the next publish. Note that a loaned
+ * message may be uninitialized, so the fill function should set every field.
+ */
+template <typename MessageT>
+class LoanedPublisher
+{
+public:
+  using SharedPtr = std::shared_ptr<LoanedPublisher<MessageT>>;
+  using PublisherT = rclcpp_lifecycle::LifecyclePublisher<MessageT>;
+
+  explicit LoanedPublisher(std::shared_ptr<PublisherT> publisher)
+  : publisher_(std::move(publisher)), can_loan_messages_(publisher_->can_loan_messages())
+  {
+  }
+
+  /**
+   * @brief Fill a message with `fill(MessageT &)` and publish it.
+   * @return false without calling `fill` if the publisher is not activated
+   */
+  template <typename FillT>
+  bool publish(FillT && fill)
+  {
+    if (!publisher_->is_activated()) {
+      return false;
+    }
+
+    if (can_loan_messages_) {
+      auto loaned_message = publisher_->borrow_loaned_message();
+      if (loaned_message.is_valid()) {
+        fill(loaned_message.get());
+        publisher_->publish(std::move(loaned_message));
+        loaned_count_.fetch_add(1, std::memory_order_relaxed);
+        return true;
+      }
+    }
+
+    std::unique_ptr<MessageT> message = acquire();
+    fill(*message);
+    if (publisher_->get_intra_process_subscription_count() > 0) {
+      // moved rather than copied by rclcpp, so it does not come back to the pool
+      publisher_->publish(std::move(message));
+    } else {
+      publisher_->publish(*message);
+      release(std::move(message));
+    }
+    pooled_count_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+  }
+
+  LoanStatistics get_statistics() const
+  {
+    return LoanStatistics{
+      loaned_count_.load(std::memory_order_relaxed),
+      pooled_count_.load(std::memory_order_relaxed)};
+  }
+
+  bool can_loan_messages() const { return can_loan_messages_; }
+  const std::shared_ptr<PublisherT> & get_publisher() const { return publisher_; }
+
+private:
+  std::unique_ptr<MessageT> acquire()
+  {
+    std::lock_guard<std::mutex> lock(pool_mutex_);
+    if (pool_.empty()) {
+      return std::make_unique<MessageT>();
+    }
+    auto message = std::move(pool_.back());
+    pool_.pop_back();
+    return message;
+  }
+
+  void release(std::unique_ptr<MessageT> message)
+  {
+    std::lock_guard<std::mutex> lock(pool_mutex_);
+    pool_.push_back(std::move(message));
+  }
+
+  std::shared_ptr<PublisherT> publisher_;
+  const bool can_loan_messages_;
+  std::atomic<uint64_t> loaned_count_{0};
+  std::atomic<uint64_t> pooled_count_{0};
+
+  // grows up to the number of threads publishing concurrently
+  std::mutex pool_mutex_;
+  std::vector<std::unique_ptr<MessageT>> pool_;
+};
+
+}  // namespace autoware::node
+
+#endif  // AUTOWARE__NODE__LOANED_PUBLISHER_HPP_
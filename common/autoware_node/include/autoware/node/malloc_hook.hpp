@@ -0,0 +1,112 @@
+// Copyright 2024 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__NODE__MALLOC_HOOK_HPP_
+#define AUTOWARE__NODE__MALLOC_HOOK_HPP_
+
+#include "autoware/node/allocation_monitor.hpp"
+#include "autoware/node/resource_usage.hpp"
+
+#include <malloc.h>
+
+#include <cerrno>
+#include <cstddef>
+
+// the glibc implementations, which the hook forwards to
+extern "C" {
+void * __libc_malloc(std::size_t size);                          // NOLINT
+void * __libc_calloc(std::size_t count, std::size_t size);       // NOLINT
+void * __libc_realloc(void * pointer, std::size_t size);         // NOLINT
+void * __libc_memalign(std::size_t alignment, std::size_t size);  // NOLINT
+void __libc_free(void * pointer);                                // NOLINT
+}
+
+namespace autoware::node::malloc_hook_detail
+{
+// attributes the block to the current ResourceAccount of the thread with its usable size
+inline void * on_allocated(void * pointer) noexcept
+{
+  if (pointer) {
+    ResourceAccount::on_allocation(malloc_usable_size(pointer));
+  }
+  return pointer;
+}
+}  // namespace autoware::node::malloc_hook_detail
+
+/**
+ * @brief Define malloc, free and their variants in the calling translation unit, reporting every
+ * allocation to AllocationMonitor, and every allocation and free to ResourceAccount, before
+ * forwarding it to glibc.
+ *
+ * Use it once, at namespace scope, in the executable (e.g. a test) whose allocations should be
+ * monitored. Being defined in the executable, the hook takes precedence over glibc in every
+ * library of the process.
+ */
+#define AUTOWARE_NODE_DEFINE_MALLOC_HOOK()                                                     \
+  extern "C" {                                                                                 \
+  void * malloc(std::size_t size)                                                              \
+  {                                                                                            \
+    autoware::node::AllocationMonitor::on_allocation(size);                                    \
+    return autoware::node::malloc_hook_detail::on_allocated(__libc_malloc(size));              \
+  }                                                                                            \
+  void * calloc(std::size_t count, std::size_t size)                                           \
+  {                                                                                            \
+    autoware::node::AllocationMonitor::on_allocation(count * size);                            \
+    return autoware::node::malloc_hook_detail::on_allocated(__libc_calloc(count, size));       \
+  }                                                                                            \
+  void * realloc(void * pointer, std::size_t size)                                             \
+  {                                                                                            \
+    autoware::node::AllocationMonitor::on_allocation(size);                                    \
+    const std::size_t previous_size = pointer ? malloc_usable_size(pointer) : 0;               \
+    void * result = __libc_realloc(pointer, size);                                             \
+    /* the previous block is kept if the reallocation fails */                                 \
+    if (pointer && (result || size == 0)) {                                                    \
+      autoware::node::ResourceAccount::on_free(previous_size);                                 \
+    }                                                                                          \
+    return autoware::node::malloc_hook_detail::on_allocated(result);                           \
+  }                                                                                            \
+  void * memalign(std::size_t alignment, std::size_t size)                                     \
+  {                                                                                            \
+    autoware::node::AllocationMonitor::on_allocation(size);                                    \
+    return autoware::node::malloc_hook_detail::on_allocated(__libc_memalign(alignment, size)); \
+  }                                                                                            \
+  void * aligned_alloc(std::size_t alignment, std::size_t size)                                \
+  {                                                                                            \
+    autoware::node::AllocationMonitor::on_allocation(size);                                    \
+    return autoware::node::malloc_hook_detail::on_allocated(__libc_memalign(alignment, size)); \
+  }                                                                                            \
+  int posix_memalign(void ** pointer, std::size_t alignment, std::size_t size)                 \
+  {                                                                                            \
+    if (alignment % sizeof(void *) != 0 || (alignment & (alignment - 1)) != 0) {               \
+      return EINVAL;                                                                           \
+    }                                                                                          \
+    autoware::node::AllocationMonitor::on_allocation(size);                                    \
+    void * result =                                                                            \
+      autoware::node::malloc_hook_detail::on_allocated(__libc_memalign(alignment, size));      \
+    if (result == nullptr) {                                                                   \
+      return ENOMEM;                                                                           \
+    }                                                                                          \
+    *pointer = result;                                                                         \
+    return 0;                                                                                  \
+  }                                                                                            \
+  void free(void * pointer)                                                                    \
+  {                                                                                            \
+    if (pointer) {                                                                             \
+      autoware::node::ResourceAccount::on_free(malloc_usable_size(pointer));                   \
+    }                                                                                          \
+    __libc_free(pointer);                                                                      \
+  }                                                                                            \
+  }
+
+#endif  // AUTOWARE__NODE__MALLOC_HOOK_HPP_
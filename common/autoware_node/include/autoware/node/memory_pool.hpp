@@ -0,0 +1,148 @@
+// Copyright 2024 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__NODE__MEMORY_POOL_HPP_
+#define AUTOWARE__NODE__MEMORY_POOL_HPP_
+
+#include "autoware/node/visibility_control.hpp"
+
+#include <rclcpp/rclcpp.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+
+namespace autoware::node
+{
+
+/**
+ * @brief Memory resource serving allocations from an arena allocated and touched up front.
+ *
+ * Blocks are rounded up to powers of two and recycled through one free list per size, like the
+ * first level of a TLSF allocator, so that allocation and deallocation take constant time and do
+ * not call malloc once the arena is allocated. Requests larger than `max_block_size`, or beyond
+ * the capacity of the arena, fall back to the upstream resource and are counted.
+ */
+class MemoryPool : public std::pmr::memory_resource
+{
+public:
+  static constexpr std::size_t min_block_size = 16;
+
+  AUTOWARE_NODE_PUBLIC explicit MemoryPool(
+    const std::size_t capacity, const std::size_t max_block_size = std::size_t{1} << 20,
+    std::pmr::memory_resource * upstream = std::pmr::new_delete_resource());
+
+  std::size_t get_capacity() const noexcept { return capacity_; }
+  AUTOWARE_NODE_PUBLIC std::size_t get_used_size() const;
+  uint64_t get_fallback_count() const noexcept
+  {
+    return fallback_count_.load(std::memory_order_relaxed);
+  }
+
+protected:
+  AUTOWARE_NODE_PUBLIC void * do_allocate(std::size_t bytes, std::size_t alignment) override;
+  AUTOWARE_NODE_PUBLIC void do_deallocate(
+    void * pointer, std::size_t bytes, std::size_t alignment) override;
+  AUTOWARE_NODE_PUBLIC bool do_is_equal(
+    const std::pmr::memory_resource & other) const noexcept override;
+
+private:
+  static constexpr std::size_t num_size_classes = 48;
+
+  struct FreeBlock
+  {
+    FreeBlock * next;
+  };
+
+  std::size_t to_size_class(const std::size_t bytes, const std::size_t alignment) const noexcept;
+
+  const std::size_t capacity_;
+  const std::size_t max_block_size_;
+  std::pmr::memory_resource * const upstream_;
+  std::unique_ptr<std::byte[]> arena_;
+
+  mutable std::mutex mutex_;
+  std::size_t arena_offset_{0};
+  std::size_t free_size_{0};
+  std::array<FreeBlock *, num_size_classes> free_lists_{};
+  std::atomic<uint64_t> fallback_count_{0};
+};
+
+/**
+ * @brief Standard allocator forwarding to a memory resource, to be passed to rclcpp publishers,
+ * subscriptions and memory strategies.
+ */
+template <typename T>
+class PoolAllocator
+{
+public:
+  using value_type = T;
+
+  template <typename U>
+  struct rebind
+  {
+    using other = PoolAllocator<U>;
+  };
+
+  PoolAllocator() noexcept : resource_(std::pmr::new_delete_resource()) {}
+  explicit PoolAllocator(std::pmr::memory_resource * resource) noexcept : resource_(resource) {}
+  template <typename U>
+  PoolAllocator(const PoolAllocator<U> & other) noexcept  // NOLINT
+  : resource_(other.resource())
+  {
+  }
+
+  T * allocate(const std::size_t n)
+  {
+    return static_cast<T *>(resource_->allocate(n * sizeof(T), alignof(T)));
+  }
+  void deallocate(T * pointer, const std::size_t n)
+  {
+    resource_->deallocate(pointer, n * sizeof(T), alignof(T));
+  }
+
+  std::pmr::memory_resource * resource() const noexcept { return resource_; }
+
+private:
+  std::pmr::memory_resource * resource_;
+};
+
+template <typename T, typename U>
+bool operator==(const PoolAllocator<T> & a, const PoolAllocator<U> & b) noexcept
+{
+  return *a.resource() == *b.resource();
+}
+
+template <typename T, typename U>
+bool operator!=(const PoolAllocator<T> & a, const PoolAllocator<U> & b) noexcept
+{
+  return !(a == b);
+}
+
+/**
+ * @brief Lock the current and future pages of the process in RAM and keep malloc from returning
+ * memory to the system, so that touched memory never page faults again.
+ * @details The settings apply to the whole process and are never undone, so this is not called by
+ * any node: the owner of the process, e.g. the main function of a real-time executable, opts in.
+ * @return false, with a warning, if the memory cannot be locked, e.g. without CAP_IPC_LOCK
+ */
+AUTOWARE_NODE_PUBLIC bool lock_memory(const rclcpp::Logger & logger);
+
+}  // namespace autoware::node
+
+#endif  // AUTOWARE__NODE__MEMORY_POOL_HPP_
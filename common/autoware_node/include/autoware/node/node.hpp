@@ -15,14 +15,49 @@
 #ifndef AUTOWARE__NODE__NODE_HPP_
 #define AUTOWARE__NODE__NODE_HPP_
 
+#include "autoware/node/allocation_monitor.hpp"
+#include "autoware/node/async_logger.hpp"
+#include "autoware/node/callback_latency.hpp"
+#include "autoware/node/flight_recorder.hpp"
+#include "autoware/node/gated_publisher.hpp"
+#include "autoware/node/latency_budget.hpp"
+#include "autoware/node/lazy_subscription.hpp"
+#include "autoware/node/lifecycle_timing.hpp"
+#include "autoware/node/loaned_publisher.hpp"
+#include "autoware/node/memory_pool.hpp"
+#include "autoware/node/parameter_handle.hpp"
+#include "autoware/node/resource_usage.hpp"
+#include "autoware/node/thread_pool.hpp"
+#include "autoware/node/thread_profile.hpp"
+#include "autoware/node/timer_coalescer.hpp"
 #include "autoware/node/visibility_control.hpp"
+#include "autoware/node/zero_copy_publisher.hpp"
 
+#include <rclcpp/rclcpp.hpp>
 #include <rclcpp_lifecycle/lifecycle_node.hpp>
 
+#include <diagnostic_msgs/msg/diagnostic_array.hpp>
+#include <std_srvs/srv/trigger.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace autoware::node
 {
+class LifecycleManager;
+
 using CallbackReturn = rclcpp_lifecycle::node_interfaces::LifecycleNodeInterface::CallbackReturn;
 
 class Node : public rclcpp_lifecycle::LifecycleNode
@@ -33,8 +68,637 @@ public:
     const std::string & node_name, const std::string & ns = "",
     const rclcpp::NodeOptions & options = rclcpp::NodeOptions());
 
+  AUTOWARE_NODE_PUBLIC
+  ~Node() override;
+
+  /**
+   * @brief Create a subscription recording the execution time and queueing delay of the callback.
+   *
+   * The callback takes `typename MessageT::ConstSharedPtr`. The queueing delay is measured from the
+   * reception timestamp of the middleware, and is not recorded if the middleware does not set it.
+   * The latency of the messages from the origin of their data is recorded, see
+   * create_monitored_publisher(). Intra-process deliveries and simulated time have no publication
+   * time, so the messages without header have no origin then, and no hop latency is recorded.
+   * The messages are also kept by the flight recorder if enabled.
+   */
+  template <typename MessageT, typename CallbackT>
+  typename rclcpp::Subscription<MessageT>::SharedPtr create_monitored_subscription(
+    const std::string & topic_name, const rclcpp::QoS & qos, CallbackT && callback,
+    const rclcpp::SubscriptionOptions & options = rclcpp::SubscriptionOptions())
+  {
+    auto monitor = callback_latency_monitor_;
+    auto statistics = monitor->add("subscription " + topic_name);
+    const std::string resolved_topic_name =
+      get_node_topics_interface()->resolve_topic_name(topic_name);
+    auto budget_statistics = latency_budget_monitor_->add(
+      "input " + resolved_topic_name, get_latency_budget(resolved_topic_name));
+    std::shared_ptr<TypedFlightRecorderTopic<MessageT>> recorder_topic;
+    if (flight_recorder_) {
+      if (const size_t max_messages = get_flight_recorder_capacity(resolved_topic_name)) {
+        recorder_topic = flight_recorder_->add_topic<MessageT>(
+          resolved_topic_name, max_messages, get_flight_recorder_max_bytes(resolved_topic_name));
+      }
+    }
+    auto subscription = create_subscription<MessageT>(
+      topic_name, qos,
+      [monitor, statistics, budget_monitor = latency_budget_monitor_, budget_statistics,
+       recorder_topic, account = resource_account_, callback = std::forward<CallbackT>(callback)](
+        const typename MessageT::ConstSharedPtr message,
+        const rclcpp::MessageInfo & message_info) mutable {
+        const ResourceAccount::Scope scope(*account);
+        if (recorder_topic) {
+          recorder_topic->record(message, FlightRecorder::now());
+        }
+        if (monitor->is_enabled()) {
+          record_queueing_delay(*statistics, message_info);
+        }
+        const int64_t origin = get_origin_time(*message);
+        const int64_t start = budget_monitor->is_enabled() ? budget_monitor->now() : 0;
+        // the publication time is the origin of the messages without header; it is a system time,
+        // and 0 for intra-process deliveries
+        const int64_t published_time = start > 0 && !budget_monitor->is_sim_time()
+                                         ? message_info.get_rmw_message_info().source_timestamp
+                                         : 0;
+        if (start > 0) {
+          LatencyBudgetMonitor::record(
+            *budget_statistics, origin > 0 ? origin : published_time, published_time, start);
+        }
+        const LatencyBudgetMonitor::OriginScope origin_scope(
+          origin > 0 ? origin : published_time, start);
+        monitor->invoke(*statistics, callback, message);
+      },
+      options);
+    if (recorder_topic) {
+      recorder_topic->set_copy_messages(subscription->can_loan_messages());
+    }
+    return subscription;
+  }
+
+  /**
+   * @brief Create a wall timer recording the execution time and the delay from the scheduled time.
+   */
+  template <typename DurationRepT, typename DurationT, typename CallbackT>
+  rclcpp::TimerBase::SharedPtr create_monitored_timer(
+    const std::string & name, const std::chrono::duration<DurationRepT, DurationT> period,
+    CallbackT && callback, rclcpp::CallbackGroup::SharedPtr group = nullptr)
+  {
+    using std::chrono::steady_clock;
+    auto monitor = callback_latency_monitor_;
+    auto statistics = monitor->add("timer " + name);
+    const auto period_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(period);
+    // the first scheduled time is only known once the timer has started
+    auto first_scheduled_time = std::make_shared<std::atomic<steady_clock::rep>>(0);
+    auto timer = create_wall_timer(
+      period,
+      [monitor, statistics, account = resource_account_, period_ns, first_scheduled_time,
+       scheduled_time = steady_clock::time_point(),
+       callback = std::forward<CallbackT>(callback)]() mutable {
+        const ResourceAccount::Scope scope(*account);
+        // the queueing delay ends where the execution time starts
+        const auto start = steady_clock::now();
+        if (scheduled_time == steady_clock::time_point()) {
+          scheduled_time =
+            steady_clock::time_point(steady_clock::duration(first_scheduled_time->load()));
+        }
+        if (
+          monitor->is_enabled() && period_ns.count() > 0 &&
+          scheduled_time != steady_clock::time_point()) {
+          const auto delay = start - scheduled_time;
+          statistics->queueing_delay.record(CallbackLatencyMonitor::to_nanoseconds(delay));
+          // the timer skips the periods which have already passed
+          scheduled_time += period_ns * (std::max<int64_t>(delay / period_ns, 0) + 1);
+        } else {
+          scheduled_time = start + period_ns;
+        }
+        monitor->invoke_since(start, *statistics, callback);
+      },
+      group);
+    // wall timers use the steady clock
+    const auto first_time = steady_clock::now() + timer->time_until_trigger();
+    first_scheduled_time->store(first_time.time_since_epoch().count());
+    return timer;
+  }
+
+  /**
+   * @brief Create a service recording the execution time of the callback.
+   */
+  template <typename ServiceT, typename CallbackT>
+  typename rclcpp::Service<ServiceT>::SharedPtr create_monitored_service(
+    const std::string & service_name, CallbackT && callback,
+    const rmw_qos_profile_t & qos_profile = rmw_qos_profile_services_default,
+    rclcpp::CallbackGroup::SharedPtr group = nullptr)
+  {
+    auto monitor = callback_latency_monitor_;
+    auto statistics = monitor->add("service " + service_name);
+    return create_service<ServiceT>(
+      service_name,
+      [monitor, statistics, account = resource_account_,
+       callback = std::forward<CallbackT>(callback)](
+        const std::shared_ptr<typename ServiceT::Request> request,
+        std::shared_ptr<typename ServiceT::Response> response) mutable {
+        const ResourceAccount::Scope scope(*account);
+        monitor->invoke(*statistics, callback, request, response);
+      },
+      qos_profile, group);
+  }
+
+  AUTOWARE_NODE_PUBLIC
+  std::vector<CallbackLatencySnapshot> get_callback_latency_snapshots() const;
+
+  /**
+   * @brief Create a lifecycle publisher recording the latency of its messages from the origin of
+   * their data, i.e. their header stamp or the origin of the input being processed, and from the
+   * start of the input callback.
+   *
+   * The cumulative latencies of the inputs and outputs are checked against the read-only
+   * parameters `latency_budget.topics.<topic>` in seconds, and overruns are reported to
+   * /diagnostics every `latency_budget.diagnostics_period` seconds.
+   */
+  template <typename MessageT>
+  typename MonitoredPublisher<MessageT>::SharedPtr create_monitored_publisher(
+    const std::string & topic_name, const rclcpp::QoS & qos,
+    const rclcpp::PublisherOptions & options = rclcpp::PublisherOptions())
+  {
+    auto publisher = create_publisher<MessageT>(topic_name, qos, options);
+    const std::string resolved_topic_name = publisher->get_topic_name();
+    return std::make_shared<MonitoredPublisher<MessageT>>(
+      publisher, latency_budget_monitor_,
+      latency_budget_monitor_->add(
+        "output " + resolved_topic_name, get_latency_budget(resolved_topic_name)));
+  }
+
+  AUTOWARE_NODE_PUBLIC
+  std::vector<LatencyBudgetSnapshot> get_latency_budget_snapshots() const;
+
+  /**
+   * @brief Thread CPU time and heap allocations of the monitored callbacks and the lifecycle
+   * transitions of the node.
+   */
+  ResourceUsage get_resource_usage() const { return resource_account_->get_usage(); }
+  const std::shared_ptr<ResourceAccount> & get_resource_account() const
+  {
+    return resource_account_;
+  }
+
+  /**
+   * @brief Recorder of the last messages of the monitored subscriptions, or nullptr unless the
+   * parameter `flight_recorder.enabled` is true.
+   */
+  const std::shared_ptr<FlightRecorder> & get_flight_recorder() const { return flight_recorder_; }
+
+  /**
+   * @brief Write the recorded messages to a bag in the background, e.g. when the node detects a
+   * failure.
+   * @return path of the bag, or an empty string if the flight recorder is disabled
+   */
+  AUTOWARE_NODE_PUBLIC std::string snapshot_flight_recorder(const std::string & reason);
+
+  /**
+   * @brief Logger of the node formatting and writing its records on a background thread, for the
+   * AUTOWARE_ASYNC_* macros in latency-sensitive callbacks.
+   */
+  AsyncLogger & get_async_logger() { return *async_logger_; }
+
+  /**
+   * @brief Work-stealing pool shared by the nodes of the process, sized from its CPU affinity, for
+   * the parallel parts of the callbacks.
+   */
+  ThreadPool & get_thread_pool() const { return ThreadPool::get_instance(); }
+
+  /**
+   * @brief Run the work on the thread pool. Its CPU time and allocations are accounted to the node.
+   *
+   * The work must not touch the node after its destruction.
+   */
+  template <typename WorkT>
+  auto submit_task(WorkT && work)
+  {
+    return get_thread_pool().submit(wrap_task(std::forward<WorkT>(work)));
+  }
+
+  /**
+   * @brief Run the work on the thread pool, then `on_complete(result)`, or `on_complete()` for a
+   * void work, on the executor of the node in its default callback group, where the completion can
+   * publish like any other callback.
+   *
+   * The completion is dropped if the node has been destroyed or the work threw.
+   */
+  template <typename WorkT, typename CompletionT>
+  void submit_task(WorkT && work, CompletionT && on_complete)
+  {
+    std::weak_ptr<TaskCompletionQueue> queue = get_task_completion_queue();
+    get_thread_pool().post(Task(
+      [queue, account = resource_account_, task = wrap_task(std::forward<WorkT>(work)),
+       on_complete = std::forward<CompletionT>(on_complete)]() mutable {
+        if constexpr (std::is_void_v<std::invoke_result_t<decltype(task) &>>) {
+          task();
+          if (const auto locked_queue = queue.lock()) {
+            locked_queue->push(Task([account, on_complete = std::move(on_complete)]() mutable {
+              const ResourceAccount::Scope scope(*account);
+              on_complete();
+            }));
+          }
+        } else {
+          auto result = task();
+          if (const auto locked_queue = queue.lock()) {
+            locked_queue->push(Task([account, on_complete = std::move(on_complete),
+                                     result = std::move(result)]() mutable {
+              const ResourceAccount::Scope scope(*account);
+              on_complete(std::move(result));
+            }));
+          }
+        }
+      }));
+  }
+
+  /**
+   * @brief Call `body(index)` for every index in [begin, end) on the calling thread and the thread
+   * pool, accounted to the node like submit_task(), see ThreadPool::parallel_for().
+   */
+  template <typename BodyT>
+  void parallel_for(const size_t begin, const size_t end, BodyT && body, size_t grain = 0)
+  {
+    if (begin >= end) {
+      return;
+    }
+    auto & pool = get_thread_pool();
+    const size_t count = end - begin;
+    if (grain == 0) {
+      grain = std::max<size_t>(count / (4 * (pool.size() + 1)), 1);
+    }
+    const size_t num_chunks = (count + grain - 1) / grain;
+    task_statistics_->submitted_count.fetch_add(num_chunks, std::memory_order_relaxed);
+    const auto submit_time = std::chrono::steady_clock::now();
+    pool.parallel_for(
+      0, num_chunks,
+      [&](const size_t chunk) {
+        const auto run_chunk = [&]() {
+          const size_t chunk_end = std::min(begin + (chunk + 1) * grain, end);
+          for (size_t index = begin + chunk * grain; index < chunk_end; ++index) {
+            body(index);
+          }
+        };
+        run_task(*task_statistics_, *resource_account_, submit_time, run_chunk);
+      },
+      1);
+  }
+
+  // counts of the tasks and chunks of parallel_for() of the node
+  const TaskStatistics & get_task_statistics() const { return *task_statistics_; }
+
+  /**
+   * @brief Create a periodic task driven by the timer coalescer of the process instead of a timer
+   * of its own, for the low-rate housekeeping of the node, e.g. diagnostics and heartbeats.
+   *
+   * The callback runs on the executor of the node in its default callback group, up to the
+   * tolerance after the expiration, by default the read-only parameter `coalesced_timer.tolerance`
+   * in seconds. Destroying the returned handle cancels the task.
+   */
+  AUTOWARE_NODE_PUBLIC
+  CoalescedTimer::SharedPtr create_coalesced_timer(
+    const std::chrono::nanoseconds period, std::function<void()> callback,
+    const std::optional<std::chrono::nanoseconds> & tolerance = std::nullopt);
+
+  /**
+   * @brief Declare a parameter and return a handle reading its value wait-free in the callbacks.
+   *
+   * A new value is rejected by the on-set-parameters callback of the node if it has a wrong type
+   * or the validator, returning the reason of the rejection or an empty string, rejects it.
+   * Otherwise, the handle is updated with the value.
+   * @throw rclcpp::exceptions::InvalidParameterValueException if the validator rejects the initial
+   * value
+   */
+  template <typename T>
+  typename ParameterHandle<T>::SharedPtr declare_parameter_handle(
+    const std::string & name, const T & default_value,
+    typename ParameterHandle<T>::Validator validator = nullptr,
+    const rcl_interfaces::msg::ParameterDescriptor & descriptor =
+      rcl_interfaces::msg::ParameterDescriptor())
+  {
+    const T value = declare_parameter<T>(name, default_value, descriptor);
+    if (validator) {
+      const std::string reason = validator(value);
+      if (!reason.empty()) {
+        throw rclcpp::exceptions::InvalidParameterValueException(name + ": " + reason);
+      }
+    }
+    auto handle = std::make_shared<ParameterHandle<T>>(value, std::move(validator));
+    add_parameter_handle(name, handle);
+    return handle;
+  }
+
+  /**
+   * @brief Create a lifecycle publisher with intra-process delivery enabled regardless of the node
+   * options, favoring the move of std::unique_ptr messages.
+   *
+   * Intra-process delivery requires a volatile, keep last QoS. Otherwise, a warning is logged and
+   * the publisher falls back to inter-process delivery.
+   */
+  template <typename MessageT>
+  typename ZeroCopyPublisher<MessageT>::SharedPtr create_zero_copy_publisher(
+    const std::string & topic_name, const rclcpp::QoS & qos,
+    rclcpp::PublisherOptions options = rclcpp::PublisherOptions())
+  {
+    options.use_intra_process_comm = get_intra_process_setting(topic_name, qos);
+    return std::make_shared<ZeroCopyPublisher<MessageT>>(
+      create_publisher<MessageT>(topic_name, qos, options), get_logger());
+  }
+
+  /**
+   * @brief Create a subscription with intra-process delivery enabled regardless of the node
+   * options. A callback taking `std::unique_ptr<MessageT>` receives the published message itself
+   * if it is the only intra-process subscription.
+   */
+  template <typename MessageT, typename CallbackT>
+  typename rclcpp::Subscription<MessageT>::SharedPtr create_zero_copy_subscription(
+    const std::string & topic_name, const rclcpp::QoS & qos, CallbackT && callback,
+    rclcpp::SubscriptionOptions options = rclcpp::SubscriptionOptions())
+  {
+    options.use_intra_process_comm = get_intra_process_setting(topic_name, qos);
+    return create_subscription<MessageT>(
+      topic_name, qos, std::forward<CallbackT>(callback), options);
+  }
+
+  /**
+   * @brief Create a lifecycle publisher filling messages in memory loaned by the middleware when
+   * possible, and in pooled messages otherwise.
+   */
+  template <typename MessageT>
+  typename LoanedPublisher<MessageT>::SharedPtr create_loaned_publisher(
+    const std::string & topic_name, const rclcpp::QoS & qos,
+    const rclcpp::PublisherOptions & options = rclcpp::PublisherOptions())
+  {
+    return std::make_shared<LoanedPublisher<MessageT>>(
+      create_publisher<MessageT>(topic_name, qos, options));
+  }
+
+  /**
+   * @brief Create a lifecycle publisher whose `should_publish()` and `publish(factory)` skip the
+   * construction of messages which nobody would receive.
+   */
+  template <typename MessageT>
+  typename GatedPublisher<MessageT>::SharedPtr create_gated_publisher(
+    const std::string & topic_name, const rclcpp::QoS & qos,
+    const rclcpp::PublisherOptions & options = rclcpp::PublisherOptions())
+  {
+    return std::make_shared<GatedPublisher<MessageT>>(
+      create_publisher<MessageT>(topic_name, qos, options),
+      get_node_graph_interface()->get_graph_event());
+  }
+
+  /**
+   * @brief Create a subscription which exists only while at least one of the output publishers has
+   * subscriptions, for nodes whose outputs are often unused, e.g. debug pipelines.
+   *
+   * The demand is checked on the graph events of the node, and again 100 ms after each of them as
+   * the middleware matches the endpoints asynchronously. The subscription is destroyed
+   * `lazy_subscription.hysteresis` seconds after the demand disappears.
+   */
+  template <typename MessageT, typename CallbackT>
+  typename LazySubscription<MessageT>::SharedPtr create_lazy_subscription(
+    const std::string & topic_name, const rclcpp::QoS & qos, CallbackT && callback,
+    std::vector<rclcpp::PublisherBase::SharedPtr> outputs,
+    const rclcpp::SubscriptionOptions & options = rclcpp::SubscriptionOptions())
+  {
+    auto lazy_subscription = std::make_shared<LazySubscription<MessageT>>(
+      [this, topic_name, qos, callback = std::forward<CallbackT>(callback), options]() {
+        return create_subscription<MessageT>(topic_name, qos, callback, options);
+      },
+      std::move(outputs), lazy_subscription_hysteresis_);
+    add_lazy_subscription(lazy_subscription);
+    return lazy_subscription;
+  }
+
+  /**
+   * @brief Create a callback group spun in a dedicated thread by RealtimeExecutor.
+   *
+   * The profile of the thread is read from the parameters `realtime.<name>.priority` (SCHED_FIFO
+   * priority, 0 to disable) and `realtime.<name>.cpu_affinity` (list of CPUs, empty for all).
+   * Other executors do not spin the group, as it is not added automatically with the node.
+   */
+  AUTOWARE_NODE_PUBLIC
+  rclcpp::CallbackGroup::SharedPtr create_realtime_callback_group(
+    const std::string & name,
+    const rclcpp::CallbackGroupType type = rclcpp::CallbackGroupType::MutuallyExclusive);
+
+  const std::vector<RealtimeCallbackGroup> & get_realtime_callback_groups() const
+  {
+    return realtime_callback_groups_;
+  }
+
+  /**
+   * @brief Memory pool of the zero-allocation mode, or nullptr if it is disabled.
+   */
+  const std::shared_ptr<MemoryPool> & get_memory_pool() const { return memory_pool_; }
+
+  /**
+   * @brief Monitor of the zero-allocation mode, or nullptr if it is disabled.
+   *
+   * RealtimeExecutor guards the dedicated threads of the real-time callback groups with it, and
+   * other threads spinning the node may call AllocationMonitor::set_thread_monitor().
+   */
+  const std::shared_ptr<AllocationMonitor> & get_allocation_monitor() const
+  {
+    return allocation_monitor_;
+  }
+
+  // allocator of the memory pool, or of the global heap if the zero-allocation mode is disabled
+  template <typename T = void>
+  PoolAllocator<T> get_pool_allocator() const
+  {
+    return memory_pool_ ? PoolAllocator<T>(memory_pool_.get()) : PoolAllocator<T>();
+  }
+
+  /**
+   * @brief Create a lifecycle publisher allocating from the memory pool.
+   *
+   * The messages themselves use the default allocator, as type supports only exist for it, so
+   * messages with sequences should be reused rather than created for each publish.
+   */
+  template <typename MessageT>
+  typename rclcpp_lifecycle::LifecyclePublisher<MessageT, PoolAllocator<void>>::SharedPtr
+  create_pooled_publisher(const std::string & topic_name, const rclcpp::QoS & qos)
+  {
+    rclcpp::PublisherOptionsWithAllocator<PoolAllocator<void>> options;
+    options.allocator = std::make_shared<PoolAllocator<void>>(get_pool_allocator());
+    return create_publisher<MessageT, PoolAllocator<void>>(topic_name, qos, options);
+  }
+
+  /**
+   * @brief Create a subscription allocating the received messages from the memory pool.
+   */
+  template <typename MessageT, typename CallbackT>
+  typename rclcpp::Subscription<MessageT, PoolAllocator<void>>::SharedPtr
+  create_pooled_subscription(
+    const std::string & topic_name, const rclcpp::QoS & qos, CallbackT && callback,
+    rclcpp::CallbackGroup::SharedPtr group = nullptr)
+  {
+    using MessageMemoryStrategyT =
+      rclcpp::message_memory_strategy::MessageMemoryStrategy<MessageT, PoolAllocator<void>>;
+    auto allocator = std::make_shared<PoolAllocator<void>>(get_pool_allocator());
+    rclcpp::SubscriptionOptionsWithAllocator<PoolAllocator<void>> options;
+    options.allocator = allocator;
+    options.callback_group = group;
+    return create_subscription<MessageT>(
+      topic_name, qos, std::forward<CallbackT>(callback), options,
+      std::make_shared<MessageMemoryStrategyT>(allocator));
+  }
+
+  /**
+   * @brief Executor options whose memory strategy allocates from the memory pool.
+   */
+  AUTOWARE_NODE_PUBLIC
+  rclcpp::ExecutorOptions get_pooled_executor_options() const;
+
+  /**
+   * @brief Timings of the construction of AN and the lifecycle transitions of the node so far,
+   * also published on `~/lifecycle_timing` with transient local durability if the parameter
+   * `lifecycle_timing.publish` is true.
+   */
+  AUTOWARE_NODE_PUBLIC
+  LifecycleTimingReport get_lifecycle_timing_report() const;
+
+  /**
+   * @brief Lifecycle manager serving the transitions of the node, or nullptr if the node has its
+   * own lifecycle services.
+   */
+  const std::shared_ptr<LifecycleManager> & get_lifecycle_manager() const
+  {
+    return lifecycle_manager_;
+  }
+
+  /**
+   * @brief Register the node with its lifecycle manager, which is otherwise done when the node is
+   * first spun, so that its transitions cannot reach a partially constructed object.
+   *
+   * Call it after the construction, e.g. on a node created by std::make_shared and not spun yet.
+   * @return false if the node has no lifecycle manager or is not owned by a shared pointer
+   */
+  AUTOWARE_NODE_PUBLIC bool register_with_lifecycle_manager();
+
 protected:
   CallbackReturn on_shutdown(const rclcpp_lifecycle::State & state) override;
+
+  /**
+   * @brief Record the end of the constructor of the derived class in the lifecycle timing, as
+   * "construct_derived".
+   *
+   * Call it at the end of the constructor. Otherwise, the construction of the derived class is
+   * recorded as "construct_derived_upper_bound", until the first transition or the registration
+   * with the lifecycle manager, which also counts the idle time before them.
+   */
+  AUTOWARE_NODE_PUBLIC void mark_constructed();
+
+private:
+  AUTOWARE_NODE_PUBLIC
+  rclcpp::IntraProcessSetting get_intra_process_setting(
+    const std::string & topic_name, const rclcpp::QoS & qos) const;
+
+  template <typename CallbackT>
+  CallbackReturn time_transition(const char * label, CallbackT && callback);
+  void register_transition_callbacks();
+
+  void publish_resource_usage_diagnostics();
+
+  // [ns], 0 if the topic has no budget
+  AUTOWARE_NODE_PUBLIC int64_t get_latency_budget(const std::string & topic_name);
+  void publish_latency_budget_diagnostics();
+  const rclcpp::Publisher<diagnostic_msgs::msg::DiagnosticArray>::SharedPtr &
+  get_diagnostics_publisher();
+
+  // 0 if the topic is not recorded
+  AUTOWARE_NODE_PUBLIC size_t get_flight_recorder_capacity(const std::string & topic_name);
+  // [byte], 0 for no limit
+  AUTOWARE_NODE_PUBLIC size_t get_flight_recorder_max_bytes(const std::string & topic_name);
+
+  AUTOWARE_NODE_PUBLIC
+  void add_lazy_subscription(const std::shared_ptr<LazySubscriptionBase> & lazy_subscription);
+  void update_lazy_subscriptions(const bool graph_changed);
+
+  void start_zero_allocation();
+  void stop_zero_allocation();
+
+  template <typename WorkT>
+  auto wrap_task(WorkT && work)
+  {
+    task_statistics_->submitted_count.fetch_add(1, std::memory_order_relaxed);
+    return [statistics = task_statistics_, account = resource_account_,
+            submit_time = std::chrono::steady_clock::now(),
+            work = std::forward<WorkT>(work)]() mutable -> decltype(auto) {
+      return run_task(*statistics, *account, submit_time, work);
+    };
+  }
+
+  template <typename WorkT>
+  static decltype(auto) run_task(
+    TaskStatistics & statistics, ResourceAccount & account,
+    const std::chrono::steady_clock::time_point submit_time, WorkT & work)
+  {
+    const auto start = std::chrono::steady_clock::now();
+    statistics.queueing_delay.record(CallbackLatencyMonitor::to_nanoseconds(start - submit_time));
+    struct Completion
+    {
+      TaskStatistics & statistics;
+      std::chrono::steady_clock::time_point start;
+      ~Completion()
+      {
+        statistics.execution_time.fetch_add(
+          CallbackLatencyMonitor::to_nanoseconds(std::chrono::steady_clock::now() - start),
+          std::memory_order_relaxed);
+        statistics.completed_count.fetch_add(1, std::memory_order_relaxed);
+      }
+    } completion{statistics, start};
+    const ResourceAccount::Scope scope(account);
+    return work();
+  }
+
+  AUTOWARE_NODE_PUBLIC std::shared_ptr<TaskCompletionQueue> get_task_completion_queue();
+
+  AUTOWARE_NODE_PUBLIC void add_parameter_handle(
+    const std::string & name, const std::shared_ptr<ParameterHandleBase> & handle);
+  rcl_interfaces::msg::SetParametersResult on_set_parameters(
+    const std::vector<rclcpp::Parameter> & parameters);
+
+  AUTOWARE_NODE_PUBLIC
+  static void record_queueing_delay(
+    CallbackLatencyStatistics & statistics, const rclcpp::MessageInfo & message_info);
+
+  std::shared_ptr<CallbackLatencyMonitor> callback_latency_monitor_;
+  std::shared_ptr<LatencyBudgetMonitor> latency_budget_monitor_;
+  std::shared_ptr<ResourceAccount> resource_account_;
+  std::shared_ptr<TaskStatistics> task_statistics_;
+  std::unique_ptr<AsyncLogger> async_logger_;
+  rclcpp::node_interfaces::OnSetParametersCallbackHandle::SharedPtr
+    set_parameters_callback_handle_;
+  std::vector<RealtimeCallbackGroup> realtime_callback_groups_;
+  std::shared_ptr<MemoryPool> memory_pool_;
+  std::shared_ptr<AllocationMonitor> allocation_monitor_;
+  CoalescedTimer::SharedPtr allocation_report_timer_;
+  std::shared_ptr<LifecycleTimingRecorder> lifecycle_timing_recorder_;
+  std::shared_ptr<LifecycleManager> lifecycle_manager_;
+  rclcpp::TimerBase::SharedPtr lifecycle_manager_timer_;
+  rclcpp::Publisher<diagnostic_msgs::msg::DiagnosticArray>::SharedPtr diagnostics_publisher_;
+  CoalescedTimer::SharedPtr diagnostics_timer_;
+  ResourceUsage last_resource_usage_;
+  std::chrono::steady_clock::time_point last_resource_usage_time_;
+  double latency_budget_diagnostics_period_{0.0};
+  CoalescedTimer::SharedPtr latency_budget_diagnostics_timer_;
+  std::map<std::string, uint64_t> last_overrun_counts_;
+  std::shared_ptr<FlightRecorder> flight_recorder_;
+  int64_t flight_recorder_max_messages_{0};
+  int64_t flight_recorder_max_bytes_{0};
+  rclcpp::Service<std_srvs::srv::Trigger>::SharedPtr flight_recorder_service_;
+  std::chrono::nanoseconds lazy_subscription_hysteresis_{0};
+  std::chrono::nanoseconds coalesced_timer_tolerance_{0};
+  std::mutex lazy_subscriptions_mutex_;
+  std::vector<std::weak_ptr<LazySubscriptionBase>> lazy_subscriptions_;
+  std::shared_ptr<GraphChangeWaitable> lazy_subscription_waitable_;
+  // one-shot, armed while a subscription waits for the end of its hysteresis
+  rclcpp::TimerBase::SharedPtr lazy_subscription_timer_;
+  std::mutex task_completion_queue_mutex_;
+  std::shared_ptr<TaskCompletionQueue> task_completion_queue_;
+  std::mutex parameter_handles_mutex_;
+  std::map<std::string, std::shared_ptr<ParameterHandleBase>> parameter_handles_;
 };
 }  // namespace autoware::node
 
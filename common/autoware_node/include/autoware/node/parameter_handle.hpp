@@ -0,0 +1,169 @@
+// Copyright 2024 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__NODE__PARAMETER_HANDLE_HPP_
+#define AUTOWARE__NODE__PARAMETER_HANDLE_HPP_
+
+#include <rclcpp/rclcpp.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace autoware::node
+{
+
+/**
+ * @brief Value read without lock by any number of threads and replaced by a writer.
+ *
+ * Arithmetic values are plain atomics. Other values are replaced by read-copy-update: a reader
+ * only increments and decrements a counter around its access, and the replaced values are freed
+ * by the next writer or the destructor once no reader is active.
+ */
+template <typename T, typename Enable = void>
+class ParameterSnapshot
+{
+public:
+  explicit ParameterSnapshot(const T & value) : current_(new T(value)) {}
+  ~ParameterSnapshot() { delete current_.load(); }
+
+  ParameterSnapshot(const ParameterSnapshot &) = delete;
+  ParameterSnapshot & operator=(const ParameterSnapshot &) = delete;
+
+  template <typename F>
+  decltype(auto) read(F && function) const
+  {
+    readers_.fetch_add(1);
+    struct Exit
+    {
+      std::atomic<size_t> & readers;
+      ~Exit() { readers.fetch_sub(1, std::memory_order_release); }
+    } exit{readers_};
+    return function(*current_.load());
+  }
+
+  void store(const T & value)
+  {
+    auto next = std::make_unique<const T>(value);
+    std::lock_guard<std::mutex> lock(mutex_);
+    retired_.emplace_back(current_.exchange(next.release()));
+    // the readers which start from now on see the new value
+    if (readers_.load() == 0) {
+      retired_.clear();
+    }
+  }
+
+private:
+  std::atomic<const T *> current_;
+  mutable std::atomic<size_t> readers_{0};
+  std::mutex mutex_;
+  std::vector<std::unique_ptr<const T>> retired_;
+};
+
+template <typename T>
+class ParameterSnapshot<T, std::enable_if_t<std::is_arithmetic_v<T>>>
+{
+public:
+  explicit ParameterSnapshot(const T & value) : value_(value) {}
+
+  template <typename F>
+  decltype(auto) read(F && function) const
+  {
+    const T value = value_.load(std::memory_order_acquire);
+    return function(value);
+  }
+
+  void store(const T & value) { value_.store(value, std::memory_order_release); }
+
+private:
+  std::atomic<T> value_;
+};
+
+class ParameterHandleBase
+{
+public:
+  virtual ~ParameterHandleBase() = default;
+
+  // reason of the rejection of the value, empty if it is valid
+  virtual std::string validate(const rclcpp::Parameter & parameter) const = 0;
+  virtual void update(const rclcpp::Parameter & parameter) = 0;
+};
+
+/**
+ * @brief Typed value of a declared parameter, updated when a new value is accepted and read
+ * wait-free by the callbacks, unlike get_parameter() which takes the parameter lock of the node
+ * and copies the parameter.
+ */
+template <typename T>
+class ParameterHandle : public ParameterHandleBase
+{
+public:
+  using SharedPtr = std::shared_ptr<ParameterHandle<T>>;
+  // returns the reason of the rejection of the value, or an empty string if it is valid
+  using Validator = std::function<std::string(const T &)>;
+
+  ParameterHandle(const T & value, Validator validator)
+  : snapshot_(value), validator_(std::move(validator))
+  {
+  }
+
+  T get() const
+  {
+    return snapshot_.read([](const T & value) { return value; });
+  }
+
+  // calls function(const T &) without copying the value, which must not be kept
+  template <typename F>
+  decltype(auto) read(F && function) const
+  {
+    return snapshot_.read(std::forward<F>(function));
+  }
+
+  // incremented by every update, for the readers caching values derived from the parameter
+  uint64_t get_version() const noexcept { return version_.load(std::memory_order_acquire); }
+
+  std::string validate(const rclcpp::Parameter & parameter) const override
+  {
+    T value;
+    try {
+      value = parameter.get_value<T>();
+    } catch (const rclcpp::ParameterTypeException & e) {
+      // e.g. a value of another type, accepted by rclcpp if the descriptor allows dynamic typing
+      return e.what();
+    }
+    return validator_ ? validator_(value) : "";
+  }
+
+  void update(const rclcpp::Parameter & parameter) override
+  {
+    snapshot_.store(parameter.get_value<T>());
+    version_.fetch_add(1, std::memory_order_release);
+  }
+
+private:
+  ParameterSnapshot<T> snapshot_;
+  Validator validator_;
+  std::atomic<uint64_t> version_{0};
+};
+
+}  // namespace autoware::node
+
+#endif  // AUTOWARE__NODE__PARAMETER_HANDLE_HPP_
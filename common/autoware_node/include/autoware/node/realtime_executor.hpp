@@ -0,0 +1,93 @@
+// Copyright 2024 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__NODE__REALTIME_EXECUTOR_HPP_
+#define AUTOWARE__NODE__REALTIME_EXECUTOR_HPP_
+
+#include "autoware/node/allocation_monitor.hpp"
+#include "autoware/node/node.hpp"
+#include "autoware/node/thread_profile.hpp"
+#include "autoware/node/visibility_control.hpp"
+
+#include <rclcpp/rclcpp.hpp>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace autoware::node
+{
+
+/**
+ * @brief Executor spinning every real-time callback group in a dedicated thread.
+ *
+ * Each dedicated thread runs a single-threaded executor with the priority and CPU affinity of the
+ * profile of its callback group, so that e.g. control callbacks are not queued behind diagnostics.
+ * The other callback groups are spun by the thread calling spin(), with the default profile.
+ */
+class RealtimeExecutor
+{
+public:
+  AUTOWARE_NODE_PUBLIC explicit RealtimeExecutor(
+    const rclcpp::ExecutorOptions & options = rclcpp::ExecutorOptions(),
+    ThreadProfile default_profile = ThreadProfile());
+  AUTOWARE_NODE_PUBLIC ~RealtimeExecutor();
+
+  RealtimeExecutor(const RealtimeExecutor &) = delete;
+  RealtimeExecutor & operator=(const RealtimeExecutor &) = delete;
+
+  // adds the node, with its real-time callback groups in dedicated threads, which are guarded by
+  // the allocation monitor of the node if its zero-allocation mode is enabled
+  AUTOWARE_NODE_PUBLIC void add_node(const std::shared_ptr<Node> & node);
+  AUTOWARE_NODE_PUBLIC void add_node(
+    const rclcpp::node_interfaces::NodeBaseInterface::SharedPtr & node);
+  AUTOWARE_NODE_PUBLIC void add_callback_group(
+    const rclcpp::CallbackGroup::SharedPtr & callback_group,
+    const rclcpp::node_interfaces::NodeBaseInterface::SharedPtr & node,
+    const ThreadProfile & profile,
+    const std::shared_ptr<AllocationMonitor> & allocation_monitor = nullptr);
+
+  // blocks until cancel() is called, even before spin(), or the context is shut down, and then
+  // restores the scheduling of the calling thread
+  AUTOWARE_NODE_PUBLIC void spin();
+  AUTOWARE_NODE_PUBLIC void cancel();
+  bool is_spinning() { return spinning_; }
+
+private:
+  struct DedicatedThread
+  {
+    ThreadProfile profile;
+    std::shared_ptr<AllocationMonitor> allocation_monitor;
+    std::shared_ptr<rclcpp::executors::SingleThreadedExecutor> executor;
+    std::thread thread;
+  };
+
+  void start(DedicatedThread & dedicated_thread);
+  void stop();
+
+  rclcpp::ExecutorOptions options_;
+  ThreadProfile default_profile_;
+  rclcpp::executors::SingleThreadedExecutor default_executor_;
+  rclcpp::Logger logger_;
+  std::mutex mutex_;
+  std::vector<std::unique_ptr<DedicatedThread>> dedicated_threads_;
+  std::atomic<bool> spinning_{false};
+  std::atomic<bool> stop_requested_{false};
+};
+
+}  // namespace autoware::node
+
+#endif  // AUTOWARE__NODE__REALTIME_EXECUTOR_HPP_
@@ -0,0 +1,98 @@
+// Copyright 2024 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__NODE__RESOURCE_USAGE_HPP_
+#define AUTOWARE__NODE__RESOURCE_USAGE_HPP_
+
+#include "autoware/node/visibility_control.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace autoware::node
+{
+
+struct ResourceUsage
+{
+  uint64_t cpu_time{0};  // [ns] of thread CPU time
+  uint64_t allocated_bytes{0};
+  uint64_t allocation_count{0};
+  uint64_t freed_bytes{0};
+  uint64_t free_count{0};
+  uint64_t callback_count{0};
+
+  // growth of the heap memory held by the account since its creation [byte]
+  int64_t get_live_bytes() const { return static_cast<int64_t>(allocated_bytes - freed_bytes); }
+};
+
+/**
+ * @brief Thread CPU time and heap allocations and frees attributed to a node.
+ *
+ * A Scope attributes the CPU time of the calling thread, and the allocations and frees it makes,
+ * to the account until the scope ends. A nested scope of another account pauses the CPU time of
+ * the outer one. Allocations and frees are only seen if malloc is intercepted, by defining the
+ * hook of malloc_hook.hpp in the executable, and are counted with their usable size. Memory freed
+ * by another account than the one which allocated it, e.g. a message passed to another node,
+ * moves to the account freeing it.
+ */
+class ResourceAccount
+{
+public:
+  class Scope
+  {
+  public:
+    AUTOWARE_NODE_PUBLIC explicit Scope(ResourceAccount & account) noexcept;
+    AUTOWARE_NODE_PUBLIC ~Scope();
+
+    Scope(const Scope &) = delete;
+    Scope & operator=(const Scope &) = delete;
+
+  private:
+    // null if disabled or nested in a scope of the same account
+    ResourceAccount * account_;
+    ResourceAccount * previous_account_;
+    Scope * previous_scope_;
+    // [ns] of the last start or resumption
+    uint64_t start_cpu_time_{0};
+  };
+
+  AUTOWARE_NODE_PUBLIC ResourceUsage get_usage() const noexcept;
+
+  void set_enabled(const bool enabled) noexcept
+  {
+    enabled_.store(enabled, std::memory_order_relaxed);
+  }
+  bool is_enabled() const noexcept { return enabled_.load(std::memory_order_relaxed); }
+
+  // called by the malloc hook for every allocation and free, with the usable size of the block
+  AUTOWARE_NODE_PUBLIC static void on_allocation(const std::size_t size) noexcept;
+  AUTOWARE_NODE_PUBLIC static void on_free(const std::size_t size) noexcept;
+
+  // [ns] CPU time consumed by the calling thread
+  AUTOWARE_NODE_PUBLIC static uint64_t get_thread_cpu_time() noexcept;
+
+private:
+  std::atomic<bool> enabled_{true};
+  std::atomic<uint64_t> cpu_time_{0};
+  std::atomic<uint64_t> allocated_bytes_{0};
+  std::atomic<uint64_t> allocation_count_{0};
+  std::atomic<uint64_t> freed_bytes_{0};
+  std::atomic<uint64_t> free_count_{0};
+  std::atomic<uint64_t> callback_count_{0};
+};
+
+}  // namespace autoware::node
+
+#endif  // AUTOWARE__NODE__RESOURCE_USAGE_HPP_
@@ -0,0 +1,232 @@
+// Copyright 2024 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__NODE__THREAD_POOL_HPP_
+#define AUTOWARE__NODE__THREAD_POOL_HPP_
+
+#include "autoware/node/latency_histogram.hpp"
+#include "autoware/node/visibility_control.hpp"
+
+#include <rclcpp/rclcpp.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace autoware::node
+{
+
+// move-only callable, unlike std::function
+class Task
+{
+public:
+  Task() = default;
+  template <typename F, typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, Task>>>
+  Task(F && function)  // NOLINT(google-explicit-constructor)
+  : callable_(std::make_unique<Callable<std::decay_t<F>>>(std::forward<F>(function)))
+  {
+  }
+
+  void operator()() { callable_->call(); }
+  explicit operator bool() const { return callable_ != nullptr; }
+
+private:
+  struct CallableBase
+  {
+    virtual ~CallableBase() = default;
+    virtual void call() = 0;
+  };
+  template <typename F>
+  struct Callable : CallableBase
+  {
+    explicit Callable(F && function) : function(std::move(function)) {}
+    explicit Callable(const F & function) : function(function) {}
+    void call() override { function(); }
+    F function;
+  };
+
+  std::unique_ptr<CallableBase> callable_;
+};
+
+/**
+ * @brief Work-stealing thread pool shared by the nodes of a process, so that the nodes composed
+ * in a container do not oversubscribe its CPUs with threads of their own.
+ *
+ * Every worker has its own queue. Tasks posted by a worker go to its own queue and are taken in
+ * LIFO order, and idle workers steal the oldest tasks of the others. The workers run with
+ * SCHED_OTHER on the CPUs of the process, whatever the profile of the thread creating the pool.
+ */
+class ThreadPool
+{
+public:
+  AUTOWARE_NODE_PUBLIC explicit ThreadPool(const size_t num_threads);
+  // runs the queued tasks before joining the workers
+  AUTOWARE_NODE_PUBLIC ~ThreadPool();
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool & operator=(const ThreadPool &) = delete;
+
+  // pool of get_default_size() threads, created on the first use
+  AUTOWARE_NODE_PUBLIC static ThreadPool & get_instance();
+  // number of CPUs in the affinity of the process, e.g. of the container, when the library is
+  // loaded, i.e. before any executor pins its threads
+  AUTOWARE_NODE_PUBLIC static size_t get_default_size();
+
+  size_t size() const { return threads_.size(); }
+
+  // exceptions of posted tasks are logged and discarded
+  AUTOWARE_NODE_PUBLIC void post(Task task);
+
+  template <typename F>
+  std::future<std::invoke_result_t<std::decay_t<F> &>> submit(F && function)
+  {
+    std::packaged_task<std::invoke_result_t<std::decay_t<F> &>()> task(std::forward<F>(function));
+    auto future = task.get_future();
+    post(Task(std::move(task)));
+    return future;
+  }
+
+  /**
+   * @brief Call `body(index)` for every index in [begin, end), in chunks of `grain` indices run by
+   * the calling thread and the workers, and return when all of them are done.
+   *
+   * The first exception thrown by the body is rethrown.
+   */
+  template <typename F>
+  void parallel_for(const size_t begin, const size_t end, F && body, size_t grain = 0)
+  {
+    if (begin >= end) {
+      return;
+    }
+    const size_t count = end - begin;
+    if (grain == 0) {
+      grain = std::max<size_t>(count / (4 * (size() + 1)), 1);
+    }
+
+    struct State
+    {
+      size_t num_chunks;
+      std::atomic<size_t> next_chunk{0};
+      std::mutex mutex;
+      std::condition_variable condition;
+      size_t remaining_chunks;
+      std::exception_ptr exception;
+    };
+    auto state = std::make_shared<State>();
+    state->num_chunks = (count + grain - 1) / grain;
+    state->remaining_chunks = state->num_chunks;
+
+    const auto run_chunks = [state, begin, end, grain, &body]() {
+      size_t chunk;
+      while ((chunk = state->next_chunk.fetch_add(1)) < state->num_chunks) {
+        std::exception_ptr exception;
+        try {
+          const size_t chunk_end = std::min(begin + (chunk + 1) * grain, end);
+          for (size_t index = begin + chunk * grain; index < chunk_end; ++index) {
+            body(index);
+          }
+        } catch (...) {
+          exception = std::current_exception();
+        }
+        std::lock_guard<std::mutex> lock(state->mutex);
+        if (exception && !state->exception) {
+          state->exception = exception;
+        }
+        if (--state->remaining_chunks == 0) {
+          state->condition.notify_all();
+        }
+      }
+    };
+
+    // the helpers which start after the last chunk was taken return without touching the body
+    const size_t num_helpers = std::min(state->num_chunks - 1, size());
+    for (size_t i = 0; i < num_helpers; ++i) {
+      post(Task(run_chunks));
+    }
+    run_chunks();
+
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->condition.wait(lock, [&state]() { return state->remaining_chunks == 0; });
+    if (state->exception) {
+      std::rethrow_exception(state->exception);
+    }
+  }
+
+private:
+  struct Worker
+  {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+  };
+
+  void run(const size_t index);
+  bool pop_task(const size_t index, Task & task);
+
+  std::vector<std::unique_ptr<Worker>> workers_;
+  std::vector<std::thread> threads_;
+  std::atomic<size_t> next_worker_{0};
+  std::atomic<size_t> pending_count_{0};
+  std::mutex sleep_mutex_;
+  std::condition_variable sleep_condition_;
+  bool stop_requested_{false};
+};
+
+struct TaskStatistics
+{
+  std::atomic<uint64_t> submitted_count{0};
+  std::atomic<uint64_t> completed_count{0};
+  std::atomic<uint64_t> execution_time{0};  // [ns] of wall time
+  // from the submission to the start of the execution
+  LatencyHistogram queueing_delay;
+};
+
+/**
+ * @brief Waitable running the callbacks posted by other threads, e.g. the completions of tasks and
+ * the coalesced timers, on the executor of a node, so that they can publish and touch the state of
+ * the node like any other callback.
+ */
+class TaskCompletionQueue : public rclcpp::Waitable
+{
+public:
+  AUTOWARE_NODE_PUBLIC explicit TaskCompletionQueue(rclcpp::Context::SharedPtr context);
+
+  // thread-safe, wakes up the executor
+  AUTOWARE_NODE_PUBLIC void push(Task completion);
+
+  AUTOWARE_NODE_PUBLIC size_t get_number_of_ready_guard_conditions() override { return 1; }
+  AUTOWARE_NODE_PUBLIC void add_to_wait_set(rcl_wait_set_t * wait_set) override;
+  AUTOWARE_NODE_PUBLIC bool is_ready(rcl_wait_set_t * wait_set) override;
+  AUTOWARE_NODE_PUBLIC std::shared_ptr<void> take_data() override;
+  AUTOWARE_NODE_PUBLIC void execute(std::shared_ptr<void> & data) override;
+
+private:
+  rclcpp::GuardCondition guard_condition_;
+  std::mutex mutex_;
+  std::deque<Task> completions_;
+};
+
+}  // namespace autoware::node
+
+#endif  // AUTOWARE__NODE__THREAD_POOL_HPP_
@@ -0,0 +1,58 @@
+// Copyright 2024 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__NODE__THREAD_PROFILE_HPP_
+#define AUTOWARE__NODE__THREAD_PROFILE_HPP_
+
+#include "autoware/node/visibility_control.hpp"
+
+#include <rclcpp/rclcpp.hpp>
+
+#include <string>
+#include <vector>
+
+namespace autoware::node
+{
+
+/**
+ * @brief Scheduling of a thread spinning callback groups.
+ */
+struct ThreadProfile
+{
+  std::string name;
+  // SCHED_FIFO priority in [1, 99], or 0 to keep the default time-sharing policy
+  int priority{0};
+  // CPUs the thread may run on, or empty for all of them
+  std::vector<int> cpu_affinity;
+};
+
+struct RealtimeCallbackGroup
+{
+  rclcpp::CallbackGroup::SharedPtr callback_group;
+  ThreadProfile profile;
+};
+
+/**
+ * @brief Apply the profile to the calling thread.
+ *
+ * A warning is logged and the thread keeps its current policy or affinity if they cannot be
+ * applied, for example without the CAP_SYS_NICE capability or the rtprio limit.
+ * @return true if the whole profile was applied
+ */
+AUTOWARE_NODE_PUBLIC bool apply_thread_profile(
+  const ThreadProfile & profile, const rclcpp::Logger & logger);
+
+}  // namespace autoware::node
+
+#endif  // AUTOWARE__NODE__THREAD_PROFILE_HPP_
@@ -0,0 +1,133 @@
+// Copyright 2024 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__NODE__TIMER_COALESCER_HPP_
+#define AUTOWARE__NODE__TIMER_COALESCER_HPP_
+
+#include "autoware/node/thread_pool.hpp"
+#include "autoware/node/visibility_control.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace autoware::node
+{
+
+/**
+ * @brief Periodic task of a node driven by the timer coalescer of the process.
+ *
+ * The callback is posted to the executor of the node at most once at a time: an expiration is
+ * skipped while the callback of the previous one has not run yet. Destroying the handle cancels
+ * the timer.
+ */
+class CoalescedTimer : public std::enable_shared_from_this<CoalescedTimer>
+{
+public:
+  using SharedPtr = std::shared_ptr<CoalescedTimer>;
+  // runs the task on the executor of the node
+  using PostFunction = std::function<void(Task)>;
+
+  AUTOWARE_NODE_PUBLIC CoalescedTimer(
+    const std::chrono::nanoseconds period, const std::chrono::nanoseconds tolerance,
+    std::function<void()> callback, PostFunction post);
+
+  void cancel() noexcept { canceled_.store(true); }
+  bool is_canceled() const noexcept { return canceled_.load(); }
+  std::chrono::nanoseconds get_period() const noexcept { return period_; }
+  std::chrono::nanoseconds get_tolerance() const noexcept { return tolerance_; }
+  // expirations dropped because the callback of the previous one had not run yet
+  uint64_t get_skipped_count() const noexcept { return skipped_count_.load(); }
+
+private:
+  friend class TimerCoalescer;
+
+  // false if the expiration was skipped
+  bool expire();
+
+  const std::chrono::nanoseconds period_;
+  const std::chrono::nanoseconds tolerance_;
+  const std::function<void()> callback_;
+  const PostFunction post_;
+  std::atomic<bool> canceled_{false};
+  std::atomic<bool> pending_{false};
+  std::atomic<uint64_t> skipped_count_{0};
+};
+
+struct TimerCoalescerStatistics
+{
+  // wakeups of the coalescer thread
+  uint64_t wakeup_count{0};
+  // expirations of the timers, i.e. the wakeups with a timer per task
+  uint64_t expiration_count{0};
+  uint64_t skipped_count{0};
+  // of the coalescer thread
+  int64_t voluntary_context_switches{0};
+  int64_t involuntary_context_switches{0};
+};
+
+/**
+ * @brief Single thread waking up for the periodic tasks of all the nodes of the process, e.g. of
+ * a container, instead of one timer per task in the wait sets of the executors.
+ *
+ * The expirations are aligned to the multiples of the period on the steady clock, so that the
+ * tasks with the same period or with multiple periods expire together. A task may run up to its
+ * tolerance after its expiration: the thread wakes up at the earliest end of the tolerances of the
+ * pending expirations, and posts all the expired tasks at once.
+ */
+class TimerCoalescer
+{
+public:
+  AUTOWARE_NODE_PUBLIC TimerCoalescer();
+  AUTOWARE_NODE_PUBLIC ~TimerCoalescer();
+
+  TimerCoalescer(const TimerCoalescer &) = delete;
+  TimerCoalescer & operator=(const TimerCoalescer &) = delete;
+
+  AUTOWARE_NODE_PUBLIC static TimerCoalescer & get_instance();
+
+  AUTOWARE_NODE_PUBLIC void add(const CoalescedTimer::SharedPtr & timer);
+  AUTOWARE_NODE_PUBLIC TimerCoalescerStatistics get_statistics() const;
+  AUTOWARE_NODE_PUBLIC size_t get_timer_count() const;
+
+private:
+  struct Entry
+  {
+    std::weak_ptr<CoalescedTimer> timer;
+    std::chrono::steady_clock::time_point expiration;
+  };
+
+  void run();
+
+  mutable std::mutex mutex_;
+  std::condition_variable condition_;
+  std::vector<Entry> entries_;
+  bool stop_requested_{false};
+  std::atomic<uint64_t> wakeup_count_{0};
+  std::atomic<uint64_t> expiration_count_{0};
+  std::atomic<uint64_t> skipped_count_{0};
+  std::atomic<int64_t> voluntary_context_switches_{0};
+  std::atomic<int64_t> involuntary_context_switches_{0};
+  std::thread thread_;
+};
+
+}  // namespace autoware::node
+
+#endif  // AUTOWARE__NODE__TIMER_COALESCER_HPP_
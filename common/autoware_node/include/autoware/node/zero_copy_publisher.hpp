@@ -0,0 +1,118 @@
+// Copyright 2024 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__NODE__ZERO_COPY_PUBLISHER_HPP_
+#define AUTOWARE__NODE__ZERO_COPY_PUBLISHER_HPP_
+
+#include <rclcpp/rclcpp.hpp>
+#include <rclcpp_lifecycle/lifecycle_publisher.hpp>
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+namespace autoware::node
+{
+
+/**
+ * @brief Lifecycle publisher favoring the move of std::unique_ptr messages to intra-process
+ * subscriptions.
+ *
+ * Publishing a std::unique_ptr hands the message over to a single intra-process subscription
+ * without any copy. A warning is logged, at most once per second and only when the numbers of
+ * subscriptions change, if a copy or a serialization is forced because of multiple intra-process
+ * subscriptions, inter-process subscriptions or a const reference publish.
+ */
+template <typename MessageT>
+class ZeroCopyPublisher
+{
+public:
+  using SharedPtr = std::shared_ptr<ZeroCopyPublisher<MessageT>>;
+  using PublisherT = rclcpp_lifecycle::LifecyclePublisher<MessageT>;
+
+  ZeroCopyPublisher(std::shared_ptr<PublisherT> publisher, const rclcpp::Logger & logger)
+  : publisher_(std::move(publisher)), logger_(logger)
+  {
+  }
+
+  std::unique_ptr<MessageT> make_message() const { return std::make_unique<MessageT>(); }
+
+  void publish(std::unique_ptr<MessageT> message)
+  {
+    check_copy(false);
+    publisher_->publish(std::move(message));
+  }
+
+  void publish(const MessageT & message)
+  {
+    check_copy(true);
+    publisher_->publish(message);
+  }
+
+  bool is_activated() const { return publisher_->is_activated(); }
+  const std::shared_ptr<PublisherT> & get_publisher() const { return publisher_; }
+
+private:
+  void check_copy(const bool published_by_reference)
+  {
+    std::unique_lock<std::mutex> lock(check_mutex_, std::try_to_lock);
+    if (!lock.owns_lock()) {
+      return;
+    }
+    const auto now = std::chrono::steady_clock::now();
+    if (now < next_check_time_) {
+      return;
+    }
+    next_check_time_ = now + std::chrono::seconds(1);
+
+    const size_t intra_process_count = publisher_->get_intra_process_subscription_count();
+    const size_t subscription_count = publisher_->get_subscription_count();
+    const size_t inter_process_count =
+      subscription_count > intra_process_count ? subscription_count - intra_process_count : 0;
+    const bool copied =
+      (published_by_reference && intra_process_count > 0) || intra_process_count > 1;
+    const bool serialized = inter_process_count > 0;
+    if (
+      intra_process_count == last_intra_process_count_ &&
+      inter_process_count == last_inter_process_count_ &&
+      published_by_reference == last_published_by_reference_) {
+      return;
+    }
+    last_intra_process_count_ = intra_process_count;
+    last_inter_process_count_ = inter_process_count;
+    last_published_by_reference_ = published_by_reference;
+
+    if (copied || serialized) {
+      RCLCPP_WARN(
+        logger_,
+        "Messages on %s are not delivered without copy: %zu intra-process and %zu inter-process "
+        "subscriptions, published by %s.",
+        publisher_->get_topic_name(), intra_process_count, inter_process_count,
+        published_by_reference ? "const reference" : "unique_ptr");
+    }
+  }
+
+  std::shared_ptr<PublisherT> publisher_;
+  rclcpp::Logger logger_;
+  std::mutex check_mutex_;
+  std::chrono::steady_clock::time_point next_check_time_{};
+  size_t last_intra_process_count_{0};
+  size_t last_inter_process_count_{0};
+  bool last_published_by_reference_{false};
+};
+
+}  // namespace autoware::node
+
+#endif  // AUTOWARE__NODE__ZERO_COPY_PUBLISHER_HPP_
@@ -0,0 +1,122 @@
+// Copyright 2024 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "thread_specific.hpp"
+
+#include <autoware/node/allocation_monitor.hpp>
+
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+
+namespace autoware::node
+{
+
+namespace
+{
+const ThreadSpecific<AllocationMonitor> thread_monitor;
+std::atomic<bool> hook_installed{false};
+
+int64_t now_ns() noexcept
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+           std::chrono::steady_clock::now().time_since_epoch())
+    .count();
+}
+}  // namespace
+
+AllocationMonitor::AllocationMonitor(
+  const AllocationPolicy policy, const std::chrono::nanoseconds warmup) noexcept
+: policy_(policy), warmup_(warmup)
+{
+}
+
+void AllocationMonitor::arm() noexcept
+{
+  armed_time_.store(now_ns() + warmup_.count());
+  armed_.store(true);
+}
+
+void AllocationMonitor::disarm() noexcept
+{
+  armed_.store(false);
+}
+
+bool AllocationMonitor::is_armed() const noexcept
+{
+  return armed_.load();
+}
+
+uint64_t AllocationMonitor::get_allocation_count() const noexcept
+{
+  return allocation_count_.load();
+}
+
+std::size_t AllocationMonitor::get_last_allocation_size() const noexcept
+{
+  return last_allocation_size_.load();
+}
+
+void AllocationMonitor::reset() noexcept
+{
+  allocation_count_.store(0);
+  last_allocation_size_.store(0);
+}
+
+void AllocationMonitor::set_thread_monitor(AllocationMonitor * monitor) noexcept
+{
+  thread_monitor.set(monitor);
+}
+
+AllocationMonitor * AllocationMonitor::get_thread_monitor() noexcept
+{
+  return thread_monitor.get();
+}
+
+void AllocationMonitor::on_allocation(const std::size_t size) noexcept
+{
+  if (!hook_installed.load(std::memory_order_relaxed)) {
+    hook_installed.store(true, std::memory_order_relaxed);
+  }
+  if (AllocationMonitor * monitor = thread_monitor.get()) {
+    monitor->record(size);
+  }
+}
+
+bool AllocationMonitor::is_hook_installed() noexcept
+{
+  return hook_installed.load();
+}
+
+void AllocationMonitor::record(const std::size_t size) noexcept
+{
+  if (!armed_.load(std::memory_order_relaxed)) {
+    return;
+  }
+  if (now_ns() < armed_time_.load(std::memory_order_relaxed)) {
+    return;
+  }
+  allocation_count_.fetch_add(1, std::memory_order_relaxed);
+  last_allocation_size_.store(size, std::memory_order_relaxed);
+
+  if (policy_ == AllocationPolicy::Abort) {
+    constexpr char message[] = "autoware_node: heap allocation on a real-time thread, aborting\n";
+    [[maybe_unused]] const auto written = write(STDERR_FILENO, message, sizeof(message) - 1);
+    std::abort();
+  }
+}
+
+}  // namespace autoware::node
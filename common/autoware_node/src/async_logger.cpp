@@ -0,0 +1,152 @@
+// Copyright 2024 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <autoware/node/async_logger.hpp>
+
+#include <rcutils/logging.h>
+#include <rcutils/logging_macros.h>
+
+#include <chrono>
+#include <cstdarg>
+#include <cstdio>
+#include <mutex>
+
+namespace autoware::node
+{
+
+namespace
+{
+// the queue is drained at least this often when nobody waits for a flush
+constexpr auto flush_period = std::chrono::milliseconds(10);
+constexpr size_t max_message_size = 1024;
+
+// like rcutils_log, but with the timestamp of the record rather than the current time
+void output(
+  const rcutils_log_location_t * location, const int severity, const char * name,
+  const rcutils_time_point_value_t timestamp, const char * format, ...)
+{
+  const rcutils_logging_output_handler_t output_handler = rcutils_logging_get_output_handler();
+  if (!output_handler) {
+    return;
+  }
+  va_list args;
+  va_start(args, format);
+  output_handler(location, severity, name, timestamp, format, &args);
+  va_end(args);
+}
+}  // namespace
+
+AsyncLogBuffer & AsyncLogBuffer::get_instance()
+{
+  static AsyncLogBuffer instance;
+  return instance;
+}
+
+AsyncLogBuffer::AsyncLogBuffer() : cells_(std::make_unique<Cell[]>(capacity))
+{
+  for (size_t i = 0; i < capacity; ++i) {
+    cells_[i].sequence.store(i, std::memory_order_relaxed);
+  }
+  thread_ = std::thread([this]() { run(); });
+}
+
+AsyncLogBuffer::~AsyncLogBuffer()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_requested_ = true;
+  }
+  condition_.notify_all();
+  thread_.join();
+}
+
+void AsyncLogBuffer::flush()
+{
+  const size_t target = enqueue_position_.load(std::memory_order_acquire);
+  std::unique_lock<std::mutex> lock(mutex_);
+  flush_requested_ = true;
+  condition_.notify_all();
+  condition_.wait(lock, [&]() {
+    return stop_requested_ || dequeue_position_.load(std::memory_order_acquire) >= target;
+  });
+}
+
+void AsyncLogBuffer::run()
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    flush_requested_ = false;
+    lock.unlock();
+    while (write_records() > 0) {
+    }
+    lock.lock();
+    // the records pushed while writing are written at the next wakeup or flush
+    condition_.notify_all();
+    if (stop_requested_) {
+      break;
+    }
+    condition_.wait_for(
+      lock, flush_period, [this]() { return flush_requested_ || stop_requested_; });
+  }
+  lock.unlock();
+  write_records();
+}
+
+size_t AsyncLogBuffer::write_records()
+{
+  size_t count = 0;
+  char message[max_message_size];
+  while (true) {
+    const size_t position = dequeue_position_.load(std::memory_order_relaxed);
+    Cell & cell = cells_[position & (capacity - 1)];
+    if (cell.sequence.load(std::memory_order_acquire) != position + 1) {
+      break;
+    }
+
+    const LogRecord & record = cell.record;
+    record.format_function(record, message, sizeof(message));
+    const rcutils_log_location_t location{
+      record.site->function, record.site->file, record.site->line};
+    if (record.suppressed_count > 0) {
+      output(
+        &location, record.severity, record.logger_name, record.timestamp, "%s (%lu suppressed)",
+        message, static_cast<unsigned long>(record.suppressed_count));  // NOLINT
+    } else {
+      output(&location, record.severity, record.logger_name, record.timestamp, "%s", message);
+    }
+
+    cell.sequence.store(position + capacity, std::memory_order_release);
+    dequeue_position_.store(position + 1, std::memory_order_release);
+    ++count;
+  }
+
+  const uint64_t dropped_count = dropped_count_.load(std::memory_order_relaxed);
+  if (dropped_count != reported_dropped_count_) {
+    RCUTILS_LOG_WARN_NAMED(
+      "autoware_node.async_logger", "%lu log records were dropped because the queue was full.",
+      static_cast<unsigned long>(dropped_count - reported_dropped_count_));  // NOLINT
+    reported_dropped_count_ = dropped_count;
+  }
+  return count;
+}
+
+AsyncLogger::~AsyncLogger()
+{
+  // the pending records refer to the name of the logger
+  if (used_.load(std::memory_order_relaxed)) {
+    AsyncLogBuffer::get_instance().flush();
+  }
+}
+
+}  // namespace autoware::node
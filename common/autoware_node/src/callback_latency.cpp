@@ -0,0 +1,55 @@
+// Copyright 2024 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <autoware/node/callback_latency.hpp>
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace autoware::node
+{
+
+std::shared_ptr<CallbackLatencyStatistics> CallbackLatencyMonitor::add(const std::string & name)
+{
+  auto statistics = std::make_shared<CallbackLatencyStatistics>(name);
+  std::lock_guard<std::mutex> lock(mutex_);
+  statistics_.push_back(statistics);
+  return statistics;
+}
+
+std::vector<CallbackLatencySnapshot> CallbackLatencyMonitor::snapshot() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::vector<CallbackLatencySnapshot> snapshots;
+  snapshots.reserve(statistics_.size());
+  for (const auto & statistics : statistics_) {
+    snapshots.push_back(CallbackLatencySnapshot{
+      statistics->name, statistics->execution_time.snapshot(),
+      statistics->queueing_delay.snapshot()});
+  }
+  return snapshots;
+}
+
+void CallbackLatencyMonitor::reset()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (const auto & statistics : statistics_) {
+    statistics->execution_time.reset();
+    statistics->queueing_delay.reset();
+  }
+}
+
+}  // namespace autoware::node
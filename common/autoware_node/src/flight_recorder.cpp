@@ -0,0 +1,270 @@
+// Copyright 2024 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <autoware/node/flight_recorder.hpp>
+#include <rclcpp/rclcpp.hpp>
+#include <rcpputils/shared_library.hpp>
+#include <rosidl_typesupport_introspection_cpp/field_types.hpp>
+#include <rosidl_typesupport_introspection_cpp/identifier.hpp>
+#include <rosidl_typesupport_introspection_cpp/message_introspection.hpp>
+
+#include <rcutils/error_handling.h>
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <ctime>
+#include <exception>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace autoware::node
+{
+
+namespace
+{
+std::string sanitize(std::string name)
+{
+  std::replace_if(
+    name.begin(), name.end(),
+    [](const unsigned char c) { return !std::isalnum(c) && c != '_'; }, '_');
+  return name;
+}
+
+std::string get_timestamp()
+{
+  const std::time_t time = std::time(nullptr);
+  std::tm local_time{};
+  localtime_r(&time, &local_time);
+  char buffer[32];
+  std::strftime(buffer, sizeof(buffer), "%Y%m%d-%H%M%S", &local_time);
+  return buffer;
+}
+
+size_t get_primitive_size(const uint8_t type_id)
+{
+  namespace introspection = rosidl_typesupport_introspection_cpp;
+  switch (type_id) {
+    case introspection::ROS_TYPE_LONG_DOUBLE:
+      return sizeof(long double);
+    case introspection::ROS_TYPE_DOUBLE:
+    case introspection::ROS_TYPE_INT64:
+    case introspection::ROS_TYPE_UINT64:
+      return 8;
+    case introspection::ROS_TYPE_FLOAT:
+    case introspection::ROS_TYPE_INT32:
+    case introspection::ROS_TYPE_UINT32:
+      return 4;
+    case introspection::ROS_TYPE_WCHAR:
+    case introspection::ROS_TYPE_INT16:
+    case introspection::ROS_TYPE_UINT16:
+      return 2;
+    default:
+      return 1;
+  }
+}
+
+size_t get_members_dynamic_size(
+  const void * message, const rosidl_typesupport_introspection_cpp::MessageMembers & members)
+{
+  namespace introspection = rosidl_typesupport_introspection_cpp;
+  size_t size = 0;
+  for (uint32_t i = 0; i < members.member_count_; ++i) {
+    const introspection::MessageMember & member = members.members_[i];
+    const void * field = static_cast<const uint8_t *>(message) + member.offset_;
+    // the elements of fixed-size arrays are part of the message type
+    const bool is_sequence =
+      member.is_array_ && (member.array_size_ == 0 || member.is_upper_bound_);
+    const size_t count = member.is_array_ ? member.size_function(field) : 1;
+    const auto get_element = [&member, field](const size_t index) {
+      return member.is_array_ ? member.get_const_function(field, index) : field;
+    };
+
+    switch (member.type_id_) {
+      case introspection::ROS_TYPE_MESSAGE: {
+        const auto & nested_members =
+          *static_cast<const introspection::MessageMembers *>(member.members_->data);
+        size += is_sequence ? count * nested_members.size_of_ : 0;
+        for (size_t index = 0; index < count; ++index) {
+          size += get_members_dynamic_size(get_element(index), nested_members);
+        }
+        break;
+      }
+      case introspection::ROS_TYPE_STRING:
+        size += is_sequence ? count * sizeof(std::string) : 0;
+        for (size_t index = 0; index < count; ++index) {
+          size += static_cast<const std::string *>(get_element(index))->size();
+        }
+        break;
+      case introspection::ROS_TYPE_WSTRING:
+        size += is_sequence ? count * sizeof(std::u16string) : 0;
+        for (size_t index = 0; index < count; ++index) {
+          size +=
+            static_cast<const std::u16string *>(get_element(index))->size() * sizeof(char16_t);
+        }
+        break;
+      default:
+        size += is_sequence ? count * get_primitive_size(member.type_id_) : 0;
+        break;
+    }
+  }
+  return size;
+}
+}  // namespace
+
+const rosidl_message_type_support_t * FlightRecorderTopic::get_introspection(
+  const rosidl_message_type_support_t * type_support)
+{
+  const rosidl_message_type_support_t * introspection =
+    type_support->func(type_support, rosidl_typesupport_introspection_cpp::typesupport_identifier);
+  if (!introspection) {
+    // the size of the message type alone is then the estimate
+    rcutils_reset_error();
+  }
+  return introspection;
+}
+
+size_t FlightRecorderTopic::get_dynamic_size(
+  const void * message, const rosidl_message_type_support_t * introspection)
+{
+  using rosidl_typesupport_introspection_cpp::MessageMembers;
+  return get_members_dynamic_size(
+    message, *static_cast<const MessageMembers *>(introspection->data));
+}
+
+std::vector<FlightRecord> FlightRecorderTopic::get_records(const int64_t since) const
+{
+  std::vector<FlightRecord> records;
+  std::lock_guard<std::mutex> lock(mutex_);
+  records.reserve(size_);
+  for (size_t i = 0; i < size_; ++i) {
+    const FlightRecord & record = records_[(first_index_ + i) % records_.size()];
+    if (record.time >= since) {
+      records.push_back(record);
+    }
+  }
+  return records;
+}
+
+FlightRecorder::FlightRecorder(
+  std::string node_name, std::string directory, const std::chrono::nanoseconds duration,
+  const rclcpp::Logger & logger)
+: node_name_(std::move(node_name)),
+  directory_(std::move(directory)),
+  duration_(duration),
+  logger_(logger)
+{
+  try {
+    writer_library_ = std::make_shared<rcpputils::SharedLibrary>(
+      rcpputils::get_platform_library_name("autoware_node_flight_recorder"));
+    create_writer_ = reinterpret_cast<CreateWriter>(
+      writer_library_->get_symbol("autoware_node_create_flight_recorder_writer"));
+  } catch (const std::exception & e) {
+    writer_library_.reset();
+    RCLCPP_ERROR(
+      logger_, "Flight recorder cannot write bags without autoware_node_flight_recorder: %s",
+      e.what());
+  }
+  thread_ = std::thread([this]() { run(); });
+}
+
+FlightRecorder::~FlightRecorder()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_requested_ = true;
+  }
+  condition_.notify_all();
+  thread_.join();
+}
+
+std::string FlightRecorder::snapshot(const std::string & reason)
+{
+  const int64_t since = now() - duration_.count();
+
+  Snapshot snapshot;
+  std::lock_guard<std::mutex> lock(mutex_);
+  snapshot.path = directory_ + "/" + sanitize(node_name_) + "_" + get_timestamp() + "_" +
+                  std::to_string(snapshot_count_++) + "_" + sanitize(reason);
+  for (const auto & topic : topics_) {
+    snapshot.topics.emplace_back(topic, topic->get_records(since));
+  }
+  const std::string path = snapshot.path;
+  snapshots_.push_back(std::move(snapshot));
+  condition_.notify_all();
+  return path;
+}
+
+void FlightRecorder::wait_for_snapshots()
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+  condition_.wait(lock, [this]() { return snapshots_.empty() && !writing_; });
+}
+
+void FlightRecorder::run()
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    condition_.wait(lock, [this]() { return stop_requested_ || !snapshots_.empty(); });
+    // the requested snapshots are still written on destruction
+    if (snapshots_.empty()) {
+      break;
+    }
+    Snapshot snapshot = std::move(snapshots_.front());
+    snapshots_.pop_front();
+    writing_ = true;
+    lock.unlock();
+    write(snapshot);
+    // the messages are released outside of the lock
+    snapshot.topics.clear();
+    lock.lock();
+    writing_ = false;
+    condition_.notify_all();
+  }
+}
+
+void FlightRecorder::write(const Snapshot & snapshot) const
+{
+  if (!create_writer_) {
+    RCLCPP_ERROR(
+      logger_, "Flight recorder cannot write %s without a writer.", snapshot.path.c_str());
+    return;
+  }
+  try {
+    std::filesystem::create_directories(directory_);
+    const std::unique_ptr<FlightRecorderWriter> writer(create_writer_());
+    writer->open(snapshot.path);
+
+    size_t count = 0;
+    rclcpp::SerializedMessage serialized;
+    for (const auto & [topic, records] : snapshot.topics) {
+      writer->create_topic(topic->get_topic_name(), topic->get_type_name());
+      for (const auto & record : records) {
+        topic->serialize(record.message.get(), serialized);
+        writer->write(serialized, topic->get_topic_name(), topic->get_type_name(), record.time);
+        ++count;
+      }
+    }
+    RCLCPP_INFO(logger_, "Flight recorder wrote %zu messages to %s.", count, snapshot.path.c_str());
+  } catch (const std::exception & e) {
+    RCLCPP_ERROR(
+      logger_, "Flight recorder failed to write %s: %s", snapshot.path.c_str(), e.what());
+  }
+}
+
+}  // namespace autoware::node
@@ -0,0 +1,86 @@
+// Copyright 2024 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <autoware/node/latency_budget.hpp>
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace autoware::node
+{
+
+namespace
+{
+struct OriginContext
+{
+  int64_t origin{0};
+  int64_t start{0};
+};
+
+thread_local OriginContext current_context;
+}  // namespace
+
+LatencyBudgetMonitor::OriginScope::OriginScope(const int64_t origin, const int64_t start) noexcept
+: previous_origin_(current_context.origin), previous_start_(current_context.start)
+{
+  current_context.origin = origin;
+  current_context.start = start;
+}
+
+LatencyBudgetMonitor::OriginScope::~OriginScope()
+{
+  current_context.origin = previous_origin_;
+  current_context.start = previous_start_;
+}
+
+int64_t LatencyBudgetMonitor::get_current_origin() noexcept
+{
+  return current_context.origin;
+}
+
+int64_t LatencyBudgetMonitor::get_current_start() noexcept
+{
+  return current_context.start;
+}
+
+std::shared_ptr<LatencyBudgetStatistics> LatencyBudgetMonitor::add(
+  const std::string & name, const int64_t budget)
+{
+  auto statistics = std::make_shared<LatencyBudgetStatistics>(name, budget);
+  std::lock_guard<std::mutex> lock(mutex_);
+  statistics_.push_back(statistics);
+  return statistics;
+}
+
+std::vector<LatencyBudgetSnapshot> LatencyBudgetMonitor::snapshot() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::vector<LatencyBudgetSnapshot> snapshots;
+  snapshots.reserve(statistics_.size());
+  for (const auto & statistics : statistics_) {
+    LatencyBudgetSnapshot snapshot;
+    snapshot.name = statistics->name;
+    snapshot.budget = statistics->budget;
+    snapshot.hop_latency = statistics->hop_latency.snapshot();
+    snapshot.cumulative_latency = statistics->cumulative_latency.snapshot();
+    snapshot.overrun_count = statistics->overrun_count.load(std::memory_order_relaxed);
+    snapshots.push_back(std::move(snapshot));
+  }
+  return snapshots;
+}
+
+}  // namespace autoware::node
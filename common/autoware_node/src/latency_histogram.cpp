@@ -0,0 +1,116 @@
+// Copyright 2024 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <autoware/node/latency_histogram.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+namespace autoware::node
+{
+
+uint64_t LatencyHistogramSnapshot::percentile(const double percentile) const
+{
+  if (count == 0) {
+    return 0;
+  }
+  const auto rank = static_cast<uint64_t>(
+    std::ceil(std::clamp(percentile, 0.0, 100.0) / 100.0 * static_cast<double>(count)));
+  uint64_t accumulated = 0;
+  for (std::size_t i = 0; i < bucket_counts.size(); ++i) {
+    accumulated += bucket_counts[i];
+    if (accumulated >= std::max<uint64_t>(rank, 1)) {
+      return std::min(LatencyHistogram::to_bucket_upper_bound(i), max);
+    }
+  }
+  return max;
+}
+
+std::size_t LatencyHistogram::to_bucket_index(const uint64_t value) noexcept
+{
+  constexpr uint64_t sub_bucket_count = 1ULL << sub_bucket_bits;
+  if (value < sub_bucket_count) {
+    return static_cast<std::size_t>(value);
+  }
+  const auto magnitude = static_cast<uint32_t>(63 - __builtin_clzll(value));
+  if (magnitude >= max_magnitude) {
+    return num_buckets - 1;
+  }
+  const uint64_t sub_bucket = (value >> (magnitude - sub_bucket_bits)) & (sub_bucket_count - 1);
+  return static_cast<std::size_t>(
+    ((magnitude - sub_bucket_bits + 1) << sub_bucket_bits) | sub_bucket);
+}
+
+uint64_t LatencyHistogram::to_bucket_upper_bound(const std::size_t index) noexcept
+{
+  constexpr uint64_t sub_bucket_count = 1ULL << sub_bucket_bits;
+  if (index < sub_bucket_count) {
+    return index;
+  }
+  const uint64_t shift = (index >> sub_bucket_bits) - 1;
+  const uint64_t lower_bound = (sub_bucket_count + (index & (sub_bucket_count - 1))) << shift;
+  return lower_bound + (1ULL << shift) - 1;
+}
+
+void LatencyHistogram::record(const uint64_t value) noexcept
+{
+  bucket_counts_[to_bucket_index(value)].fetch_add(1, std::memory_order_relaxed);
+  count_.fetch_add(1, std::memory_order_relaxed);
+  sum_.fetch_add(value, std::memory_order_relaxed);
+
+  // the min and max rarely change, so a plain load avoids most of the compare-and-swap
+  uint64_t min = min_.load(std::memory_order_relaxed);
+  while (value < min && !min_.compare_exchange_weak(min, value, std::memory_order_relaxed)) {
+  }
+  uint64_t max = max_.load(std::memory_order_relaxed);
+  while (value > max && !max_.compare_exchange_weak(max, value, std::memory_order_relaxed)) {
+  }
+}
+
+LatencyHistogramSnapshot LatencyHistogram::snapshot() const
+{
+  // the fields are read one by one, so records running concurrently may be partially included
+  LatencyHistogramSnapshot snapshot;
+  snapshot.bucket_counts.resize(num_buckets);
+  uint64_t count = 0;
+  for (std::size_t i = 0; i < num_buckets; ++i) {
+    snapshot.bucket_counts[i] = bucket_counts_[i].load(std::memory_order_relaxed);
+    count += snapshot.bucket_counts[i];
+  }
+  snapshot.count = count;
+  if (count == 0) {
+    return snapshot;
+  }
+  snapshot.min = min_.load(std::memory_order_relaxed);
+  snapshot.max = max_.load(std::memory_order_relaxed);
+  const uint64_t recorded_count = count_.load(std::memory_order_relaxed);
+  snapshot.mean = recorded_count == 0 ? 0.0
+                                      : static_cast<double>(sum_.load(std::memory_order_relaxed)) /
+                                          static_cast<double>(recorded_count);
+  return snapshot;
+}
+
+void LatencyHistogram::reset() noexcept
+{
+  for (auto & bucket_count : bucket_counts_) {
+    bucket_count.store(0, std::memory_order_relaxed);
+  }
+  count_.store(0, std::memory_order_relaxed);
+  sum_.store(0, std::memory_order_relaxed);
+  min_.store(UINT64_MAX, std::memory_order_relaxed);
+  max_.store(0, std::memory_order_relaxed);
+}
+
+}  // namespace autoware::node
@@ -0,0 +1,163 @@
+// Copyright 2024 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <autoware/node/lifecycle_manager.hpp>
+#include <autoware/node/node.hpp>
+#include <rclcpp/rclcpp.hpp>
+
+#include <unistd.h>
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace autoware::node
+{
+
+namespace
+{
+lifecycle_msgs::msg::State to_state_msg(const rclcpp_lifecycle::State & state)
+{
+  lifecycle_msgs::msg::State msg;
+  msg.id = state.id();
+  msg.label = state.label();
+  return msg;
+}
+}  // namespace
+
+std::shared_ptr<LifecycleManager> LifecycleManager::get_instance(
+  const rclcpp::Context::SharedPtr & context)
+{
+  static std::mutex instance_mutex;
+  static std::weak_ptr<LifecycleManager> instance;
+
+  std::lock_guard<std::mutex> lock(instance_mutex);
+  auto manager = instance.lock();
+  if (!manager) {
+    manager.reset(new LifecycleManager(context));
+    instance = manager;
+  }
+  return manager;
+}
+
+LifecycleManager::LifecycleManager(const rclcpp::Context::SharedPtr & context) : context_(context)
+{
+  // the endpoint itself has no parameter services, to keep the discovery traffic low
+  node_ = std::make_shared<rclcpp::Node>(
+    "lifecycle_manager_" + std::to_string(getpid()), "/autoware_node",
+    rclcpp::NodeOptions()
+      .context(context)
+      .start_parameter_services(false)
+      .start_parameter_event_publisher(false));
+  using std::placeholders::_1;
+  using std::placeholders::_2;
+  change_state_service_ = node_->create_service<autoware_node_msgs::srv::ChangeNodeState>(
+    "~/change_state", std::bind(&LifecycleManager::on_change_state, this, _1, _2));
+  get_states_service_ = node_->create_service<autoware_node_msgs::srv::GetNodeStates>(
+    "~/get_states", std::bind(&LifecycleManager::on_get_states, this, _1, _2));
+
+  executor_ = std::make_shared<rclcpp::executors::SingleThreadedExecutor>();
+  stop_requested_ = std::make_shared<std::atomic<bool>>(false);
+  executor_->add_node(node_);
+  thread_ = std::thread(
+    [context = context_, node = node_, executor = executor_, stop_requested = stop_requested_]() {
+      while (!*stop_requested && rclcpp::ok(context)) {
+        executor->spin_once(std::chrono::milliseconds(100));
+      }
+    });
+}
+
+LifecycleManager::~LifecycleManager()
+{
+  *stop_requested_ = true;
+  executor_->cancel();
+  // the last node was released by a transition on the thread, which stops after it
+  if (thread_.get_id() == std::this_thread::get_id()) {
+    thread_.detach();
+  } else {
+    thread_.join();
+  }
+}
+
+void LifecycleManager::add_node(const std::shared_ptr<Node> & node)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  nodes_[node->get_fully_qualified_name()] = node;
+}
+
+void LifecycleManager::remove_node(const Node & node)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  const auto it = nodes_.find(node.get_fully_qualified_name());
+  // the weak pointer has expired if the node is being destroyed
+  if (it != nodes_.end() && (it->second.expired() || it->second.lock().get() == &node)) {
+    nodes_.erase(it);
+  }
+}
+
+std::string LifecycleManager::get_fully_qualified_name() const
+{
+  return node_->get_fully_qualified_name();
+}
+
+void LifecycleManager::on_change_state(
+  const autoware_node_msgs::srv::ChangeNodeState::Request::SharedPtr request,
+  const autoware_node_msgs::srv::ChangeNodeState::Response::SharedPtr response)
+{
+  std::shared_ptr<Node> node;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto it = nodes_.find(request->node_name);
+    if (it != nodes_.end()) {
+      node = it->second.lock();
+    }
+  }
+  if (!node) {
+    RCLCPP_WARN(
+      node_->get_logger(), "Node %s is not registered with the lifecycle manager.",
+      request->node_name.c_str());
+    response->success = false;
+    return;
+  }
+  CallbackReturn callback_return = CallbackReturn::ERROR;
+  const auto state = node->trigger_transition(request->transition_id, callback_return);
+  response->success = callback_return == CallbackReturn::SUCCESS;
+  response->state = to_state_msg(state);
+}
+
+void LifecycleManager::on_get_states(
+  const autoware_node_msgs::srv::GetNodeStates::Request::SharedPtr,
+  const autoware_node_msgs::srv::GetNodeStates::Response::SharedPtr response)
+{
+  std::vector<std::pair<std::string, std::shared_ptr<Node>>> nodes;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto & [name, weak_node] : nodes_) {
+      if (auto node = weak_node.lock()) {
+        nodes.emplace_back(name, std::move(node));
+      }
+    }
+  }
+  for (const auto & [name, node] : nodes) {
+    response->node_names.push_back(name);
+    response->states.push_back(to_state_msg(node->get_current_state()));
+  }
+}
+
+}  // namespace autoware::node
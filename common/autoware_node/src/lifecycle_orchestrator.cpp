@@ -0,0 +1,183 @@
+// Copyright 2024 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <autoware/node/lifecycle_orchestrator.hpp>
+#include <rclcpp/rclcpp.hpp>
+
+#include <lifecycle_msgs/msg/state.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace autoware::node
+{
+
+namespace
+{
+using lifecycle_msgs::msg::State;
+
+// triggers the transition and returns whether the node reached its goal state, which is also the
+// case if it was already there
+bool trigger(Node & node, const LifecycleTransition transition)
+{
+  switch (transition) {
+    case LifecycleTransition::Configure:
+      return node.configure().id() == State::PRIMARY_STATE_INACTIVE;
+    case LifecycleTransition::Activate:
+      return node.activate().id() == State::PRIMARY_STATE_ACTIVE;
+    case LifecycleTransition::Deactivate:
+      return node.deactivate().id() == State::PRIMARY_STATE_INACTIVE;
+    case LifecycleTransition::Cleanup:
+      return node.cleanup().id() == State::PRIMARY_STATE_UNCONFIGURED;
+    case LifecycleTransition::Shutdown:
+      return node.shutdown().id() == State::PRIMARY_STATE_FINALIZED;
+  }
+  return false;
+}
+
+bool is_reversed(const LifecycleTransition transition)
+{
+  return transition != LifecycleTransition::Configure &&
+         transition != LifecycleTransition::Activate;
+}
+}  // namespace
+
+LifecycleOrchestrator::LifecycleOrchestrator(const std::size_t num_threads)
+: num_threads_(std::max<std::size_t>(num_threads, 1))
+{
+}
+
+void LifecycleOrchestrator::add_node(
+  const std::shared_ptr<Node> & node, const std::vector<std::string> & dependencies)
+{
+  const std::string name = node->get_fully_qualified_name();
+  if (!entries_.emplace(name, Entry{node, dependencies}).second) {
+    throw std::invalid_argument("node " + name + " has already been added");
+  }
+  names_.push_back(name);
+}
+
+std::vector<std::vector<std::shared_ptr<Node>>> LifecycleOrchestrator::get_waves() const
+{
+  // wave of each node, i.e. the length of its longest chain of dependencies
+  std::map<std::string, std::size_t> waves;
+  std::map<std::string, bool> visiting;
+  const std::function<std::size_t(const std::string &)> get_wave = [&](const std::string & name) {
+    const auto wave = waves.find(name);
+    if (wave != waves.end()) {
+      return wave->second;
+    }
+    const auto entry = entries_.find(name);
+    if (entry == entries_.end()) {
+      throw std::invalid_argument("unknown dependency " + name);
+    }
+    if (visiting[name]) {
+      throw std::invalid_argument("cyclic dependency on " + name);
+    }
+    visiting[name] = true;
+    std::size_t result = 0;
+    for (const auto & dependency : entry->second.dependencies) {
+      result = std::max(result, get_wave(dependency) + 1);
+    }
+    visiting[name] = false;
+    waves[name] = result;
+    return result;
+  };
+
+  std::vector<std::vector<std::shared_ptr<Node>>> result;
+  for (const auto & name : names_) {
+    const std::size_t wave = get_wave(name);
+    if (result.size() <= wave) {
+      result.resize(wave + 1);
+    }
+    result[wave].push_back(entries_.at(name).node);
+  }
+  return result;
+}
+
+OrchestrationResult LifecycleOrchestrator::transition(const LifecycleTransition transition)
+{
+  using std::chrono::steady_clock;
+  auto waves = get_waves();
+  if (is_reversed(transition)) {
+    std::reverse(waves.begin(), waves.end());
+  }
+
+  OrchestrationResult result;
+  const auto start = steady_clock::now();
+  for (const auto & wave : waves) {
+    WaveTiming timing;
+    std::mutex mutex;
+    std::atomic<std::size_t> next_index{0};
+    const auto worker = [&]() {
+      for (std::size_t i = next_index++; i < wave.size(); i = next_index++) {
+        Node & node = *wave[i];
+        const auto node_start = steady_clock::now();
+        // an exception would terminate the process when thrown on a worker thread
+        bool success = false;
+        try {
+          success = trigger(node, transition);
+        } catch (const std::exception & e) {
+          RCLCPP_ERROR(node.get_logger(), "Lifecycle transition threw: %s", e.what());
+        } catch (...) {
+          RCLCPP_ERROR(node.get_logger(), "Lifecycle transition threw an unknown exception.");
+        }
+        const auto node_duration = steady_clock::now() - node_start;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!success) {
+          result.failed_node_names.push_back(node.get_fully_qualified_name());
+        }
+        if (node_duration >= timing.slowest_duration) {
+          timing.slowest_duration = node_duration;
+          timing.slowest_node_name = node.get_fully_qualified_name();
+        }
+      }
+    };
+
+    const auto wave_start = steady_clock::now();
+    // the calling thread is one of the workers
+    std::vector<std::thread> threads;
+    for (std::size_t i = 1; i < std::min(num_threads_, wave.size()); ++i) {
+      threads.emplace_back(worker);
+    }
+    worker();
+    for (auto & thread : threads) {
+      thread.join();
+    }
+    timing.duration = steady_clock::now() - wave_start;
+
+    for (const auto & node : wave) {
+      timing.node_names.push_back(node->get_fully_qualified_name());
+    }
+    result.waves.push_back(timing);
+    if (!result.failed_node_names.empty()) {
+      result.success = false;
+      break;
+    }
+  }
+  result.duration = steady_clock::now() - start;
+  return result;
+}
+
+}  // namespace autoware::node
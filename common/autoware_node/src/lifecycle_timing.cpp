@@ -0,0 +1,154 @@
+// Copyright 2024 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <autoware/node/lifecycle_timing.hpp>
+#include <rclcpp/rclcpp.hpp>
+
+#include <builtin_interfaces/msg/duration.hpp>
+#include <builtin_interfaces/msg/time.hpp>
+
+#include <unistd.h>
+
+#include <chrono>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <utility>
+
+namespace autoware::node
+{
+
+namespace
+{
+builtin_interfaces::msg::Time to_time_msg(const std::chrono::system_clock::time_point time)
+{
+  const auto nanoseconds =
+    std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+  builtin_interfaces::msg::Time msg;
+  msg.sec = static_cast<int32_t>(nanoseconds / 1000000000);
+  msg.nanosec = static_cast<uint32_t>(nanoseconds % 1000000000);
+  return msg;
+}
+
+builtin_interfaces::msg::Duration to_duration_msg(const std::chrono::nanoseconds duration)
+{
+  builtin_interfaces::msg::Duration msg;
+  msg.sec = static_cast<int32_t>(duration.count() / 1000000000);
+  msg.nanosec = static_cast<uint32_t>(duration.count() % 1000000000);
+  return msg;
+}
+
+std::chrono::system_clock::time_point read_process_start_time()
+{
+  const auto now = std::chrono::system_clock::now();
+
+  // the start time is the 22nd field, in clock ticks since boot, after the command in parentheses
+  std::ifstream stat_file("/proc/self/stat");
+  const std::string stat(
+    (std::istreambuf_iterator<char>(stat_file)), std::istreambuf_iterator<char>());
+  const auto command_end = stat.rfind(')');
+  std::ifstream uptime_file("/proc/uptime");
+  double uptime = 0.0;
+  if (command_end == std::string::npos || !(uptime_file >> uptime)) {
+    return now;
+  }
+  std::istringstream fields(stat.substr(command_end + 1));
+  std::string field;
+  int index = 2;
+  while (index < 22 && fields >> field) {
+    ++index;
+  }
+  if (index < 22) {
+    return now;
+  }
+  const double start_time = std::stod(field) / static_cast<double>(sysconf(_SC_CLK_TCK));
+  return now - std::chrono::duration_cast<std::chrono::system_clock::duration>(
+                 std::chrono::duration<double>(uptime - start_time));
+}
+}  // namespace
+
+LifecycleTimingRecorder::LifecycleTimingRecorder(
+  const std::string & node_name, const TimingStart & construction_start)
+: construction_start_(construction_start)
+{
+  report_.node_name = node_name;
+  report_.process_start_time = to_time_msg(get_process_start_time());
+}
+
+void LifecycleTimingRecorder::set_publisher(
+  rclcpp::Publisher<LifecycleTimingReport>::SharedPtr publisher)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  publisher_ = std::move(publisher);
+}
+
+void LifecycleTimingRecorder::record_construction()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (construction_recorded_) {
+    return;
+  }
+  construction_recorded_ = true;
+  record_locked("construct", construction_start_, true);
+  construction_end_ = TimingStart::now();
+}
+
+void LifecycleTimingRecorder::record_derived_construction(const bool upper_bound)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!construction_recorded_ || derived_construction_recorded_) {
+    return;
+  }
+  derived_construction_recorded_ = true;
+  record_locked(
+    upper_bound ? "construct_derived_upper_bound" : "construct_derived", construction_end_, true);
+}
+
+void LifecycleTimingRecorder::record(
+  const std::string & label, const TimingStart & start, const bool success)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  record_locked(label, start, success);
+}
+
+void LifecycleTimingRecorder::record_locked(
+  const std::string & label, const TimingStart & start, const bool success)
+{
+  autoware_node_msgs::msg::TransitionTiming timing;
+  timing.label = label;
+  timing.start_time = to_time_msg(start.system_time);
+  timing.duration = to_duration_msg(std::chrono::steady_clock::now() - start.steady_time);
+  timing.success = success;
+  report_.transitions.push_back(timing);
+  if (publisher_) {
+    publisher_->publish(report_);
+  }
+}
+
+LifecycleTimingReport LifecycleTimingRecorder::get_report() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return report_;
+}
+
+std::chrono::system_clock::time_point LifecycleTimingRecorder::get_process_start_time()
+{
+  static const std::chrono::system_clock::time_point process_start_time =
+    read_process_start_time();
+  return process_start_time;
+}
+
+}  // namespace autoware::node
@@ -0,0 +1,226 @@
+// Copyright 2024 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Collects the lifecycle timing reports of the running nodes, e.g. of a launch file, and prints
+// where the startup time went, as well as the breakdown of the node which became ready last.
+//
+// usage: ros2 run autoware_node lifecycle_timing_aggregator --ros-args \
+//          -p wait_time:=10.0 -p expected_nodes:=1
+
+#include <rclcpp/rclcpp.hpp>
+
+#include <autoware_node_msgs/msg/lifecycle_timing_report.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <limits>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace
+{
+using autoware_node_msgs::msg::LifecycleTimingReport;
+using autoware_node_msgs::msg::TransitionTiming;
+
+constexpr char report_type[] = "autoware_node_msgs/msg/LifecycleTimingReport";
+
+double to_seconds(const builtin_interfaces::msg::Time & time)
+{
+  return time.sec + time.nanosec * 1e-9;
+}
+
+double to_seconds(const builtin_interfaces::msg::Duration & duration)
+{
+  return duration.sec + duration.nanosec * 1e-9;
+}
+
+double get_end_time(const TransitionTiming & timing)
+{
+  return to_seconds(timing.start_time) + to_seconds(timing.duration);
+}
+
+// the end of the last successful activation, or of the last transition if never activated
+double get_ready_time(const LifecycleTimingReport & report)
+{
+  double ready_time = to_seconds(report.process_start_time);
+  for (const auto & timing : report.transitions) {
+    if (timing.label == "activate" && timing.success) {
+      return get_end_time(timing);
+    }
+    ready_time = std::max(ready_time, get_end_time(timing));
+  }
+  return ready_time;
+}
+
+bool is_activated(const LifecycleTimingReport & report)
+{
+  return std::any_of(
+    report.transitions.begin(), report.transitions.end(), [](const TransitionTiming & timing) {
+      return timing.label == "activate" && timing.success;
+    });
+}
+
+double get_duration(const LifecycleTimingReport & report, const std::string & label)
+{
+  double duration = 0.0;
+  for (const auto & timing : report.transitions) {
+    if (timing.label == label) {
+      duration += to_seconds(timing.duration);
+    }
+  }
+  return duration;
+}
+
+class LifecycleTimingAggregator : public rclcpp::Node
+{
+public:
+  LifecycleTimingAggregator() : Node("lifecycle_timing_aggregator")
+  {
+    wait_time_ = declare_parameter<double>("wait_time", 5.0);
+    expected_nodes_ = declare_parameter<int64_t>("expected_nodes", 0);
+    start_time_ = std::chrono::steady_clock::now();
+    timer_ = create_wall_timer(std::chrono::milliseconds(200), [this]() { on_timer(); });
+  }
+
+  bool is_done() const { return done_; }
+
+  void print() const
+  {
+    if (reports_.empty()) {
+      std::printf("No lifecycle timing report was received.\n");
+      return;
+    }
+
+    double origin = std::numeric_limits<double>::max();
+    std::vector<const LifecycleTimingReport *> reports;
+    for (const auto & [name, report] : reports_) {
+      origin = std::min(origin, to_seconds(report.process_start_time));
+      reports.push_back(&report);
+    }
+    std::sort(reports.begin(), reports.end(), [](const auto a, const auto b) {
+      return get_ready_time(*a) < get_ready_time(*b);
+    });
+
+    std::printf(
+      "%-40s %10s %10s %10s %11s %10s %10s %10s\n", "node", "start[ms]", "load[ms]", "constr[ms]",
+      "derived[ms]", "config[ms]", "activ[ms]", "ready[ms]");
+    bool has_upper_bound = false;
+    for (const auto * report : reports) {
+      const double process_start = to_seconds(report->process_start_time);
+      double load = 0.0;
+      if (!report->transitions.empty()) {
+        load = to_seconds(report->transitions.front().start_time) - process_start;
+      }
+      // the construction of the derived class is an upper bound unless it called mark_constructed()
+      const double derived_upper_bound = get_duration(*report, "construct_derived_upper_bound");
+      has_upper_bound = has_upper_bound || derived_upper_bound > 0.0;
+      std::printf(
+        "%-40s %10.1f %10.1f %10.1f %10.1f%c %10.1f %10.1f %10.1f%s\n", report->node_name.c_str(),
+        (process_start - origin) * 1e3, load * 1e3, get_duration(*report, "construct") * 1e3,
+        (get_duration(*report, "construct_derived") + derived_upper_bound) * 1e3,
+        derived_upper_bound > 0.0 ? '*' : ' ', get_duration(*report, "configure") * 1e3,
+        get_duration(*report, "activate") * 1e3, (get_ready_time(*report) - origin) * 1e3,
+        is_activated(*report) ? "" : " (not active)");
+    }
+    if (has_upper_bound) {
+      std::printf(
+        "* upper bound, until the first transition or the registration with the lifecycle manager, "
+        "as the node does not call mark_constructed()\n");
+    }
+
+    // the node ready last bounds the startup, so break it down into consecutive segments
+    const LifecycleTimingReport & critical = *reports.back();
+    std::printf("\ncritical path: %s\n", critical.node_name.c_str());
+    double time = origin;
+    const auto print_segment = [&time, origin](const std::string & label, const double end) {
+      std::printf(
+        "  %-24s %10.1f ms  (at %.1f ms)\n", label.c_str(), (end - time) * 1e3,
+        (end - origin) * 1e3);
+      time = end;
+    };
+    print_segment("launch until process", to_seconds(critical.process_start_time));
+    for (const auto & timing : critical.transitions) {
+      const double start = to_seconds(timing.start_time);
+      if (start > time) {
+        print_segment(timing.label == "construct" ? "load" : "wait", start);
+      }
+      print_segment(timing.label + (timing.success ? "" : " (failed)"), get_end_time(timing));
+      if (timing.label == "activate" && timing.success) {
+        break;
+      }
+    }
+    std::printf("  %-24s %10.1f ms\n", "total", (time - origin) * 1e3);
+  }
+
+private:
+  void on_timer()
+  {
+    subscribe_to_new_reports();
+    const bool all_activated =
+      expected_nodes_ > 0 && reports_.size() >= static_cast<size_t>(expected_nodes_) &&
+      std::all_of(reports_.begin(), reports_.end(), [](const auto & report) {
+        return is_activated(report.second);
+      });
+    const double elapsed =
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time_).count();
+    if (all_activated || elapsed > wait_time_) {
+      done_ = true;
+    }
+  }
+
+  void subscribe_to_new_reports()
+  {
+    for (const auto & [topic_name, types] : get_topic_names_and_types()) {
+      if (
+        subscribed_topics_.count(topic_name) > 0 ||
+        std::find(types.begin(), types.end(), report_type) == types.end()) {
+        continue;
+      }
+      subscribed_topics_.insert(topic_name);
+      subscriptions_.push_back(create_subscription<LifecycleTimingReport>(
+        topic_name, rclcpp::QoS(1).reliable().transient_local(),
+        [this](const LifecycleTimingReport::ConstSharedPtr report) {
+          reports_[report->node_name] = *report;
+        }));
+    }
+  }
+
+  double wait_time_;
+  int64_t expected_nodes_;
+  std::chrono::steady_clock::time_point start_time_;
+  bool done_{false};
+  rclcpp::TimerBase::SharedPtr timer_;
+  std::set<std::string> subscribed_topics_;
+  std::vector<rclcpp::Subscription<LifecycleTimingReport>::SharedPtr> subscriptions_;
+  std::map<std::string, LifecycleTimingReport> reports_;
+};
+}  // namespace
+
+int main(int argc, char ** argv)
+{
+  rclcpp::init(argc, argv);
+  auto aggregator = std::make_shared<LifecycleTimingAggregator>();
+  rclcpp::executors::SingleThreadedExecutor executor;
+  executor.add_node(aggregator);
+  while (rclcpp::ok() && !aggregator->is_done()) {
+    executor.spin_once(std::chrono::milliseconds(100));
+  }
+  aggregator->print();
+  rclcpp::shutdown();
+  return 0;
+}
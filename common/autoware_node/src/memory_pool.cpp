@@ -0,0 +1,133 @@
+// Copyright 2024 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <autoware/node/memory_pool.hpp>
+#include <rclcpp/rclcpp.hpp>
+
+#include <malloc.h>
+#include <sys/mman.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <new>
+
+namespace autoware::node
+{
+
+namespace
+{
+constexpr std::size_t page_size = 4096;
+
+std::size_t bit_ceil_log2(const std::size_t value)
+{
+  std::size_t log2 = 0;
+  while ((std::size_t{1} << log2) < value) {
+    ++log2;
+  }
+  return log2;
+}
+}  // namespace
+
+MemoryPool::MemoryPool(
+  const std::size_t capacity, const std::size_t max_block_size,
+  std::pmr::memory_resource * upstream)
+: capacity_(capacity),
+  max_block_size_(std::min(max_block_size, capacity)),
+  upstream_(upstream),
+  arena_(new std::byte[capacity])
+{
+  // touch every page, so that they are mapped now rather than on first use
+  std::memset(arena_.get(), 0, capacity_);
+}
+
+std::size_t MemoryPool::get_used_size() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return arena_offset_ - free_size_;
+}
+
+std::size_t MemoryPool::to_size_class(
+  const std::size_t bytes, const std::size_t alignment) const noexcept
+{
+  return bit_ceil_log2(std::max({bytes, alignment, min_block_size}));
+}
+
+void * MemoryPool::do_allocate(const std::size_t bytes, const std::size_t alignment)
+{
+  const std::size_t size_class = to_size_class(bytes, alignment);
+  const std::size_t block_size = std::size_t{1} << size_class;
+  if (block_size <= max_block_size_ && alignment <= page_size) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (FreeBlock * block = free_lists_[size_class]) {
+      free_lists_[size_class] = block->next;
+      free_size_ -= block_size;
+      return block;
+    }
+    // blocks are aligned to their size up to a page, which satisfies any smaller alignment
+    const std::size_t block_alignment = std::min(block_size, page_size);
+    const auto base = reinterpret_cast<std::uintptr_t>(arena_.get());
+    const std::size_t offset =
+      ((base + arena_offset_ + block_alignment - 1) & ~(block_alignment - 1)) - base;
+    if (offset + block_size <= capacity_) {
+      // the padding is lost, but only while the arena is being carved
+      free_size_ += offset - arena_offset_;
+      arena_offset_ = offset + block_size;
+      return arena_.get() + offset;
+    }
+  }
+  fallback_count_.fetch_add(1, std::memory_order_relaxed);
+  return upstream_->allocate(bytes, alignment);
+}
+
+void MemoryPool::do_deallocate(void * pointer, const std::size_t bytes, const std::size_t alignment)
+{
+  const auto address = static_cast<std::byte *>(pointer);
+  if (address < arena_.get() || address >= arena_.get() + capacity_) {
+    upstream_->deallocate(pointer, bytes, alignment);
+    return;
+  }
+  const std::size_t size_class = to_size_class(bytes, alignment);
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto block = static_cast<FreeBlock *>(pointer);
+  block->next = free_lists_[size_class];
+  free_lists_[size_class] = block;
+  free_size_ += std::size_t{1} << size_class;
+}
+
+bool MemoryPool::do_is_equal(const std::pmr::memory_resource & other) const noexcept
+{
+  return this == &other;
+}
+
+bool lock_memory(const rclcpp::Logger & logger)
+{
+  // keep freed memory in the heap, and serve large allocations from it rather than with mmap
+  mallopt(M_TRIM_THRESHOLD, -1);
+  mallopt(M_MMAP_MAX, 0);
+
+  if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+    RCLCPP_WARN(
+      logger,
+      "Failed to lock the memory of the process: %s. Grant CAP_IPC_LOCK or raise the memlock "
+      "limit to enable it.",
+      std::strerror(errno));
+    return false;
+  }
+  return true;
+}
+
+}  // namespace autoware::node
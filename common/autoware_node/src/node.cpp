@@ -12,26 +12,757 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <autoware/node/allocation_monitor.hpp>
+#include <autoware/node/lifecycle_manager.hpp>
+#include <autoware/node/memory_pool.hpp>
 #include <autoware/node/node.hpp>
+#include <rclcpp/parameter_map.hpp>
 #include <rclcpp/rclcpp.hpp>
+#include <rclcpp/strategies/allocator_memory_strategy.hpp>
 
+#include <rcl/arguments.h>
+#include <rcl/remap.h>
+#include <rcl_yaml_param_parser/parser.h>
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <optional>
 #include <string>
+#include <vector>
 
 namespace autoware::node
 {
+namespace
+{
+// start of the construction of the node, taken before the construction of LifecycleNode
+thread_local TimingStart construction_start;
+// switch of the lifecycle manager, resolved before the construction of LifecycleNode
+thread_local bool lifecycle_manager_enabled = false;
+
+const rclcpp::NodeOptions & mark_construction_start(const rclcpp::NodeOptions & options)
+{
+  construction_start = TimingStart::now();
+  return options;
+}
+
+// name of the node once the remapping rules of the arguments are applied, as by rcl_node_init
+std::string get_remapped_name(
+  const std::string & node_name, const std::string & ns, const rclcpp::NodeOptions & options)
+{
+  const rcl_arguments_t * local_arguments = &options.get_rcl_node_options()->arguments;
+  const rcl_arguments_t * global_arguments =
+    options.use_global_arguments() ? &options.context()->get_rcl_context()->global_arguments
+                                   : nullptr;
+  rcl_allocator_t allocator = rcl_get_default_allocator();
+  const auto remap = [&allocator](const std::string & name, char * remapped) {
+    if (!remapped) {
+      return name;
+    }
+    const std::string result(remapped);
+    allocator.deallocate(remapped, allocator.state);
+    return result;
+  };
+
+  char * remapped_name = nullptr;
+  char * remapped_ns = nullptr;
+  if (
+    rcl_remap_node_name(
+      local_arguments, global_arguments, node_name.c_str(), allocator, &remapped_name) !=
+    RCL_RET_OK) {
+    rcl_reset_error();
+  }
+  const std::string name = remap(node_name, remapped_name);
+  if (
+    rcl_remap_node_namespace(
+      local_arguments, global_arguments, name.c_str(), allocator, &remapped_ns) != RCL_RET_OK) {
+    rcl_reset_error();
+  }
+  std::string node_namespace = remap(ns, remapped_ns);
+  if (node_namespace.empty() || node_namespace.front() != '/') {
+    node_namespace = "/" + node_namespace;
+  }
+  return node_namespace.back() == '/' ? node_namespace + name : node_namespace + "/" + name;
+}
+
+// read before the construction of LifecycleNode, which creates the lifecycle services, with the
+// precedence of the parameter overrides: the global arguments, e.g. --params-file, the arguments
+// of the node, then the overrides of the options
+bool use_lifecycle_manager(
+  const std::string & node_name, const std::string & ns, const rclcpp::NodeOptions & options)
+{
+  constexpr char parameter_name[] = "lifecycle_manager.enabled";
+  for (auto it = options.parameter_overrides().rbegin();
+       it != options.parameter_overrides().rend(); ++it) {
+    if (it->get_name() == parameter_name) {
+      return it->get_type() == rclcpp::ParameterType::PARAMETER_BOOL && it->as_bool();
+    }
+  }
+
+  const std::string fully_qualified_name = get_remapped_name(node_name, ns, options);
+  const rcl_arguments_t * local_arguments = &options.get_rcl_node_options()->arguments;
+  const rcl_arguments_t * global_arguments =
+    options.use_global_arguments() ? &options.context()->get_rcl_context()->global_arguments
+                                   : nullptr;
+  std::optional<bool> enabled;
+  for (const rcl_arguments_t * arguments : {global_arguments, local_arguments}) {
+    rcl_params_t * parameters = nullptr;
+    if (!arguments || rcl_arguments_get_param_overrides(arguments, &parameters) != RCL_RET_OK) {
+      rcl_reset_error();
+      continue;
+    }
+    if (!parameters) {
+      continue;
+    }
+    const rclcpp::ParameterMap parameter_map =
+      rclcpp::parameter_map_from(parameters, fully_qualified_name.c_str());
+    rcl_yaml_node_struct_fini(parameters);
+    const auto node_parameters = parameter_map.find(fully_qualified_name);
+    if (node_parameters == parameter_map.end()) {
+      continue;
+    }
+    for (const auto & parameter : node_parameters->second) {
+      if (parameter.get_name() == parameter_name) {
+        enabled =
+          parameter.get_type() == rclcpp::ParameterType::PARAMETER_BOOL && parameter.as_bool();
+      }
+    }
+  }
+  return enabled.value_or(false);
+}
+
+bool resolve_lifecycle_manager_enabled(
+  const std::string & node_name, const std::string & ns, const rclcpp::NodeOptions & options)
+{
+  lifecycle_manager_enabled = use_lifecycle_manager(node_name, ns, options);
+  return lifecycle_manager_enabled;
+}
+
+// e.g. sensing.lidar.pointcloud for /sensing/lidar/pointcloud
+std::string to_parameter_key(const std::string & topic_name)
+{
+  std::string key = topic_name.substr(topic_name.rfind('/', 0) == 0 ? 1 : 0);
+  std::replace(key.begin(), key.end(), '/', '.');
+  return key;
+}
+}  // namespace
+
 Node::Node(
   const std::string & node_name, const std::string & ns, const rclcpp::NodeOptions & options)
-: LifecycleNode(node_name, ns, options)
+: LifecycleNode(
+    node_name, ns, mark_construction_start(options),
+    !resolve_lifecycle_manager_enabled(node_name, ns, options)),
+  callback_latency_monitor_(std::make_shared<CallbackLatencyMonitor>()),
+  latency_budget_monitor_(std::make_shared<LatencyBudgetMonitor>(get_clock())),
+  resource_account_(std::make_shared<ResourceAccount>()),
+  task_statistics_(std::make_shared<TaskStatistics>()),
+  async_logger_(std::make_unique<AsyncLogger>(get_logger().get_name()))
 {
-  RCLCPP_DEBUG(
-    get_logger(), "Node %s constructor was called.",
+  AUTOWARE_ASYNC_DEBUG(
+    *async_logger_, "Node %s constructor was called.",
     get_node_base_interface()->get_fully_qualified_name());
+
+  callback_latency_monitor_->set_enabled(
+    declare_parameter<bool>("callback_latency.enabled", true));
+  resource_account_->set_enabled(declare_parameter<bool>("resource_usage.enabled", true));
+  latency_budget_monitor_->set_enabled(declare_parameter<bool>("latency_budget.enabled", true));
+  set_parameters_callback_handle_ = add_on_set_parameters_callback(
+    [this](const std::vector<rclcpp::Parameter> & parameters) {
+      return on_set_parameters(parameters);
+    });
+
+  rcl_interfaces::msg::ParameterDescriptor read_only_descriptor;
+  read_only_descriptor.read_only = true;
+  if (declare_parameter<bool>("zero_allocation.enabled", false, read_only_descriptor)) {
+    const auto pool_size = declare_parameter<int64_t>(
+      "zero_allocation.pool_size", 16 * 1024 * 1024, read_only_descriptor);
+    const auto on_allocation = declare_parameter<std::string>(
+      "zero_allocation.on_allocation", "report", read_only_descriptor);
+    const auto warmup =
+      declare_parameter<double>("zero_allocation.warmup", 1.0, read_only_descriptor);
+    memory_pool_ =
+      std::make_shared<MemoryPool>(static_cast<size_t>(std::max<int64_t>(pool_size, 1)));
+    allocation_monitor_ = std::make_shared<AllocationMonitor>(
+      on_allocation == "abort" ? AllocationPolicy::Abort : AllocationPolicy::Report,
+      std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::duration<double>(warmup)));
+  }
+
+  lifecycle_timing_recorder_ = std::make_shared<LifecycleTimingRecorder>(
+    get_node_base_interface()->get_fully_qualified_name(), construction_start);
+  if (declare_parameter<bool>("lifecycle_timing.publish", false, read_only_descriptor)) {
+    lifecycle_timing_recorder_->set_publisher(rclcpp::create_publisher<LifecycleTimingReport>(
+      get_node_topics_interface(), "~/lifecycle_timing",
+      rclcpp::QoS(1).reliable().transient_local()));
+  }
+  register_transition_callbacks();
+
+  // the housekeeping of AN is driven by the timer coalescer too
+  coalesced_timer_tolerance_ =
+    std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::duration<double>(
+      declare_parameter<double>("coalesced_timer.tolerance", 0.01, read_only_descriptor)));
+
+  const double diagnostics_period =
+    declare_parameter<double>("resource_usage.diagnostics_period", 0.0, read_only_descriptor);
+  if (diagnostics_period > 0.0) {
+    last_resource_usage_time_ = std::chrono::steady_clock::now();
+    diagnostics_timer_ = create_coalesced_timer(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::duration<double>(diagnostics_period)),
+      [this]() { publish_resource_usage_diagnostics(); });
+  }
+
+  latency_budget_diagnostics_period_ =
+    declare_parameter<double>("latency_budget.diagnostics_period", 1.0, read_only_descriptor);
+
+  if (declare_parameter<bool>("flight_recorder.enabled", false, read_only_descriptor)) {
+    const auto directory = declare_parameter<std::string>(
+      "flight_recorder.directory", "/tmp/autoware_flight_recorder", read_only_descriptor);
+    const auto duration =
+      declare_parameter<double>("flight_recorder.duration", 5.0, read_only_descriptor);
+    flight_recorder_max_messages_ =
+      declare_parameter<int64_t>("flight_recorder.max_messages", 100, read_only_descriptor);
+    flight_recorder_max_bytes_ = declare_parameter<int64_t>(
+      "flight_recorder.max_bytes", 100 * 1024 * 1024, read_only_descriptor);
+    flight_recorder_ = std::make_shared<FlightRecorder>(
+      get_node_base_interface()->get_fully_qualified_name(), directory,
+      std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::duration<double>(duration)),
+      get_logger());
+    flight_recorder_service_ = create_service<std_srvs::srv::Trigger>(
+      "~/flight_recorder/snapshot",
+      [this](
+        const std_srvs::srv::Trigger::Request::SharedPtr,
+        const std_srvs::srv::Trigger::Response::SharedPtr response) {
+        response->message = snapshot_flight_recorder("request");
+        response->success = true;
+      });
+  }
+
+  lazy_subscription_hysteresis_ =
+    std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::duration<double>(
+      declare_parameter<double>("lazy_subscription.hysteresis", 1.0, read_only_descriptor)));
+
+  // declared for introspection only, the overrides have been resolved before the construction of
+  // LifecycleNode and a value of another type has been taken as false
+  rcl_interfaces::msg::ParameterDescriptor lifecycle_manager_descriptor = read_only_descriptor;
+  lifecycle_manager_descriptor.dynamic_typing = true;
+  const rclcpp::ParameterValue lifecycle_manager_value = declare_parameter(
+    "lifecycle_manager.enabled", rclcpp::ParameterValue(lifecycle_manager_enabled),
+    lifecycle_manager_descriptor);
+  if (lifecycle_manager_value != rclcpp::ParameterValue(lifecycle_manager_enabled)) {
+    RCLCPP_WARN(
+      get_logger(), "lifecycle_manager.enabled is overridden with %s, but is %s.",
+      rclcpp::to_string(lifecycle_manager_value).c_str(),
+      lifecycle_manager_enabled ? "true" : "false");
+  }
+  if (lifecycle_manager_enabled) {
+    lifecycle_manager_ = LifecycleManager::get_instance(options.context());
+    // the transitions must not reach the node before the end of the construction of the derived
+    // class, which is over when the node is first spun
+    lifecycle_manager_timer_ = create_wall_timer(std::chrono::nanoseconds(0), [this]() {
+      lifecycle_manager_timer_->cancel();
+      register_with_lifecycle_manager();
+    });
+  }
+
+  // the constructor of the derived class is timed from here, until mark_constructed() or else
+  // until the node is first transitioned or registered with the lifecycle manager
+  lifecycle_timing_recorder_->record_construction();
+}
+
+template <typename CallbackT>
+CallbackReturn Node::time_transition(const char * label, CallbackT && callback)
+{
+  lifecycle_timing_recorder_->record_derived_construction(true);
+  const ResourceAccount::Scope scope(*resource_account_);
+  const TimingStart start = TimingStart::now();
+  const CallbackReturn result = callback();
+  lifecycle_timing_recorder_->record(label, start, result == CallbackReturn::SUCCESS);
+  return result;
+}
+
+void Node::register_transition_callbacks()
+{
+  // the callbacks of the derived class are still called through the virtual functions
+  using rclcpp_lifecycle::State;
+  register_on_configure([this](const State & state) {
+    return time_transition("configure", [&]() { return on_configure(state); });
+  });
+  register_on_activate([this](const State & state) {
+    return time_transition("activate", [&]() {
+      const CallbackReturn result = on_activate(state);
+      if (result == CallbackReturn::SUCCESS && allocation_monitor_) {
+        start_zero_allocation();
+      }
+      return result;
+    });
+  });
+  register_on_deactivate([this](const State & state) {
+    return time_transition("deactivate", [&]() {
+      stop_zero_allocation();
+      return on_deactivate(state);
+    });
+  });
+  register_on_cleanup([this](const State & state) {
+    return time_transition("cleanup", [&]() { return on_cleanup(state); });
+  });
+  register_on_shutdown([this](const State & state) {
+    return time_transition("shutdown", [&]() {
+      stop_zero_allocation();
+      return on_shutdown(state);
+    });
+  });
+  register_on_error([this](const State & state) {
+    snapshot_flight_recorder("error");
+    return time_transition("error", [&]() {
+      stop_zero_allocation();
+      return on_error(state);
+    });
+  });
+}
+
+bool Node::register_with_lifecycle_manager()
+{
+  if (!lifecycle_manager_) {
+    return false;
+  }
+  const auto self = std::static_pointer_cast<Node>(weak_from_this().lock());
+  if (!self) {
+    RCLCPP_WARN(
+      get_logger(),
+      "Node is not owned by a shared pointer and cannot register with the lifecycle manager.");
+    return false;
+  }
+  lifecycle_timing_recorder_->record_derived_construction(true);
+  lifecycle_manager_->add_node(self);
+  return true;
+}
+
+void Node::mark_constructed()
+{
+  lifecycle_timing_recorder_->record_derived_construction(false);
+}
+
+LifecycleTimingReport Node::get_lifecycle_timing_report() const
+{
+  return lifecycle_timing_recorder_->get_report();
+}
+
+Node::~Node()
+{
+  if (lifecycle_manager_) {
+    lifecycle_manager_->remove_node(*this);
+  }
+  stop_zero_allocation();
+  if (task_completion_queue_) {
+    get_node_waitables_interface()->remove_waitable(task_completion_queue_, nullptr);
+  }
+  if (lazy_subscription_waitable_) {
+    get_node_waitables_interface()->remove_waitable(lazy_subscription_waitable_, nullptr);
+  }
+}
+
+std::vector<CallbackLatencySnapshot> Node::get_callback_latency_snapshots() const
+{
+  return callback_latency_monitor_->snapshot();
+}
+
+rclcpp::CallbackGroup::SharedPtr Node::create_realtime_callback_group(
+  const std::string & name, const rclcpp::CallbackGroupType type)
+{
+  const std::string prefix = "realtime." + name + ".";
+  rcl_interfaces::msg::ParameterDescriptor priority_descriptor;
+  priority_descriptor.description = "SCHED_FIFO priority of the thread, 0 to disable";
+  priority_descriptor.read_only = true;
+  priority_descriptor.integer_range.resize(1);
+  priority_descriptor.integer_range[0].from_value = 0;
+  priority_descriptor.integer_range[0].to_value = 99;
+  priority_descriptor.integer_range[0].step = 1;
+  rcl_interfaces::msg::ParameterDescriptor cpu_affinity_descriptor;
+  cpu_affinity_descriptor.description = "CPUs the thread may run on, empty for all";
+  cpu_affinity_descriptor.read_only = true;
+
+  RealtimeCallbackGroup realtime_callback_group;
+  realtime_callback_group.profile.name = name;
+  realtime_callback_group.profile.priority = static_cast<int>(
+    declare_parameter<int64_t>(prefix + "priority", 0, priority_descriptor));
+  const auto cpu_affinity = declare_parameter<std::vector<int64_t>>(
+    prefix + "cpu_affinity", std::vector<int64_t>{}, cpu_affinity_descriptor);
+  realtime_callback_group.profile.cpu_affinity.assign(cpu_affinity.begin(), cpu_affinity.end());
+  realtime_callback_group.callback_group = create_callback_group(type, false);
+
+  realtime_callback_groups_.push_back(realtime_callback_group);
+  return realtime_callback_group.callback_group;
+}
+
+void Node::publish_resource_usage_diagnostics()
+{
+  const ResourceUsage usage = resource_account_->get_usage();
+  const auto now = std::chrono::steady_clock::now();
+  const double elapsed = std::chrono::duration<double>(now - last_resource_usage_time_).count();
+  const auto rate = [elapsed](const uint64_t current, const uint64_t last) {
+    return elapsed > 0.0 ? static_cast<double>(current - last) / elapsed : 0.0;
+  };
+  const auto add_value = [](auto & status, const std::string & key, const auto value) {
+    diagnostic_msgs::msg::KeyValue key_value;
+    key_value.key = key;
+    key_value.value = std::to_string(value);
+    status.values.push_back(key_value);
+  };
+
+  diagnostic_msgs::msg::DiagnosticStatus status;
+  status.level = diagnostic_msgs::msg::DiagnosticStatus::OK;
+  status.name = std::string(get_fully_qualified_name()) + ": resource_usage";
+  status.hardware_id = get_fully_qualified_name();
+  status.message = resource_account_->is_enabled() ? "OK" : "disabled";
+  add_value(status, "cpu_time [s]", usage.cpu_time * 1e-9);
+  add_value(status, "cpu_usage [%]", rate(usage.cpu_time, last_resource_usage_.cpu_time) * 1e-7);
+  add_value(status, "allocated_bytes", usage.allocated_bytes);
+  add_value(
+    status, "allocation_rate [B/s]",
+    rate(usage.allocated_bytes, last_resource_usage_.allocated_bytes));
+  add_value(status, "allocation_count", usage.allocation_count);
+  add_value(status, "freed_bytes", usage.freed_bytes);
+  add_value(status, "live_bytes", usage.get_live_bytes());
+  const int64_t live_bytes_growth = usage.get_live_bytes() - last_resource_usage_.get_live_bytes();
+  add_value(
+    status, "live_bytes_growth [B/s]",
+    elapsed > 0.0 ? static_cast<double>(live_bytes_growth) / elapsed : 0.0);
+  add_value(status, "callback_count", usage.callback_count);
+  add_value(
+    status, "callback_rate [Hz]", rate(usage.callback_count, last_resource_usage_.callback_count));
+  last_resource_usage_ = usage;
+  last_resource_usage_time_ = now;
+
+  diagnostic_msgs::msg::DiagnosticArray diagnostics;
+  diagnostics.header.stamp = this->now();
+  diagnostics.status.push_back(status);
+  get_diagnostics_publisher()->publish(diagnostics);
+}
+
+void Node::publish_latency_budget_diagnostics()
+{
+  const auto add_value = [](auto & status, const std::string & key, const auto value) {
+    diagnostic_msgs::msg::KeyValue key_value;
+    key_value.key = key;
+    key_value.value = std::to_string(value);
+    status.values.push_back(key_value);
+  };
+
+  diagnostic_msgs::msg::DiagnosticStatus status;
+  status.level = diagnostic_msgs::msg::DiagnosticStatus::OK;
+  status.name = std::string(get_fully_qualified_name()) + ": latency_budget";
+  status.hardware_id = get_fully_qualified_name();
+  std::string overrun_names;
+  for (const auto & snapshot : latency_budget_monitor_->snapshot()) {
+    if (snapshot.budget <= 0) {
+      continue;
+    }
+    // the overruns since the previous diagnostics raise the level
+    uint64_t & last_overrun_count = last_overrun_counts_[snapshot.name];
+    if (snapshot.overrun_count > last_overrun_count) {
+      status.level = diagnostic_msgs::msg::DiagnosticStatus::WARN;
+      overrun_names += (overrun_names.empty() ? "" : ", ") + snapshot.name;
+    }
+    last_overrun_count = snapshot.overrun_count;
+
+    add_value(status, snapshot.name + ": budget [ms]", snapshot.budget * 1e-6);
+    add_value(
+      status, snapshot.name + ": cumulative p99 [ms]",
+      snapshot.cumulative_latency.percentile(99.0) * 1e-6);
+    add_value(
+      status, snapshot.name + ": cumulative max [ms]", snapshot.cumulative_latency.max * 1e-6);
+    add_value(
+      status, snapshot.name + ": hop p99 [ms]", snapshot.hop_latency.percentile(99.0) * 1e-6);
+    add_value(status, snapshot.name + ": overrun_count", snapshot.overrun_count);
+  }
+  status.message = overrun_names.empty() ? "OK" : "budget exceeded on " + overrun_names;
+
+  diagnostic_msgs::msg::DiagnosticArray diagnostics;
+  diagnostics.header.stamp = this->now();
+  diagnostics.status.push_back(status);
+  get_diagnostics_publisher()->publish(diagnostics);
+}
+
+const rclcpp::Publisher<diagnostic_msgs::msg::DiagnosticArray>::SharedPtr &
+Node::get_diagnostics_publisher()
+{
+  if (!diagnostics_publisher_) {
+    diagnostics_publisher_ = rclcpp::create_publisher<diagnostic_msgs::msg::DiagnosticArray>(
+      get_node_topics_interface(), "/diagnostics", rclcpp::QoS(1));
+  }
+  return diagnostics_publisher_;
+}
+
+CoalescedTimer::SharedPtr Node::create_coalesced_timer(
+  const std::chrono::nanoseconds period, std::function<void()> callback,
+  const std::optional<std::chrono::nanoseconds> & tolerance)
+{
+  std::weak_ptr<TaskCompletionQueue> queue = get_task_completion_queue();
+  auto timer = std::make_shared<CoalescedTimer>(
+    period, tolerance.value_or(coalesced_timer_tolerance_),
+    [account = resource_account_, callback = std::move(callback)]() {
+      const ResourceAccount::Scope scope(*account);
+      callback();
+    },
+    [queue](Task task) {
+      if (const auto locked_queue = queue.lock()) {
+        locked_queue->push(std::move(task));
+      }
+    });
+  TimerCoalescer::get_instance().add(timer);
+  return timer;
+}
+
+rcl_interfaces::msg::SetParametersResult Node::on_set_parameters(
+  const std::vector<rclcpp::Parameter> & parameters)
+{
+  rcl_interfaces::msg::SetParametersResult result;
+  std::lock_guard<std::mutex> lock(parameter_handles_mutex_);
+
+  // nothing is applied unless all the values are valid
+  std::vector<std::pair<ParameterHandleBase *, const rclcpp::Parameter *>> updates;
+  for (const auto & parameter : parameters) {
+    const auto iterator = parameter_handles_.find(parameter.get_name());
+    if (iterator == parameter_handles_.end()) {
+      continue;
+    }
+    const std::string reason = iterator->second->validate(parameter);
+    if (!reason.empty()) {
+      result.successful = false;
+      result.reason = parameter.get_name() + ": " + reason;
+      return result;
+    }
+    updates.emplace_back(iterator->second.get(), &parameter);
+  }
+
+  for (const auto & parameter : parameters) {
+    if (parameter.get_name() == "callback_latency.enabled") {
+      callback_latency_monitor_->set_enabled(parameter.as_bool());
+    } else if (parameter.get_name() == "resource_usage.enabled") {
+      resource_account_->set_enabled(parameter.as_bool());
+    } else if (parameter.get_name() == "latency_budget.enabled") {
+      latency_budget_monitor_->set_enabled(parameter.as_bool());
+    }
+  }
+  for (const auto & [handle, parameter] : updates) {
+    handle->update(*parameter);
+  }
+  result.successful = true;
+  return result;
+}
+
+void Node::add_parameter_handle(
+  const std::string & name, const std::shared_ptr<ParameterHandleBase> & handle)
+{
+  std::lock_guard<std::mutex> lock(parameter_handles_mutex_);
+  parameter_handles_[name] = handle;
+}
+
+std::shared_ptr<TaskCompletionQueue> Node::get_task_completion_queue()
+{
+  std::lock_guard<std::mutex> lock(task_completion_queue_mutex_);
+  if (!task_completion_queue_) {
+    task_completion_queue_ =
+      std::make_shared<TaskCompletionQueue>(get_node_base_interface()->get_context());
+    get_node_waitables_interface()->add_waitable(task_completion_queue_, nullptr);
+  }
+  return task_completion_queue_;
+}
+
+std::string Node::snapshot_flight_recorder(const std::string & reason)
+{
+  return flight_recorder_ ? flight_recorder_->snapshot(reason) : "";
+}
+
+size_t Node::get_flight_recorder_capacity(const std::string & topic_name)
+{
+  const std::string name =
+    "flight_recorder.topics." + to_parameter_key(topic_name) + ".max_messages";
+  rcl_interfaces::msg::ParameterDescriptor read_only_descriptor;
+  read_only_descriptor.read_only = true;
+  const int64_t max_messages =
+    has_parameter(name)
+      ? get_parameter(name).as_int()
+      : declare_parameter<int64_t>(name, flight_recorder_max_messages_, read_only_descriptor);
+  return static_cast<size_t>(std::max<int64_t>(max_messages, 0));
+}
+
+size_t Node::get_flight_recorder_max_bytes(const std::string & topic_name)
+{
+  const std::string name = "flight_recorder.topics." + to_parameter_key(topic_name) + ".max_bytes";
+  rcl_interfaces::msg::ParameterDescriptor read_only_descriptor;
+  read_only_descriptor.read_only = true;
+  const int64_t max_bytes =
+    has_parameter(name)
+      ? get_parameter(name).as_int()
+      : declare_parameter<int64_t>(name, flight_recorder_max_bytes_, read_only_descriptor);
+  return static_cast<size_t>(std::max<int64_t>(max_bytes, 0));
+}
+
+int64_t Node::get_latency_budget(const std::string & topic_name)
+{
+  const std::string name = "latency_budget.topics." + to_parameter_key(topic_name);
+  rcl_interfaces::msg::ParameterDescriptor read_only_descriptor;
+  read_only_descriptor.read_only = true;
+  const double budget = has_parameter(name)
+                          ? get_parameter(name).as_double()
+                          : declare_parameter<double>(name, 0.0, read_only_descriptor);
+  if (budget <= 0.0) {
+    return 0;
+  }
+
+  // the diagnostics are only published by the nodes with budgets
+  if (!latency_budget_diagnostics_timer_ && latency_budget_diagnostics_period_ > 0.0) {
+    latency_budget_diagnostics_timer_ = create_coalesced_timer(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::duration<double>(latency_budget_diagnostics_period_)),
+      [this]() { publish_latency_budget_diagnostics(); });
+  }
+  return static_cast<int64_t>(budget * 1e9);
+}
+
+std::vector<LatencyBudgetSnapshot> Node::get_latency_budget_snapshots() const
+{
+  return latency_budget_monitor_->snapshot();
+}
+
+void Node::add_lazy_subscription(const std::shared_ptr<LazySubscriptionBase> & lazy_subscription)
+{
+  // a new subscription has no hysteresis to wait for
+  lazy_subscription->update(true, std::chrono::steady_clock::now());
+
+  std::lock_guard<std::mutex> lock(lazy_subscriptions_mutex_);
+  lazy_subscriptions_.push_back(lazy_subscription);
+  if (!lazy_subscription_waitable_) {
+    lazy_subscription_waitable_ = std::make_shared<GraphChangeWaitable>(
+      get_node_graph_interface()->get_graph_event(),
+      [this]() { update_lazy_subscriptions(true); });
+    get_node_waitables_interface()->add_waitable(lazy_subscription_waitable_, nullptr);
+  }
+}
+
+void Node::update_lazy_subscriptions(const bool graph_changed)
+{
+  const auto now = std::chrono::steady_clock::now();
+
+  std::vector<std::shared_ptr<LazySubscriptionBase>> lazy_subscriptions;
+  {
+    std::lock_guard<std::mutex> lock(lazy_subscriptions_mutex_);
+    lazy_subscriptions_.erase(
+      std::remove_if(
+        lazy_subscriptions_.begin(), lazy_subscriptions_.end(),
+        [](const auto & lazy_subscription) { return lazy_subscription.expired(); }),
+      lazy_subscriptions_.end());
+    for (const auto & lazy_subscription : lazy_subscriptions_) {
+      lazy_subscriptions.push_back(lazy_subscription.lock());
+    }
+  }
+  // updated without the lock, as they create subscriptions
+  std::optional<std::chrono::steady_clock::time_point> next_update;
+  for (const auto & lazy_subscription : lazy_subscriptions) {
+    if (!lazy_subscription) {
+      continue;
+    }
+    if (const auto release_time = lazy_subscription->update(graph_changed, now)) {
+      next_update = next_update ? std::min(*next_update, *release_time) : *release_time;
+    }
+  }
+
+  // the waitable and the timer are in the default callback group, so they do not run concurrently
+  if (lazy_subscription_timer_) {
+    lazy_subscription_timer_->cancel();
+    lazy_subscription_timer_.reset();
+  }
+  if (next_update) {
+    lazy_subscription_timer_ = create_wall_timer(
+      std::max(*next_update - now, std::chrono::steady_clock::duration::zero()), [this]() {
+        lazy_subscription_timer_->cancel();
+        update_lazy_subscriptions(false);
+      });
+  }
+}
+
+rclcpp::ExecutorOptions Node::get_pooled_executor_options() const
+{
+  using rclcpp::memory_strategies::allocator_memory_strategy::AllocatorMemoryStrategy;
+  rclcpp::ExecutorOptions options;
+  options.memory_strategy = std::make_shared<AllocatorMemoryStrategy<PoolAllocator<void>>>(
+    std::make_shared<PoolAllocator<void>>(get_pool_allocator()));
+  return options;
+}
+
+void Node::start_zero_allocation()
+{
+  if (allocation_monitor_->is_armed()) {
+    return;
+  }
+  allocation_monitor_->arm();
+
+  if (!AllocationMonitor::is_hook_installed()) {
+    RCLCPP_INFO(
+      get_logger(),
+      "Allocations on real-time threads are not monitored, as malloc is not intercepted.");
+  }
+  allocation_report_timer_ =
+    create_coalesced_timer(std::chrono::seconds(1), [this, last_count = uint64_t{0}]() mutable {
+      const uint64_t count = allocation_monitor_->get_allocation_count();
+      if (count != last_count) {
+        RCLCPP_WARN(
+          get_logger(), "%lu heap allocations on real-time threads, the last one of %zu bytes.",
+          static_cast<unsigned long>(count - last_count),  // NOLINT
+          allocation_monitor_->get_last_allocation_size());
+        last_count = count;
+      }
+    });
+}
+
+void Node::stop_zero_allocation()
+{
+  if (!allocation_monitor_ || !allocation_monitor_->is_armed()) {
+    return;
+  }
+  allocation_monitor_->disarm();
+  allocation_report_timer_.reset();
+}
+
+rclcpp::IntraProcessSetting Node::get_intra_process_setting(
+  const std::string & topic_name, const rclcpp::QoS & qos) const
+{
+  const rmw_qos_profile_t & profile = qos.get_rmw_qos_profile();
+  if (profile.durability != RMW_QOS_POLICY_DURABILITY_VOLATILE) {
+    RCLCPP_WARN(
+      get_logger(), "Intra-process delivery is disabled on %s: the durability is not volatile.",
+      topic_name.c_str());
+    return rclcpp::IntraProcessSetting::Disable;
+  }
+  if (profile.history != RMW_QOS_POLICY_HISTORY_KEEP_LAST || profile.depth == 0) {
+    RCLCPP_WARN(
+      get_logger(), "Intra-process delivery is disabled on %s: the history is not keep last.",
+      topic_name.c_str());
+    return rclcpp::IntraProcessSetting::Disable;
+  }
+  return rclcpp::IntraProcessSetting::Enable;
+}
+
+void Node::record_queueing_delay(
+  CallbackLatencyStatistics & statistics, const rclcpp::MessageInfo & message_info)
+{
+  // the reception timestamp is in system time and 0 if not supported by the middleware
+  const rmw_time_point_value_t received_timestamp =
+    message_info.get_rmw_message_info().received_timestamp;
+  if (received_timestamp <= 0) {
+    return;
+  }
+  const auto now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::system_clock::now().time_since_epoch());
+  statistics.queueing_delay.record(CallbackLatencyMonitor::to_nanoseconds(
+    now - std::chrono::nanoseconds(received_timestamp)));
 }
 
 CallbackReturn Node::on_shutdown(const rclcpp_lifecycle::State & state)
 {
-  RCLCPP_DEBUG(
-    get_logger(), "Node %s shutdown was called with state %s.",
+  AUTOWARE_ASYNC_DEBUG(
+    *async_logger_, "Node %s shutdown was called with state %s.",
     get_node_base_interface()->get_fully_qualified_name(), state.label().c_str());
   return CallbackReturn::SUCCESS;
 }
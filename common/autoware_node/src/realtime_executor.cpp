@@ -0,0 +1,225 @@
+// Copyright 2024 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <autoware/node/allocation_monitor.hpp>
+#include <autoware/node/realtime_executor.hpp>
+#include <autoware/node/thread_profile.hpp>
+#include <rclcpp/rclcpp.hpp>
+
+#include <pthread.h>
+#include <sched.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace autoware::node
+{
+
+namespace
+{
+// scheduling of the thread calling spin(), restored when it returns
+struct SavedThreadProfile
+{
+  char name[16]{};
+  int policy{SCHED_OTHER};
+  sched_param param{};
+  cpu_set_t cpu_set{};
+  bool has_cpu_set{false};
+};
+
+SavedThreadProfile save_thread_profile()
+{
+  SavedThreadProfile saved;
+  const pthread_t thread = pthread_self();
+  pthread_getname_np(thread, saved.name, sizeof(saved.name));
+  pthread_getschedparam(thread, &saved.policy, &saved.param);
+  saved.has_cpu_set = pthread_getaffinity_np(thread, sizeof(saved.cpu_set), &saved.cpu_set) == 0;
+  return saved;
+}
+
+void restore_thread_profile(const SavedThreadProfile & saved, const rclcpp::Logger & logger)
+{
+  const pthread_t thread = pthread_self();
+  pthread_setname_np(thread, saved.name);
+  if (const int error = pthread_setschedparam(thread, saved.policy, &saved.param)) {
+    RCLCPP_WARN(logger, "Failed to restore the scheduling policy: %s.", std::strerror(error));
+  }
+  if (saved.has_cpu_set) {
+    if (const int error = pthread_setaffinity_np(thread, sizeof(saved.cpu_set), &saved.cpu_set)) {
+      RCLCPP_WARN(logger, "Failed to restore the CPU affinity: %s.", std::strerror(error));
+    }
+  }
+}
+}  // namespace
+
+bool apply_thread_profile(const ThreadProfile & profile, const rclcpp::Logger & logger)
+{
+  bool applied = true;
+  const pthread_t thread = pthread_self();
+
+  if (!profile.name.empty()) {
+    // the kernel limits thread names to 15 characters
+    pthread_setname_np(thread, profile.name.substr(0, 15).c_str());
+  }
+
+  if (!profile.cpu_affinity.empty()) {
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    for (const int cpu : profile.cpu_affinity) {
+      if (cpu < 0 || cpu >= CPU_SETSIZE) {
+        RCLCPP_WARN(logger, "Thread %s: ignoring invalid CPU %d.", profile.name.c_str(), cpu);
+        continue;
+      }
+      CPU_SET(cpu, &cpu_set);
+    }
+    const int error = pthread_setaffinity_np(thread, sizeof(cpu_set), &cpu_set);
+    if (error != 0) {
+      RCLCPP_WARN(
+        logger, "Thread %s: failed to set the CPU affinity: %s.", profile.name.c_str(),
+        std::strerror(error));
+      applied = false;
+    }
+  }
+
+  if (profile.priority > 0) {
+    sched_param param{};
+    param.sched_priority = std::min(profile.priority, sched_get_priority_max(SCHED_FIFO));
+    const int error = pthread_setschedparam(thread, SCHED_FIFO, &param);
+    if (error != 0) {
+      RCLCPP_WARN(
+        logger,
+        "Thread %s: failed to set SCHED_FIFO priority %d (%s), keeping the default policy. Grant "
+        "CAP_SYS_NICE or raise the rtprio limit to enable it.",
+        profile.name.c_str(), param.sched_priority, std::strerror(error));
+      applied = false;
+    }
+  }
+  return applied;
+}
+
+RealtimeExecutor::RealtimeExecutor(
+  const rclcpp::ExecutorOptions & options, ThreadProfile default_profile)
+: options_(options),
+  default_profile_(std::move(default_profile)),
+  default_executor_(options),
+  logger_(rclcpp::get_logger("realtime_executor"))
+{
+}
+
+RealtimeExecutor::~RealtimeExecutor()
+{
+  cancel();
+  stop();
+}
+
+void RealtimeExecutor::add_node(const std::shared_ptr<Node> & node)
+{
+  add_node(node->get_node_base_interface());
+  for (const auto & realtime_callback_group : node->get_realtime_callback_groups()) {
+    add_callback_group(
+      realtime_callback_group.callback_group, node->get_node_base_interface(),
+      realtime_callback_group.profile, node->get_allocation_monitor());
+  }
+}
+
+void RealtimeExecutor::add_node(const rclcpp::node_interfaces::NodeBaseInterface::SharedPtr & node)
+{
+  // callback groups which are not added automatically are left to add_callback_group
+  default_executor_.add_node(node);
+}
+
+void RealtimeExecutor::add_callback_group(
+  const rclcpp::CallbackGroup::SharedPtr & callback_group,
+  const rclcpp::node_interfaces::NodeBaseInterface::SharedPtr & node,
+  const ThreadProfile & profile, const std::shared_ptr<AllocationMonitor> & allocation_monitor)
+{
+  auto dedicated_thread = std::make_unique<DedicatedThread>();
+  dedicated_thread->profile = profile;
+  dedicated_thread->allocation_monitor = allocation_monitor;
+  dedicated_thread->executor =
+    std::make_shared<rclcpp::executors::SingleThreadedExecutor>(options_);
+  dedicated_thread->executor->add_callback_group(callback_group, node);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (spinning_) {
+    start(*dedicated_thread);
+  }
+  dedicated_threads_.push_back(std::move(dedicated_thread));
+}
+
+void RealtimeExecutor::spin()
+{
+  if (spinning_.exchange(true)) {
+    throw std::runtime_error("spin() called while already spinning");
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto & dedicated_thread : dedicated_threads_) {
+      start(*dedicated_thread);
+    }
+  }
+  const SavedThreadProfile saved_profile = save_thread_profile();
+  apply_thread_profile(default_profile_, logger_);
+  // unlike default_executor_.spin(), this does not miss a cancel() called before spinning
+  while (!stop_requested_ && rclcpp::ok(options_.context)) {
+    default_executor_.spin_once(std::chrono::milliseconds(100));
+  }
+  restore_thread_profile(saved_profile, logger_);
+
+  // the dedicated threads stop with the default executor
+  cancel();
+  stop();
+  // reset only now, so that a cancel() called before spin() is not lost
+  stop_requested_ = false;
+  spinning_ = false;
+}
+
+void RealtimeExecutor::cancel()
+{
+  stop_requested_ = true;
+  default_executor_.cancel();
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto & dedicated_thread : dedicated_threads_) {
+    dedicated_thread->executor->cancel();
+  }
+}
+
+void RealtimeExecutor::start(DedicatedThread & dedicated_thread)
+{
+  dedicated_thread.thread = std::thread([this, &dedicated_thread]() {
+    apply_thread_profile(dedicated_thread.profile, logger_);
+    AllocationMonitor::set_thread_monitor(dedicated_thread.allocation_monitor.get());
+    // this does not miss a cancel() called before the thread starts
+    while (!stop_requested_ && rclcpp::ok(options_.context)) {
+      dedicated_thread.executor->spin_once(std::chrono::milliseconds(100));
+    }
+  });
+}
+
+void RealtimeExecutor::stop()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto & dedicated_thread : dedicated_threads_) {
+    if (dedicated_thread->thread.joinable()) {
+      dedicated_thread->thread.join();
+    }
+  }
+}
+
+}  // namespace autoware::node
@@ -0,0 +1,104 @@
+// Copyright 2024 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "thread_specific.hpp"
+
+#include <autoware/node/resource_usage.hpp>
+
+#include <time.h>
+
+#include <cstdint>
+
+namespace autoware::node
+{
+
+namespace
+{
+const ThreadSpecific<ResourceAccount> current_account;
+const ThreadSpecific<ResourceAccount::Scope> current_scope;
+}  // namespace
+
+ResourceAccount::Scope::Scope(ResourceAccount & account) noexcept
+: account_(account.is_enabled() && current_account.get() != &account ? &account : nullptr),
+  previous_account_(current_account.get()),
+  previous_scope_(current_scope.get())
+{
+  if (!account_) {
+    return;
+  }
+  start_cpu_time_ = get_thread_cpu_time();
+  // the outer scope is paused, so that the time of this scope is not charged to both accounts
+  if (previous_scope_) {
+    previous_scope_->account_->cpu_time_.fetch_add(
+      start_cpu_time_ - previous_scope_->start_cpu_time_, std::memory_order_relaxed);
+  }
+  current_account.set(account_);
+  current_scope.set(this);
+}
+
+ResourceAccount::Scope::~Scope()
+{
+  if (!account_) {
+    return;
+  }
+  const uint64_t end_cpu_time = get_thread_cpu_time();
+  account_->cpu_time_.fetch_add(end_cpu_time - start_cpu_time_, std::memory_order_relaxed);
+  account_->callback_count_.fetch_add(1, std::memory_order_relaxed);
+  if (previous_scope_) {
+    previous_scope_->start_cpu_time_ = end_cpu_time;
+  }
+  current_account.set(previous_account_);
+  current_scope.set(previous_scope_);
+}
+
+ResourceUsage ResourceAccount::get_usage() const noexcept
+{
+  ResourceUsage usage;
+  usage.cpu_time = cpu_time_.load(std::memory_order_relaxed);
+  usage.allocated_bytes = allocated_bytes_.load(std::memory_order_relaxed);
+  usage.allocation_count = allocation_count_.load(std::memory_order_relaxed);
+  usage.freed_bytes = freed_bytes_.load(std::memory_order_relaxed);
+  usage.free_count = free_count_.load(std::memory_order_relaxed);
+  usage.callback_count = callback_count_.load(std::memory_order_relaxed);
+  return usage;
+}
+
+void ResourceAccount::on_allocation(const std::size_t size) noexcept
+{
+  ResourceAccount * const account = current_account.get();
+  if (!account) {
+    return;
+  }
+  account->allocated_bytes_.fetch_add(size, std::memory_order_relaxed);
+  account->allocation_count_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void ResourceAccount::on_free(const std::size_t size) noexcept
+{
+  ResourceAccount * const account = current_account.get();
+  if (!account) {
+    return;
+  }
+  account->freed_bytes_.fetch_add(size, std::memory_order_relaxed);
+  account->free_count_.fetch_add(1, std::memory_order_relaxed);
+}
+
+uint64_t ResourceAccount::get_thread_cpu_time() noexcept
+{
+  timespec time{};
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time);
+  return static_cast<uint64_t>(time.tv_sec) * 1000000000u + static_cast<uint64_t>(time.tv_nsec);
+}
+
+}  // namespace autoware::node
@@ -0,0 +1,240 @@
+// Copyright 2024 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <autoware/node/thread_pool.hpp>
+
+#include <rclcpp/exceptions.hpp>
+
+#include <rcl/wait.h>
+#include <pthread.h>
+#include <rcutils/logging_macros.h>
+#include <sched.h>
+
+#include <algorithm>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace autoware::node
+{
+
+namespace
+{
+thread_local ThreadPool * current_pool = nullptr;
+thread_local size_t current_worker = 0;
+
+// affinity of the thread loading the library, before executors pin their own threads
+const cpu_set_t * get_process_cpu_set()
+{
+  static const cpu_set_t * const cpu_set = []() -> const cpu_set_t * {
+    static cpu_set_t affinity;
+    CPU_ZERO(&affinity);
+    return sched_getaffinity(0, sizeof(affinity), &affinity) == 0 && CPU_COUNT(&affinity) > 0
+             ? &affinity
+             : nullptr;
+  }();
+  return cpu_set;
+}
+[[maybe_unused]] const cpu_set_t * const process_cpu_set_at_load = get_process_cpu_set();
+
+// the workers do not inherit the real-time priority and pinning of the thread creating the pool
+void reset_thread_profile()
+{
+  sched_param param{};
+  param.sched_priority = 0;
+  if (const int error = pthread_setschedparam(pthread_self(), SCHED_OTHER, &param)) {
+    RCUTILS_LOG_WARN_NAMED(
+      "autoware_node", "Failed to reset the scheduling policy of a worker: %d", error);
+  }
+  if (const cpu_set_t * cpu_set = get_process_cpu_set()) {
+    if (const int error = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), cpu_set)) {
+      RCUTILS_LOG_WARN_NAMED(
+        "autoware_node", "Failed to reset the affinity of a worker: %d", error);
+    }
+  }
+}
+}  // namespace
+
+ThreadPool & ThreadPool::get_instance()
+{
+  static ThreadPool instance(get_default_size());
+  return instance;
+}
+
+size_t ThreadPool::get_default_size()
+{
+  if (const cpu_set_t * cpu_set = get_process_cpu_set()) {
+    return static_cast<size_t>(CPU_COUNT(cpu_set));
+  }
+  return std::max(std::thread::hardware_concurrency(), 1u);
+}
+
+ThreadPool::ThreadPool(const size_t num_threads)
+{
+  const size_t size = std::max<size_t>(num_threads, 1);
+  workers_.reserve(size);
+  for (size_t i = 0; i < size; ++i) {
+    workers_.push_back(std::make_unique<Worker>());
+  }
+  threads_.reserve(size);
+  for (size_t i = 0; i < size; ++i) {
+    threads_.emplace_back([this, i]() { run(i); });
+  }
+}
+
+ThreadPool::~ThreadPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(sleep_mutex_);
+    stop_requested_ = true;
+  }
+  sleep_condition_.notify_all();
+  for (auto & thread : threads_) {
+    thread.join();
+  }
+}
+
+void ThreadPool::post(Task task)
+{
+  const size_t index = current_pool == this
+                         ? current_worker
+                         : next_worker_.fetch_add(1, std::memory_order_relaxed) % workers_.size();
+  {
+    std::lock_guard<std::mutex> lock(workers_[index]->mutex);
+    workers_[index]->tasks.push_back(std::move(task));
+  }
+  pending_count_.fetch_add(1);
+  {
+    // a worker checking pending_count_ before going to sleep holds the lock
+    std::lock_guard<std::mutex> lock(sleep_mutex_);
+  }
+  sleep_condition_.notify_one();
+}
+
+bool ThreadPool::pop_task(const size_t index, Task & task)
+{
+  {
+    auto & worker = *workers_[index];
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    if (!worker.tasks.empty()) {
+      task = std::move(worker.tasks.back());
+      worker.tasks.pop_back();
+      pending_count_.fetch_sub(1);
+      return true;
+    }
+  }
+  for (size_t i = 1; i < workers_.size(); ++i) {
+    auto & victim = *workers_[(index + i) % workers_.size()];
+    std::lock_guard<std::mutex> lock(victim.mutex);
+    if (!victim.tasks.empty()) {
+      task = std::move(victim.tasks.front());
+      victim.tasks.pop_front();
+      pending_count_.fetch_sub(1);
+      return true;
+    }
+  }
+  return false;
+}
+
+void ThreadPool::run(const size_t index)
+{
+  reset_thread_profile();
+  current_pool = this;
+  current_worker = index;
+  while (true) {
+    Task task;
+    if (pop_task(index, task)) {
+      try {
+        task();
+      } catch (const std::exception & e) {
+        RCUTILS_LOG_ERROR_NAMED("autoware_node", "Task of the thread pool threw: %s", e.what());
+      } catch (...) {
+        RCUTILS_LOG_ERROR_NAMED("autoware_node", "Task of the thread pool threw.");
+      }
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(sleep_mutex_);
+    sleep_condition_.wait(lock, [this]() { return stop_requested_ || pending_count_.load() > 0; });
+    if (stop_requested_ && pending_count_.load() == 0) {
+      return;
+    }
+  }
+}
+
+TaskCompletionQueue::TaskCompletionQueue(rclcpp::Context::SharedPtr context)
+: guard_condition_(std::move(context))
+{
+}
+
+void TaskCompletionQueue::push(Task completion)
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    completions_.push_back(std::move(completion));
+  }
+  guard_condition_.trigger();
+}
+
+void TaskCompletionQueue::add_to_wait_set(rcl_wait_set_t * wait_set)
+{
+  const rcl_ret_t ret = rcl_wait_set_add_guard_condition(
+    wait_set, &guard_condition_.get_rcl_guard_condition(), nullptr);
+  if (ret != RCL_RET_OK) {
+    rclcpp::exceptions::throw_from_rcl_error(
+      ret, "failed to add the guard condition of the task completions to the wait set");
+  }
+}
+
+bool TaskCompletionQueue::is_ready(rcl_wait_set_t * wait_set)
+{
+  for (size_t i = 0; i < wait_set->size_of_guard_conditions; ++i) {
+    if (wait_set->guard_conditions[i] == &guard_condition_.get_rcl_guard_condition()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+std::shared_ptr<void> TaskCompletionQueue::take_data()
+{
+  return nullptr;
+}
+
+void TaskCompletionQueue::execute(std::shared_ptr<void> & /*data*/)
+{
+  while (true) {
+    Task completion;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (completions_.empty()) {
+        return;
+      }
+      completion = std::move(completions_.front());
+      completions_.pop_front();
+    }
+    try {
+      completion();
+    } catch (...) {
+      // the remaining completions are run on the next wakeup
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!completions_.empty()) {
+        guard_condition_.trigger();
+      }
+      throw;
+    }
+  }
+}
+
+}  // namespace autoware::node
@@ -0,0 +1,58 @@
+// Copyright 2024 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef THREAD_SPECIFIC_HPP_
+#define THREAD_SPECIFIC_HPP_
+
+#include <pthread.h>
+
+namespace autoware::node
+{
+
+/**
+ * @brief Per-thread pointer which is safe to read from a malloc hook.
+ * @details A thread_local of a library loaded with dlopen, e.g. into a component container, is
+ * allocated with malloc on the first access of each thread, which would recurse into the hook,
+ * and the initial-exec TLS model avoiding it fails to load once the static TLS block is exhausted.
+ * pthread_getspecific never allocates, and reads nullptr before the key is created at load time.
+ */
+template <typename T>
+class ThreadSpecific
+{
+public:
+  ThreadSpecific() noexcept { created_ = pthread_key_create(&key_, nullptr) == 0; }
+
+  ThreadSpecific(const ThreadSpecific &) = delete;
+  ThreadSpecific & operator=(const ThreadSpecific &) = delete;
+
+  T * get() const noexcept
+  {
+    return created_ ? static_cast<T *>(pthread_getspecific(key_)) : nullptr;
+  }
+
+  void set(T * value) const noexcept
+  {
+    if (created_) {
+      pthread_setspecific(key_, value);
+    }
+  }
+
+private:
+  pthread_key_t key_{};
+  bool created_{false};
+};
+
+}  // namespace autoware::node
+
+#endif  // THREAD_SPECIFIC_HPP_
@@ -0,0 +1,173 @@
+// Copyright 2024 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <autoware/node/timer_coalescer.hpp>
+
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <utility>
+
+namespace autoware::node
+{
+
+CoalescedTimer::CoalescedTimer(
+  const std::chrono::nanoseconds period, const std::chrono::nanoseconds tolerance,
+  std::function<void()> callback, PostFunction post)
+: period_(std::max(period, std::chrono::nanoseconds(1))),
+  tolerance_(std::max(tolerance, std::chrono::nanoseconds(0))),
+  callback_(std::move(callback)),
+  post_(std::move(post))
+{
+}
+
+bool CoalescedTimer::expire()
+{
+  if (is_canceled()) {
+    return true;
+  }
+  if (pending_.exchange(true)) {
+    skipped_count_.fetch_add(1);
+    return false;
+  }
+  post_(Task([weak_timer = weak_from_this()]() {
+    const auto timer = weak_timer.lock();
+    if (timer && !timer->is_canceled()) {
+      timer->pending_.store(false);
+      timer->callback_();
+    }
+  }));
+  return true;
+}
+
+TimerCoalescer & TimerCoalescer::get_instance()
+{
+  static TimerCoalescer instance;
+  return instance;
+}
+
+TimerCoalescer::TimerCoalescer() = default;
+
+TimerCoalescer::~TimerCoalescer()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_requested_ = true;
+  }
+  condition_.notify_all();
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+}
+
+void TimerCoalescer::add(const CoalescedTimer::SharedPtr & timer)
+{
+  // aligned to the multiples of the period, like the other timers with the same period
+  const auto now = std::chrono::steady_clock::now().time_since_epoch();
+  const auto period = timer->get_period();
+  const std::chrono::steady_clock::time_point expiration((now / period + 1) * period);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.push_back({timer, expiration});
+    if (!thread_.joinable()) {
+      thread_ = std::thread([this]() { run(); });
+    }
+  }
+  condition_.notify_all();
+}
+
+TimerCoalescerStatistics TimerCoalescer::get_statistics() const
+{
+  TimerCoalescerStatistics statistics;
+  statistics.wakeup_count = wakeup_count_.load();
+  statistics.expiration_count = expiration_count_.load();
+  statistics.skipped_count = skipped_count_.load();
+  statistics.voluntary_context_switches = voluntary_context_switches_.load();
+  statistics.involuntary_context_switches = involuntary_context_switches_.load();
+  return statistics;
+}
+
+size_t TimerCoalescer::get_timer_count() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  const auto count = std::count_if(entries_.begin(), entries_.end(), [](const Entry & entry) {
+    const auto timer = entry.timer.lock();
+    return timer && !timer->is_canceled();
+  });
+  return static_cast<size_t>(count);
+}
+
+void TimerCoalescer::run()
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+  std::vector<CoalescedTimer::SharedPtr> expired;
+  while (!stop_requested_) {
+    auto wakeup = std::chrono::steady_clock::time_point::max();
+    entries_.erase(
+      std::remove_if(
+        entries_.begin(), entries_.end(),
+        [&wakeup](const Entry & entry) {
+          const auto timer = entry.timer.lock();
+          if (!timer || timer->is_canceled()) {
+            return true;
+          }
+          wakeup = std::min(wakeup, entry.expiration + timer->get_tolerance());
+          return false;
+        }),
+      entries_.end());
+
+    if (wakeup == std::chrono::steady_clock::time_point::max()) {
+      condition_.wait(lock);
+      continue;
+    }
+    // woken up early by a new timer, which may end its tolerance first
+    if (condition_.wait_until(lock, wakeup) == std::cv_status::no_timeout) {
+      continue;
+    }
+    if (stop_requested_) {
+      break;
+    }
+
+    const auto now = std::chrono::steady_clock::now();
+    wakeup_count_.fetch_add(1);
+    for (auto & entry : entries_) {
+      auto timer = entry.timer.lock();
+      if (!timer || entry.expiration > now) {
+        continue;
+      }
+      // the missed expirations are not caught up
+      const auto period = timer->get_period();
+      entry.expiration += ((now - entry.expiration) / period + 1) * period;
+      expired.push_back(std::move(timer));
+    }
+    expiration_count_.fetch_add(expired.size());
+
+    lock.unlock();
+    for (const auto & timer : expired) {
+      if (!timer->expire()) {
+        skipped_count_.fetch_add(1);
+      }
+    }
+    // the timers are destroyed without the lock if their handles are gone
+    expired.clear();
+    rusage usage{};
+    if (getrusage(RUSAGE_THREAD, &usage) == 0) {
+      voluntary_context_switches_.store(usage.ru_nvcsw);
+      involuntary_context_switches_.store(usage.ru_nivcsw);
+    }
+    lock.lock();
+  }
+}
+
+}  // namespace autoware::node
@@ -0,0 +1,163 @@
+// Copyright 2024 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <autoware/node/async_logger.hpp>
+#include <autoware/node/node.hpp>
+#include <rclcpp/rclcpp.hpp>
+
+#include <rcutils/logging.h>
+#include <rcutils/time.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdarg>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+namespace
+{
+std::mutex output_mutex;
+std::vector<std::string> output_messages;
+rcutils_time_point_value_t last_output_timestamp = 0;
+
+void capture_output(
+  const rcutils_log_location_t *, int, const char * name, rcutils_time_point_value_t timestamp,
+  const char * format, va_list * args)
+{
+  char message[1024];
+  std::vsnprintf(message, sizeof(message), format, *args);
+  std::lock_guard<std::mutex> lock(output_mutex);
+  output_messages.push_back(std::string(name) + ": " + message);
+  last_output_timestamp = timestamp;
+}
+
+std::vector<std::string> take_output_messages()
+{
+  autoware::node::AsyncLogBuffer::get_instance().flush();
+  std::lock_guard<std::mutex> lock(output_mutex);
+  std::vector<std::string> messages;
+  messages.swap(output_messages);
+  return messages;
+}
+}  // namespace
+
+class AutowareNodeAsyncLogger : public ::testing::Test
+{
+public:
+  void SetUp() override
+  {
+    rclcpp::init(0, nullptr);
+    rcutils_logging_set_output_handler(capture_output);
+    take_output_messages();
+  }
+
+  void TearDown() override { rclcpp::shutdown(); }
+
+  rclcpp::NodeOptions node_options_an_;
+};
+
+TEST_F(AutowareNodeAsyncLogger, LazyFormatting)
+{
+  autoware::node::AsyncLogger logger("async_logger_test");
+  {
+    // the strings are copied, they may be destroyed before the formatting
+    std::string text = "temporary";
+    AUTOWARE_ASYNC_INFO(logger, "value %d %s %.1f", 42, text.c_str(), 1.5);
+    text.assign(200, 'x');
+    AUTOWARE_ASYNC_WARN(logger, "long %s", text.c_str());
+  }
+  AUTOWARE_ASYNC_DEBUG(logger, "below the level of the logger %d", 0);
+
+  const auto messages = take_output_messages();
+  ASSERT_EQ(messages.size(), 2u);
+  EXPECT_EQ(messages[0], "async_logger_test: value 42 temporary 1.5");
+  EXPECT_EQ(messages[1], "async_logger_test: long " + std::string(95, 'x'));
+}
+
+TEST_F(AutowareNodeAsyncLogger, TimestampOfTheLogCall)
+{
+  autoware::node::AsyncLogger logger("async_logger_test");
+  rcutils_time_point_value_t before = 0;
+  rcutils_time_point_value_t after = 0;
+  ASSERT_EQ(rcutils_system_time_now(&before), RCUTILS_RET_OK);
+  AUTOWARE_ASYNC_INFO(logger, "timestamp");
+  ASSERT_EQ(rcutils_system_time_now(&after), RCUTILS_RET_OK);
+  std::this_thread::sleep_for(50ms);
+
+  // the output shows when the record was logged, not when it was written
+  ASSERT_EQ(take_output_messages().size(), 1u);
+  std::lock_guard<std::mutex> lock(output_mutex);
+  EXPECT_GE(last_output_timestamp, before);
+  EXPECT_LE(last_output_timestamp, after);
+}
+
+TEST_F(AutowareNodeAsyncLogger, RateLimit)
+{
+  autoware::node::AsyncLogger logger("async_logger_test");
+  const auto log = [&](const int i) { AUTOWARE_ASYNC_INFO_THROTTLE(logger, 100, "cycle %d", i); };
+  for (int i = 0; i < 10; ++i) {
+    log(i);
+  }
+  std::this_thread::sleep_for(150ms);
+  log(10);
+
+  const auto messages = take_output_messages();
+  ASSERT_EQ(messages.size(), 2u);
+  EXPECT_EQ(messages[0], "async_logger_test: cycle 0");
+  EXPECT_EQ(messages[1], "async_logger_test: cycle 10 (9 suppressed)");
+}
+
+TEST_F(AutowareNodeAsyncLogger, ConcurrentProducers)
+{
+  autoware::node::AsyncLogger logger("async_logger_test");
+  constexpr int num_threads = 4;
+  constexpr int num_records = 200;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < num_threads; ++t) {
+    threads.emplace_back([&logger, t]() {
+      for (int i = 0; i < num_records; ++i) {
+        AUTOWARE_ASYNC_INFO(logger, "thread %d record %d", t, i);
+      }
+    });
+  }
+  for (auto & thread : threads) {
+    thread.join();
+  }
+
+  // records are dropped, and reported, rather than blocking the producers when the queue is full
+  const auto dropped_count = autoware::node::AsyncLogBuffer::get_instance().get_dropped_count();
+  const auto messages = take_output_messages();
+  EXPECT_GE(messages.size() + dropped_count, static_cast<size_t>(num_threads * num_records));
+}
+
+TEST_F(AutowareNodeAsyncLogger, NodeLogger)
+{
+  auto node = std::make_shared<autoware::node::Node>("test_node", "", node_options_an_);
+  AUTOWARE_ASYNC_INFO(node->get_async_logger(), "from %s", node->get_name());
+  node.reset();
+
+  // the records are written before the logger is destroyed
+  std::lock_guard<std::mutex> lock(output_mutex);
+  EXPECT_NE(
+    std::find(output_messages.begin(), output_messages.end(), "test_node: from test_node"),
+    output_messages.end());
+}
@@ -0,0 +1,89 @@
+// Copyright 2024 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <autoware/node/latency_histogram.hpp>
+#include <autoware/node/node.hpp>
+#include <rclcpp/rclcpp.hpp>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <memory>
+
+TEST(LatencyHistogram, Percentile)
+{
+  autoware::node::LatencyHistogram histogram;
+  for (uint64_t i = 1; i <= 1000; ++i) {
+    histogram.record(i * 1000);
+  }
+
+  const auto snapshot = histogram.snapshot();
+  EXPECT_EQ(snapshot.count, 1000u);
+  EXPECT_EQ(snapshot.min, 1000u);
+  EXPECT_EQ(snapshot.max, 1000000u);
+  EXPECT_DOUBLE_EQ(snapshot.mean, 500500.0);
+  // the buckets have a relative error below 6.25 %
+  EXPECT_NEAR(snapshot.percentile(50.0), 500000.0, 500000.0 * 0.0625);
+  EXPECT_NEAR(snapshot.percentile(99.0), 990000.0, 990000.0 * 0.0625);
+  EXPECT_EQ(snapshot.percentile(100.0), 1000000u);
+
+  histogram.reset();
+  EXPECT_EQ(histogram.snapshot().count, 0u);
+}
+
+class AutowareNodeCallbackLatency : public ::testing::Test
+{
+public:
+  void SetUp() override { rclcpp::init(0, nullptr); }
+
+  void TearDown() override { rclcpp::shutdown(); }
+
+  rclcpp::NodeOptions node_options_an_;
+};
+
+TEST_F(AutowareNodeCallbackLatency, MonitoredTimer)
+{
+  auto autoware_node =
+    std::make_shared<autoware::node::Node>("test_node", "test_ns", node_options_an_);
+
+  int count = 0;
+  auto timer = autoware_node->create_monitored_timer(
+    "test_timer", std::chrono::milliseconds(1), [&count]() { ++count; });
+
+  rclcpp::executors::SingleThreadedExecutor executor;
+  executor.add_node(autoware_node->get_node_base_interface());
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while (count < 10 && std::chrono::steady_clock::now() < deadline) {
+    executor.spin_once(std::chrono::milliseconds(10));
+  }
+  ASSERT_GE(count, 10);
+
+  auto snapshots = autoware_node->get_callback_latency_snapshots();
+  ASSERT_EQ(snapshots.size(), 1u);
+  EXPECT_EQ(snapshots.front().name, "timer test_timer");
+  EXPECT_EQ(snapshots.front().execution_time.count, static_cast<uint64_t>(count));
+  EXPECT_EQ(snapshots.front().queueing_delay.count, static_cast<uint64_t>(count));
+
+  // the recording is switched off at runtime
+  autoware_node->set_parameter(rclcpp::Parameter("callback_latency.enabled", false));
+  const int disabled_count = count;
+  deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while (count < disabled_count + 10 && std::chrono::steady_clock::now() < deadline) {
+    executor.spin_once(std::chrono::milliseconds(10));
+  }
+  ASSERT_GE(count, disabled_count + 10);
+
+  snapshots = autoware_node->get_callback_latency_snapshots();
+  EXPECT_EQ(snapshots.front().execution_time.count, static_cast<uint64_t>(disabled_count));
+}
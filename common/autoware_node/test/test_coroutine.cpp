@@ -0,0 +1,188 @@
+// Copyright 2024 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <autoware/node/coroutine.hpp>
+#include <autoware/node/node.hpp>
+#include <rclcpp/rclcpp.hpp>
+
+#include <std_msgs/msg/int32.hpp>
+#include <std_srvs/srv/set_bool.hpp>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+using namespace std::chrono_literals;
+using std_msgs::msg::Int32;
+using std_srvs::srv::SetBool;
+
+class AutowareNodeCoroutine : public ::testing::Test
+{
+public:
+  void SetUp() override { rclcpp::init(0, nullptr); }
+
+  void TearDown() override { rclcpp::shutdown(); }
+
+  template <typename PredicateT>
+  bool spin_until(rclcpp::Executor & executor, PredicateT && predicate)
+  {
+    const auto deadline = std::chrono::steady_clock::now() + 3s;
+    while (!predicate() && std::chrono::steady_clock::now() < deadline) {
+      executor.spin_some(10ms);
+    }
+    return predicate();
+  }
+
+  rclcpp::NodeOptions node_options_an_;
+};
+
+namespace
+{
+// lambda coroutines must not capture, as the closure is destroyed at the first suspension
+autoware::node::Coroutine<bool> toggle(
+  autoware::node::Node & node, const rclcpp::Client<SetBool>::SharedPtr & client, const bool data)
+{
+  auto request = std::make_shared<SetBool::Request>();
+  request->data = data;
+  const auto response = co_await autoware::node::async_call<SetBool>(node, client, request);
+  co_return response->success;
+}
+
+autoware::node::Coroutine<> toggle_twice(
+  autoware::node::Node & node, rclcpp::Client<SetBool>::SharedPtr client,
+  std::vector<bool> & results)
+{
+  results.push_back(co_await toggle(node, client, true));
+  co_await autoware::node::async_sleep(node, 10ms);
+  results.push_back(co_await toggle(node, client, false));
+}
+
+autoware::node::Coroutine<> call_missing(
+  autoware::node::Node & node, rclcpp::Client<SetBool>::SharedPtr client,
+  SetBool::Response::SharedPtr & response, Int32::ConstSharedPtr & message, bool & finished)
+{
+  response = co_await autoware::node::async_call<SetBool>(
+    node, client, std::make_shared<SetBool::Request>(), 50ms);
+  message = co_await autoware::node::async_wait_for_message<Int32>(
+    node, "missing_topic", rclcpp::QoS(1), 50ms);
+  finished = true;
+}
+
+autoware::node::Coroutine<> receive_twice(autoware::node::Node & node, std::vector<int> & data)
+{
+  for (int i = 0; i < 2; ++i) {
+    const auto message =
+      co_await autoware::node::async_wait_for_message<Int32>(node, "test_topic", rclcpp::QoS(1));
+    data.push_back(message->data);
+  }
+}
+
+autoware::node::Coroutine<int> fail()
+{
+  throw std::runtime_error("failure");
+  co_return 0;
+}
+
+autoware::node::Coroutine<> catch_failure(bool & caught)
+{
+  try {
+    co_await fail();
+  } catch (const std::runtime_error &) {
+    caught = true;
+  }
+}
+}  // namespace
+
+TEST_F(AutowareNodeCoroutine, CallsServicesOnSingleThreadedExecutor)
+{
+  auto autoware_node =
+    std::make_shared<autoware::node::Node>("test_node", "test_ns", node_options_an_);
+  const auto service = autoware_node->create_service<SetBool>(
+    "test_service",
+    [](const SetBool::Request::SharedPtr request, SetBool::Response::SharedPtr response) {
+      response->success = request->data;
+    });
+  const auto client = autoware_node->create_client<SetBool>("test_service");
+
+  rclcpp::executors::SingleThreadedExecutor executor;
+  executor.add_node(autoware_node->get_node_base_interface());
+
+  // a synchronous call from a timer callback would block the server on the same executor
+  std::vector<bool> results;
+  bool started = false;
+  const auto timer = autoware_node->create_wall_timer(1ms, [&]() {
+    if (!started) {
+      started = true;
+      autoware::node::spawn(toggle_twice(*autoware_node, client, results));
+    }
+  });
+
+  EXPECT_TRUE(spin_until(executor, [&results]() { return results.size() == 2; }));
+  EXPECT_EQ(results, (std::vector<bool>{true, false}));
+}
+
+TEST_F(AutowareNodeCoroutine, TimesOut)
+{
+  auto autoware_node =
+    std::make_shared<autoware::node::Node>("test_node", "test_ns", node_options_an_);
+  const auto client = autoware_node->create_client<SetBool>("missing_service");
+
+  rclcpp::executors::SingleThreadedExecutor executor;
+  executor.add_node(autoware_node->get_node_base_interface());
+
+  bool finished = false;
+  auto response = std::make_shared<SetBool::Response>();
+  Int32::ConstSharedPtr message = std::make_shared<Int32>();
+  autoware::node::spawn(call_missing(*autoware_node, client, response, message, finished));
+
+  EXPECT_TRUE(spin_until(executor, [&finished]() { return finished; }));
+  EXPECT_EQ(response, nullptr);
+  EXPECT_EQ(message, nullptr);
+}
+
+TEST_F(AutowareNodeCoroutine, WaitsForMessages)
+{
+  auto autoware_node =
+    std::make_shared<autoware::node::Node>("test_node", "test_ns", node_options_an_);
+  auto publisher_node = std::make_shared<rclcpp::Node>("publisher_node", "test_ns");
+  auto publisher = publisher_node->create_publisher<Int32>("test_topic", rclcpp::QoS(1));
+
+  rclcpp::executors::SingleThreadedExecutor executor;
+  executor.add_node(autoware_node->get_node_base_interface());
+  executor.add_node(publisher_node);
+
+  std::vector<int> data;
+  autoware::node::spawn(receive_twice(*autoware_node, data));
+
+  int next = 0;
+  const auto timer = publisher_node->create_wall_timer(10ms, [&]() {
+    Int32 message;
+    message.data = next++;
+    publisher->publish(message);
+  });
+
+  EXPECT_TRUE(spin_until(executor, [&data]() { return data.size() == 2; }));
+  ASSERT_EQ(data.size(), 2u);
+  EXPECT_LT(data[0], data[1]);
+}
+
+TEST_F(AutowareNodeCoroutine, PropagatesExceptions)
+{
+  bool caught = false;
+  autoware::node::spawn(catch_failure(caught));
+  EXPECT_TRUE(caught);
+}
@@ -0,0 +1,151 @@
+// Copyright 2024 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <autoware/node/flight_recorder.hpp>
+#include <autoware/node/node.hpp>
+#include <rclcpp/rclcpp.hpp>
+
+#include <diagnostic_msgs/msg/diagnostic_array.hpp>
+#include <std_msgs/msg/string.hpp>
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+using diagnostic_msgs::msg::DiagnosticArray;
+using diagnostic_msgs::msg::DiagnosticStatus;
+using diagnostic_msgs::msg::KeyValue;
+using std_msgs::msg::String;
+
+class AutowareNodeFlightRecorder : public ::testing::Test
+{
+public:
+  void SetUp() override { rclcpp::init(0, nullptr); }
+
+  void TearDown() override { rclcpp::shutdown(); }
+
+  rclcpp::NodeOptions node_options_an_;
+};
+
+TEST_F(AutowareNodeFlightRecorder, RingKeepsLastMessagesWithoutCopy)
+{
+  autoware::node::TypedFlightRecorderTopic<String> topic("/input", 3);
+  EXPECT_EQ(topic.get_type_name(), "std_msgs/msg/String");
+
+  std::vector<String::ConstSharedPtr> messages;
+  for (int i = 0; i < 5; ++i) {
+    auto message = std::make_shared<String>();
+    message->data = std::to_string(i);
+    messages.push_back(message);
+    topic.record(message, i);
+  }
+
+  const auto records = topic.get_records(3);
+  ASSERT_EQ(records.size(), 2u);
+  EXPECT_EQ(records[0].time, 3);
+  EXPECT_EQ(records[0].message.get(), messages[3].get());
+  EXPECT_EQ(records[1].message.get(), messages[4].get());
+  EXPECT_EQ(topic.get_records(0).size(), 3u);
+}
+
+TEST_F(AutowareNodeFlightRecorder, RingKeepsMessagesWithinMaxBytes)
+{
+  autoware::node::TypedFlightRecorderTopic<String> typed_topic("/input", 10, 100);
+  autoware::node::FlightRecorderTopic & topic = typed_topic;
+  for (int i = 0; i < 5; ++i) {
+    topic.record(std::make_shared<int>(i), i, 40);
+  }
+  // the oldest messages are released to keep 100 bytes
+  const auto records = topic.get_records(0);
+  ASSERT_EQ(records.size(), 2u);
+  EXPECT_EQ(records[0].time, 3);
+  EXPECT_EQ(records[1].time, 4);
+  EXPECT_EQ(topic.get_total_bytes(), 80u);
+
+  // the last message is kept even if it exceeds the limit
+  topic.record(std::make_shared<int>(5), 5, 1000);
+  ASSERT_EQ(topic.get_records(0).size(), 1u);
+  EXPECT_EQ(topic.get_total_bytes(), 1000u);
+}
+
+TEST_F(AutowareNodeFlightRecorder, TypedTopicEstimatesSizeAndCopies)
+{
+  autoware::node::TypedFlightRecorderTopic<String> topic("/input", 10, 1024 * 1024);
+  auto message = std::make_shared<String>();
+  message->data = std::string(1000, 'a');
+  topic.record(message, 0);
+  auto records = topic.get_records(0);
+  ASSERT_EQ(records.size(), 1u);
+  EXPECT_GE(records[0].size, 1000u);
+  EXPECT_EQ(records[0].message.get(), message.get());
+
+  // loaned messages are copied, as the middleware reuses them after the callback
+  topic.set_copy_messages(true);
+  topic.record(message, 1);
+  records = topic.get_records(1);
+  ASSERT_EQ(records.size(), 1u);
+  EXPECT_NE(records[0].message.get(), message.get());
+  EXPECT_EQ(static_cast<const String *>(records[0].message.get())->data, message->data);
+}
+
+TEST_F(AutowareNodeFlightRecorder, TypedTopicEstimatesSizeWithoutSerializing)
+{
+  // the estimate of every message is the memory it holds, not a sampled serialized size, which
+  // would add the CDR header and lengths and be reused for the following messages
+  autoware::node::TypedFlightRecorderTopic<String> topic("/input", 20, 1024 * 1024);
+  for (size_t i = 0; i < 20; ++i) {
+    auto message = std::make_shared<String>();
+    message->data = std::string(100 * i, 'a');
+    topic.record(message, static_cast<int64_t>(i));
+  }
+  const auto records = topic.get_records(0);
+  ASSERT_EQ(records.size(), 20u);
+  for (size_t i = 0; i < records.size(); ++i) {
+    EXPECT_EQ(records[i].size, sizeof(String) + 100 * i);
+  }
+
+  // nested sequences of messages and strings are walked as well
+  autoware::node::TypedFlightRecorderTopic<DiagnosticArray> diagnostics_topic(
+    "/diagnostics", 1, 1024 * 1024);
+  auto diagnostics = std::make_shared<DiagnosticArray>();
+  diagnostics->header.frame_id = "base_link";
+  diagnostics->status.resize(2);
+  diagnostics->status[1].name = "status";
+  diagnostics->status[1].values.resize(1);
+  diagnostics->status[1].values[0].value = "value";
+  diagnostics_topic.record(diagnostics, 0);
+  EXPECT_EQ(
+    diagnostics_topic.get_records(0).at(0).size,
+    sizeof(DiagnosticArray) + 9 + 2 * sizeof(DiagnosticStatus) + 6 + sizeof(KeyValue) + 5);
+}
+
+TEST_F(AutowareNodeFlightRecorder, SubscriptionParameters)
+{
+  node_options_an_.parameter_overrides(
+    {{"flight_recorder.enabled", true},
+     {"flight_recorder.max_bytes", 1000},
+     {"flight_recorder.topics.test_ns.large.max_bytes", 0}});
+  auto autoware_node =
+    std::make_shared<autoware::node::Node>("test_node", "test_ns", node_options_an_);
+  auto subscription = autoware_node->create_monitored_subscription<String>(
+    "input", rclcpp::QoS(10), [](String::ConstSharedPtr) {});
+  auto large_subscription = autoware_node->create_monitored_subscription<String>(
+    "large", rclcpp::QoS(10), [](String::ConstSharedPtr) {});
+  EXPECT_EQ(
+    autoware_node->get_parameter("flight_recorder.topics.test_ns.input.max_bytes").as_int(), 1000);
+  EXPECT_EQ(
+    autoware_node->get_parameter("flight_recorder.topics.test_ns.large.max_bytes").as_int(), 0);
+}
@@ -0,0 +1,126 @@
+// Copyright 2024 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <autoware/node/node.hpp>
+#include <rclcpp/rclcpp.hpp>
+
+#include <std_msgs/msg/string.hpp>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <memory>
+#include <thread>
+
+using namespace std::chrono_literals;
+using std_msgs::msg::String;
+
+class AutowareNodeGatedPublisher : public ::testing::Test
+{
+public:
+  void SetUp() override { rclcpp::init(0, nullptr); }
+
+  void TearDown() override { rclcpp::shutdown(); }
+
+  rclcpp::NodeOptions node_options_an_;
+};
+
+template <typename PredicateT>
+bool wait_until(PredicateT && predicate)
+{
+  const auto deadline = std::chrono::steady_clock::now() + 3s;
+  while (std::chrono::steady_clock::now() < deadline) {
+    if (predicate()) {
+      return true;
+    }
+    std::this_thread::sleep_for(10ms);
+  }
+  return false;
+}
+
+TEST_F(AutowareNodeGatedPublisher, SkipsUnneededMessages)
+{
+  auto autoware_node =
+    std::make_shared<autoware::node::Node>("test_node", "test_ns", node_options_an_);
+  auto publisher = autoware_node->create_gated_publisher<String>("test_topic", rclcpp::QoS(1));
+
+  int build_count = 0;
+  const auto build = [&build_count]() {
+    ++build_count;
+    String message;
+    message.data = "expensive";
+    return message;
+  };
+
+  // inactive
+  EXPECT_FALSE(publisher->should_publish());
+  EXPECT_FALSE(publisher->publish(build));
+
+  // active, but nobody subscribes
+  autoware_node->configure();
+  autoware_node->activate();
+  EXPECT_FALSE(publisher->should_publish());
+  EXPECT_FALSE(publisher->publish(build));
+  EXPECT_EQ(build_count, 0);
+  EXPECT_EQ(publisher->get_skipped_count(), 2u);
+
+  // the cached count follows the graph events
+  auto subscriber_node = std::make_shared<rclcpp::Node>("subscriber_node", "test_ns");
+  auto subscription = subscriber_node->create_subscription<String>(
+    "test_topic", rclcpp::QoS(1), [](String::ConstSharedPtr) {});
+  ASSERT_TRUE(wait_until([&]() { return publisher->should_publish(); }));
+  EXPECT_TRUE(publisher->publish(build));
+  EXPECT_TRUE(publisher->publish([]() { return std::make_unique<String>(); }));
+  EXPECT_EQ(build_count, 1);
+
+  subscription.reset();
+  ASSERT_TRUE(wait_until([&]() { return !publisher->should_publish(); }));
+
+  autoware_node->deactivate();
+  EXPECT_FALSE(publisher->should_publish());
+}
+
+TEST_F(AutowareNodeGatedPublisher, TransientLocalIsNotGatedBySubscriptions)
+{
+  auto autoware_node =
+    std::make_shared<autoware::node::Node>("test_node", "test_ns", node_options_an_);
+  auto publisher = autoware_node->create_gated_publisher<String>(
+    "test_topic", rclcpp::QoS(1).transient_local());
+  autoware_node->configure();
+  autoware_node->activate();
+  EXPECT_TRUE(publisher->should_publish());
+}
+
+TEST_F(AutowareNodeGatedPublisher, FollowsSubscriptionsOfAnotherParticipant)
+{
+  auto autoware_node =
+    std::make_shared<autoware::node::Node>("test_node", "test_ns", node_options_an_);
+  auto publisher = autoware_node->create_gated_publisher<String>("test_topic", rclcpp::QoS(1));
+  autoware_node->configure();
+  autoware_node->activate();
+
+  // a context of its own has its own participant, so that the subscription is matched through
+  // discovery like one of another process, and may not be counted on the graph event yet
+  auto subscriber_context = std::make_shared<rclcpp::Context>();
+  subscriber_context->init(0, nullptr);
+  auto subscriber_node = std::make_shared<rclcpp::Node>(
+    "subscriber_node", "test_ns", rclcpp::NodeOptions().context(subscriber_context));
+  auto subscription = subscriber_node->create_subscription<String>(
+    "test_topic", rclcpp::QoS(1), [](String::ConstSharedPtr) {});
+  EXPECT_TRUE(wait_until([&]() { return publisher->should_publish(); }));
+
+  subscription.reset();
+  subscriber_node.reset();
+  subscriber_context->shutdown("test finished");
+}
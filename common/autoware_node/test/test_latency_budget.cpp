@@ -0,0 +1,130 @@
+// Copyright 2024 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <autoware/node/latency_budget.hpp>
+#include <autoware/node/node.hpp>
+#include <rclcpp/rclcpp.hpp>
+
+#include <diagnostic_msgs/msg/diagnostic_array.hpp>
+#include <std_msgs/msg/string.hpp>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <memory>
+#include <string>
+
+using namespace std::chrono_literals;
+using diagnostic_msgs::msg::DiagnosticArray;
+using diagnostic_msgs::msg::DiagnosticStatus;
+using std_msgs::msg::String;
+
+class AutowareNodeLatencyBudget : public ::testing::Test
+{
+public:
+  void SetUp() override { rclcpp::init(0, nullptr); }
+
+  void TearDown() override { rclcpp::shutdown(); }
+
+  rclcpp::NodeOptions node_options_an_;
+};
+
+TEST_F(AutowareNodeLatencyBudget, OriginTime)
+{
+  DiagnosticArray with_header;
+  with_header.header.stamp.sec = 2;
+  with_header.header.stamp.nanosec = 5;
+  EXPECT_EQ(autoware::node::get_origin_time(with_header), 2000000005);
+  EXPECT_EQ(autoware::node::get_origin_time(String()), 0);
+}
+
+TEST_F(AutowareNodeLatencyBudget, UsesTheClockOfTheHeaderStamps)
+{
+  auto clock = std::make_shared<rclcpp::Clock>(RCL_ROS_TIME);
+  autoware::node::LatencyBudgetMonitor monitor(clock);
+  EXPECT_FALSE(monitor.is_sim_time());
+  EXPECT_GT(monitor.now(), 0);
+
+  // e.g. a bag replayed with use_sim_time
+  ASSERT_EQ(rcl_enable_ros_time_override(clock->get_clock_handle()), RCL_RET_OK);
+  ASSERT_EQ(rcl_set_ros_time_override(clock->get_clock_handle(), 42000000000), RCL_RET_OK);
+  EXPECT_TRUE(monitor.is_sim_time());
+  EXPECT_EQ(monitor.now(), 42000000000);
+
+  auto statistics = monitor.add("input", 100000000);
+  autoware::node::LatencyBudgetMonitor::record(*statistics, 41950000000, 0, monitor.now());
+  EXPECT_EQ(statistics->overrun_count.load(), 0u);
+  EXPECT_EQ(statistics->cumulative_latency.snapshot().count, 1u);
+}
+
+TEST_F(AutowareNodeLatencyBudget, PropagatesOriginAndReportsOverruns)
+{
+  node_options_an_.parameter_overrides(
+    {{"latency_budget.topics.test_ns.output", 0.05},
+     {"latency_budget.diagnostics_period", 0.05}});
+  auto autoware_node =
+    std::make_shared<autoware::node::Node>("test_node", "test_ns", node_options_an_);
+
+  // the output has no header, so its origin is the header stamp of the input being processed
+  auto output_publisher =
+    autoware_node->create_monitored_publisher<String>("output", rclcpp::QoS(10));
+  auto input_subscription = autoware_node->create_monitored_subscription<DiagnosticArray>(
+    "input", rclcpp::QoS(10),
+    [&output_publisher](DiagnosticArray::ConstSharedPtr) { output_publisher->publish(String()); });
+  autoware_node->configure();
+  autoware_node->activate();
+
+  auto test_node = std::make_shared<rclcpp::Node>("test_driver", "test_ns");
+  auto input_publisher = test_node->create_publisher<DiagnosticArray>("input", rclcpp::QoS(10));
+  bool warned = false;
+  auto diagnostics_subscription = test_node->create_subscription<DiagnosticArray>(
+    "/diagnostics", rclcpp::QoS(10), [&warned](DiagnosticArray::ConstSharedPtr diagnostics) {
+      for (const auto & status : diagnostics->status) {
+        warned |= status.name == "/test_ns/test_node: latency_budget" &&
+                  status.level == DiagnosticStatus::WARN;
+      }
+    });
+
+  rclcpp::executors::SingleThreadedExecutor executor;
+  executor.add_node(autoware_node->get_node_base_interface());
+  executor.add_node(test_node);
+  const auto deadline = std::chrono::steady_clock::now() + 3s;
+  while (!warned && std::chrono::steady_clock::now() < deadline) {
+    // data which is already 100 ms old
+    DiagnosticArray input;
+    input.header.stamp = test_node->now() - rclcpp::Duration(100ms);
+    input_publisher->publish(input);
+    executor.spin_some(10ms);
+  }
+  EXPECT_TRUE(warned);
+
+  bool found_input = false;
+  bool found_output = false;
+  for (const auto & snapshot : autoware_node->get_latency_budget_snapshots()) {
+    ASSERT_GT(snapshot.cumulative_latency.count, 0u) << snapshot.name;
+    EXPECT_GE(snapshot.cumulative_latency.min, 100000000u) << snapshot.name;
+    if (snapshot.name == "input /test_ns/input") {
+      found_input = true;
+      EXPECT_EQ(snapshot.budget, 0);
+      EXPECT_EQ(snapshot.overrun_count, 0u);
+    } else if (snapshot.name == "output /test_ns/output") {
+      found_output = true;
+      EXPECT_EQ(snapshot.budget, 50000000);
+      EXPECT_EQ(snapshot.overrun_count, snapshot.cumulative_latency.count);
+      EXPECT_GT(snapshot.hop_latency.count, 0u);
+    }
+  }
+  EXPECT_TRUE(found_input);
+  EXPECT_TRUE(found_output);
+}
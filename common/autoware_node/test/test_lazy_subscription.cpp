@@ -0,0 +1,113 @@
+// Copyright 2024 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <autoware/node/node.hpp>
+#include <rclcpp/rclcpp.hpp>
+
+#include <std_msgs/msg/string.hpp>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <memory>
+#include <thread>
+
+using namespace std::chrono_literals;
+using std_msgs::msg::String;
+
+class AutowareNodeLazySubscription : public ::testing::Test
+{
+public:
+  void SetUp() override { rclcpp::init(0, nullptr); }
+
+  void TearDown() override { rclcpp::shutdown(); }
+
+  rclcpp::NodeOptions node_options_an_;
+};
+
+template <typename PredicateT>
+bool wait_until(PredicateT && predicate)
+{
+  const auto deadline = std::chrono::steady_clock::now() + 3s;
+  while (std::chrono::steady_clock::now() < deadline) {
+    if (predicate()) {
+      return true;
+    }
+    std::this_thread::sleep_for(10ms);
+  }
+  return false;
+}
+
+TEST_F(AutowareNodeLazySubscription, FollowsDownstreamDemand)
+{
+  node_options_an_.parameter_overrides({{"lazy_subscription.hysteresis", 0.5}});
+  auto autoware_node =
+    std::make_shared<autoware::node::Node>("test_node", "test_ns", node_options_an_);
+  auto output_publisher = autoware_node->create_publisher<String>("output", rclcpp::QoS(1));
+  auto input_subscription = autoware_node->create_lazy_subscription<String>(
+    "input", rclcpp::QoS(1), [](String::ConstSharedPtr) {}, {output_publisher});
+
+  rclcpp::executors::SingleThreadedExecutor executor;
+  executor.add_node(autoware_node->get_node_base_interface());
+  std::thread thread_spin([&executor]() { executor.spin(); });
+
+  // nobody consumes the output
+  std::this_thread::sleep_for(300ms);
+  EXPECT_FALSE(input_subscription->is_subscribed());
+  EXPECT_EQ(autoware_node->count_subscribers("input"), 0u);
+
+  auto downstream_node = std::make_shared<rclcpp::Node>("downstream_node", "test_ns");
+  auto downstream_subscription = downstream_node->create_subscription<String>(
+    "output", rclcpp::QoS(1), [](String::ConstSharedPtr) {});
+  EXPECT_TRUE(wait_until([&]() { return input_subscription->is_subscribed(); }));
+
+  // kept for the hysteresis period after the demand disappears
+  downstream_subscription.reset();
+  const auto demand_end = std::chrono::steady_clock::now();
+  EXPECT_TRUE(wait_until([&]() { return !input_subscription->is_subscribed(); }));
+  EXPECT_GE(std::chrono::steady_clock::now() - demand_end, 400ms);
+  EXPECT_EQ(input_subscription->get_subscribe_count(), 1u);
+
+  executor.cancel();
+  thread_spin.join();
+}
+
+TEST_F(AutowareNodeLazySubscription, FollowsDemandOfAnotherParticipant)
+{
+  // a context of its own has its own participant, so that the downstream subscription is matched
+  // through discovery like one of another process, and may not be counted on the graph event yet
+  auto autoware_node =
+    std::make_shared<autoware::node::Node>("test_node", "test_ns", node_options_an_);
+  auto output_publisher = autoware_node->create_publisher<String>("output", rclcpp::QoS(1));
+  auto input_subscription = autoware_node->create_lazy_subscription<String>(
+    "input", rclcpp::QoS(1), [](String::ConstSharedPtr) {}, {output_publisher});
+
+  rclcpp::executors::SingleThreadedExecutor executor;
+  executor.add_node(autoware_node->get_node_base_interface());
+  std::thread thread_spin([&executor]() { executor.spin(); });
+
+  auto downstream_context = std::make_shared<rclcpp::Context>();
+  downstream_context->init(0, nullptr);
+  auto downstream_node = std::make_shared<rclcpp::Node>(
+    "downstream_node", "test_ns", rclcpp::NodeOptions().context(downstream_context));
+  auto downstream_subscription = downstream_node->create_subscription<String>(
+    "output", rclcpp::QoS(1), [](String::ConstSharedPtr) {});
+  EXPECT_TRUE(wait_until([&]() { return input_subscription->is_subscribed(); }));
+
+  executor.cancel();
+  thread_spin.join();
+  downstream_subscription.reset();
+  downstream_node.reset();
+  downstream_context->shutdown("test finished");
+}
@@ -0,0 +1,166 @@
+// Copyright 2024 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <autoware/node/lifecycle_manager.hpp>
+#include <autoware/node/node.hpp>
+#include <rclcpp/rclcpp.hpp>
+
+#include <autoware_node_msgs/srv/change_node_state.hpp>
+#include <autoware_node_msgs/srv/get_node_states.hpp>
+#include <lifecycle_msgs/msg/state.hpp>
+#include <lifecycle_msgs/msg/transition.hpp>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+using autoware_node_msgs::srv::ChangeNodeState;
+using autoware_node_msgs::srv::GetNodeStates;
+using lifecycle_msgs::msg::State;
+using lifecycle_msgs::msg::Transition;
+using namespace std::chrono_literals;
+
+class AutowareNodeLifecycleManager : public ::testing::Test
+{
+public:
+  void SetUp() override
+  {
+    rclcpp::init(0, nullptr);
+    node_options_an_.parameter_overrides({{"lifecycle_manager.enabled", true}});
+  }
+
+  void TearDown() override { rclcpp::shutdown(); }
+
+  template <typename ServiceT>
+  typename ServiceT::Response::SharedPtr call(
+    const rclcpp::Node::SharedPtr & node, const std::string & service_name,
+    const typename ServiceT::Request::SharedPtr request)
+  {
+    auto client = node->create_client<ServiceT>(service_name);
+    if (!client->wait_for_service(5s)) {
+      return nullptr;
+    }
+    auto future = client->async_send_request(request);
+    if (rclcpp::spin_until_future_complete(node, future, 5s) != rclcpp::FutureReturnCode::SUCCESS) {
+      return nullptr;
+    }
+    return future.get();
+  }
+
+  rclcpp::NodeOptions node_options_an_;
+};
+
+TEST_F(AutowareNodeLifecycleManager, SharedEndpoint)
+{
+  auto node_a = std::make_shared<autoware::node::Node>("node_a", "test_ns", node_options_an_);
+  auto node_b = std::make_shared<autoware::node::Node>("node_b", "test_ns", node_options_an_);
+  ASSERT_NE(node_a->get_lifecycle_manager(), nullptr);
+  EXPECT_EQ(node_a->get_lifecycle_manager(), node_b->get_lifecycle_manager());
+  const std::string manager_name = node_a->get_lifecycle_manager()->get_fully_qualified_name();
+  EXPECT_TRUE(node_a->register_with_lifecycle_manager());
+  EXPECT_TRUE(node_b->register_with_lifecycle_manager());
+
+  auto client_node = std::make_shared<rclcpp::Node>("client");
+  auto change_state_request = std::make_shared<ChangeNodeState::Request>();
+  change_state_request->node_name = "/test_ns/node_a";
+  change_state_request->transition_id = Transition::TRANSITION_CONFIGURE;
+  const auto change_state_response =
+    call<ChangeNodeState>(client_node, manager_name + "/change_state", change_state_request);
+  ASSERT_NE(change_state_response, nullptr);
+  EXPECT_TRUE(change_state_response->success);
+  EXPECT_EQ(change_state_response->state.id, State::PRIMARY_STATE_INACTIVE);
+  EXPECT_EQ(node_a->get_current_state().id(), State::PRIMARY_STATE_INACTIVE);
+
+  change_state_request->node_name = "/test_ns/unknown";
+  const auto unknown_response =
+    call<ChangeNodeState>(client_node, manager_name + "/change_state", change_state_request);
+  ASSERT_NE(unknown_response, nullptr);
+  EXPECT_FALSE(unknown_response->success);
+
+  const auto get_states_response = call<GetNodeStates>(
+    client_node, manager_name + "/get_states", std::make_shared<GetNodeStates::Request>());
+  ASSERT_NE(get_states_response, nullptr);
+  const std::vector<std::string> expected_names{"/test_ns/node_a", "/test_ns/node_b"};
+  EXPECT_EQ(get_states_response->node_names, expected_names);
+  ASSERT_EQ(get_states_response->states.size(), 2u);
+  EXPECT_EQ(get_states_response->states[0].id, State::PRIMARY_STATE_INACTIVE);
+  EXPECT_EQ(get_states_response->states[1].id, State::PRIMARY_STATE_UNCONFIGURED);
+
+  // the nodes have no lifecycle service of their own
+  for (const auto & [service_name, types] : client_node->get_service_names_and_types()) {
+    EXPECT_EQ(service_name.find("/test_ns/node_a/change_state"), std::string::npos);
+    EXPECT_EQ(service_name.find("/test_ns/node_b/get_state"), std::string::npos);
+  }
+}
+
+TEST_F(AutowareNodeLifecycleManager, DisabledByDefault)
+{
+  auto autoware_node = std::make_shared<autoware::node::Node>("node_a", "test_ns");
+  EXPECT_EQ(autoware_node->get_lifecycle_manager(), nullptr);
+}
+
+TEST_F(AutowareNodeLifecycleManager, RegistersAfterConstruction)
+{
+  auto node_a = std::make_shared<autoware::node::Node>("node_a", "test_ns", node_options_an_);
+  const std::string manager_name = node_a->get_lifecycle_manager()->get_fully_qualified_name();
+  auto client_node = std::make_shared<rclcpp::Node>("client");
+  const auto get_names = [&]() {
+    const auto response = call<GetNodeStates>(
+      client_node, manager_name + "/get_states", std::make_shared<GetNodeStates::Request>());
+    return response ? response->node_names : std::vector<std::string>{};
+  };
+
+  // registered when first spun
+  EXPECT_TRUE(get_names().empty());
+  rclcpp::executors::SingleThreadedExecutor executor;
+  executor.add_node(node_a->get_node_base_interface());
+  executor.spin_some(100ms);
+  EXPECT_EQ(get_names(), std::vector<std::string>{"/test_ns/node_a"});
+
+  // and no longer found once its destruction has started
+  executor.remove_node(node_a->get_node_base_interface());
+  auto node_b = std::make_shared<autoware::node::Node>("node_b", "test_ns", node_options_an_);
+  node_b->register_with_lifecycle_manager();
+  node_a.reset();
+  EXPECT_EQ(get_names(), std::vector<std::string>{"/test_ns/node_b"});
+}
+
+TEST_F(AutowareNodeLifecycleManager, IgnoresInvalidOverride)
+{
+  node_options_an_.parameter_overrides({{"lifecycle_manager.enabled", 1}});
+  std::shared_ptr<autoware::node::Node> autoware_node;
+  EXPECT_NO_THROW(
+    autoware_node =
+      std::make_shared<autoware::node::Node>("node_a", "test_ns", node_options_an_));
+  EXPECT_EQ(autoware_node->get_lifecycle_manager(), nullptr);
+}
+
+TEST_F(AutowareNodeLifecycleManager, ResolvesCommandLineOverride)
+{
+  // e.g. --ros-args -p lifecycle_manager.enabled:=true in the arguments of a composable node
+  node_options_an_.arguments({"--ros-args", "-p", "lifecycle_manager.enabled:=true"});
+  auto autoware_node =
+    std::make_shared<autoware::node::Node>("node_a", "test_ns", node_options_an_);
+  EXPECT_NE(autoware_node->get_lifecycle_manager(), nullptr);
+  EXPECT_TRUE(autoware_node->get_parameter("lifecycle_manager.enabled").as_bool());
+
+  // the overrides of the options take precedence over the arguments
+  node_options_an_.parameter_overrides({{"lifecycle_manager.enabled", false}});
+  auto other_node = std::make_shared<autoware::node::Node>("node_b", "test_ns", node_options_an_);
+  EXPECT_EQ(other_node->get_lifecycle_manager(), nullptr);
+  EXPECT_FALSE(other_node->get_parameter("lifecycle_manager.enabled").as_bool());
+}
@@ -0,0 +1,177 @@
+// Copyright 2024 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <autoware/node/lifecycle_orchestrator.hpp>
+#include <autoware/node/node.hpp>
+#include <rclcpp/rclcpp.hpp>
+
+#include <lifecycle_msgs/msg/state.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using autoware::node::CallbackReturn;
+using lifecycle_msgs::msg::State;
+
+class OrderRecordingNode : public autoware::node::Node
+{
+public:
+  OrderRecordingNode(
+    const std::string & node_name, std::vector<std::string> & order, std::mutex & mutex,
+    const bool fail_configure = false)
+  : Node(node_name, "test_ns"), order_(order), mutex_(mutex), fail_configure_(fail_configure)
+  {
+  }
+
+  CallbackReturn on_configure(const rclcpp_lifecycle::State &) override
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    order_.push_back(get_name());
+    return fail_configure_ ? CallbackReturn::FAILURE : CallbackReturn::SUCCESS;
+  }
+
+private:
+  std::vector<std::string> & order_;
+  std::mutex & mutex_;
+  const bool fail_configure_;
+};
+
+class ThrowingNode : public autoware::node::Node
+{
+public:
+  explicit ThrowingNode(const std::string & node_name) : Node(node_name, "test_ns") {}
+
+  CallbackReturn on_configure(const rclcpp_lifecycle::State &) override
+  {
+    // rclcpp_lifecycle only catches std::exception
+    throw 1;
+  }
+};
+
+class AutowareNodeLifecycleOrchestrator : public ::testing::Test
+{
+public:
+  void SetUp() override { rclcpp::init(0, nullptr); }
+
+  void TearDown() override { rclcpp::shutdown(); }
+
+  std::shared_ptr<OrderRecordingNode> make_node(
+    const std::string & name, const bool fail_configure = false)
+  {
+    return std::make_shared<OrderRecordingNode>(name, order_, mutex_, fail_configure);
+  }
+
+  size_t get_position(const std::string & name) const
+  {
+    return std::find(order_.begin(), order_.end(), name) - order_.begin();
+  }
+
+  std::vector<std::string> order_;
+  std::mutex mutex_;
+};
+
+TEST_F(AutowareNodeLifecycleOrchestrator, TransitionInWaves)
+{
+  auto a = make_node("a");
+  auto b = make_node("b");
+  auto c = make_node("c");
+  auto d = make_node("d");
+  auto e = make_node("e");
+
+  autoware::node::LifecycleOrchestrator orchestrator(4);
+  orchestrator.add_node(d, {"/test_ns/b", "/test_ns/c"});
+  orchestrator.add_node(b, {"/test_ns/a"});
+  orchestrator.add_node(c, {"/test_ns/a"});
+  orchestrator.add_node(a);
+  orchestrator.add_node(e);
+
+  const auto waves = orchestrator.get_waves();
+  ASSERT_EQ(waves.size(), 3u);
+  EXPECT_EQ(waves[0].size(), 2u);
+  EXPECT_EQ(waves[1].size(), 2u);
+  EXPECT_EQ(waves[2].size(), 1u);
+
+  const auto configure_result = orchestrator.configure();
+  EXPECT_TRUE(configure_result.success);
+  EXPECT_EQ(configure_result.waves.size(), 3u);
+  EXPECT_LT(get_position("a"), get_position("b"));
+  EXPECT_LT(get_position("a"), get_position("c"));
+  EXPECT_LT(get_position("b"), get_position("d"));
+  EXPECT_LT(get_position("c"), get_position("d"));
+
+  EXPECT_TRUE(orchestrator.activate().success);
+  for (const auto & node : {a, b, c, d, e}) {
+    EXPECT_EQ(node->get_current_state().id(), State::PRIMARY_STATE_ACTIVE);
+  }
+  // already active nodes are left as they are
+  EXPECT_TRUE(orchestrator.activate().success);
+
+  EXPECT_TRUE(orchestrator.deactivate().success);
+  EXPECT_TRUE(orchestrator.shutdown().success);
+  for (const auto & node : {a, b, c, d, e}) {
+    EXPECT_EQ(node->get_current_state().id(), State::PRIMARY_STATE_FINALIZED);
+  }
+}
+
+TEST_F(AutowareNodeLifecycleOrchestrator, StopOnFailure)
+{
+  auto a = make_node("a", true);
+  auto b = make_node("b");
+
+  autoware::node::LifecycleOrchestrator orchestrator;
+  orchestrator.add_node(a);
+  orchestrator.add_node(b, {"/test_ns/a"});
+
+  const auto result = orchestrator.configure();
+  EXPECT_FALSE(result.success);
+  EXPECT_EQ(result.waves.size(), 1u);
+  EXPECT_EQ(result.failed_node_names, std::vector<std::string>{"/test_ns/a"});
+  EXPECT_EQ(b->get_current_state().id(), State::PRIMARY_STATE_UNCONFIGURED);
+}
+
+TEST_F(AutowareNodeLifecycleOrchestrator, ThrowingCallback)
+{
+  auto a = std::make_shared<ThrowingNode>("a");
+  auto b = make_node("b");
+  auto c = make_node("c");
+
+  // added last, so that the callback of a likely throws on a worker thread
+  autoware::node::LifecycleOrchestrator orchestrator(3);
+  orchestrator.add_node(b);
+  orchestrator.add_node(c);
+  orchestrator.add_node(a);
+
+  const auto result = orchestrator.configure();
+  EXPECT_FALSE(result.success);
+  EXPECT_EQ(result.waves.size(), 1u);
+  EXPECT_EQ(result.failed_node_names, std::vector<std::string>{"/test_ns/a"});
+  EXPECT_EQ(b->get_current_state().id(), State::PRIMARY_STATE_INACTIVE);
+  EXPECT_EQ(c->get_current_state().id(), State::PRIMARY_STATE_INACTIVE);
+}
+
+TEST_F(AutowareNodeLifecycleOrchestrator, InvalidGraph)
+{
+  autoware::node::LifecycleOrchestrator orchestrator;
+  orchestrator.add_node(make_node("a"), {"/test_ns/b"});
+  EXPECT_THROW(orchestrator.get_waves(), std::invalid_argument);
+  orchestrator.add_node(make_node("b"), {"/test_ns/a"});
+  EXPECT_THROW(orchestrator.get_waves(), std::invalid_argument);
+  EXPECT_THROW(orchestrator.add_node(make_node("b")), std::invalid_argument);
+}
@@ -0,0 +1,132 @@
+// Copyright 2024 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <autoware/node/node.hpp>
+#include <rclcpp/rclcpp.hpp>
+
+#include <autoware_node_msgs/msg/lifecycle_timing_report.hpp>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using autoware_node_msgs::msg::LifecycleTimingReport;
+
+class AutowareNodeLifecycleTiming : public ::testing::Test
+{
+public:
+  void SetUp() override { rclcpp::init(0, nullptr); }
+
+  void TearDown() override { rclcpp::shutdown(); }
+
+  rclcpp::NodeOptions node_options_an_;
+};
+
+std::vector<std::string> get_labels(const LifecycleTimingReport & report)
+{
+  std::vector<std::string> labels;
+  for (const auto & timing : report.transitions) {
+    labels.push_back(timing.label);
+  }
+  return labels;
+}
+
+TEST_F(AutowareNodeLifecycleTiming, RecordTransitions)
+{
+  auto autoware_node =
+    std::make_shared<autoware::node::Node>("test_node", "test_ns", node_options_an_);
+  // the construction of AN ends with its constructor
+  const std::vector<std::string> construct_label{"construct"};
+  EXPECT_EQ(get_labels(autoware_node->get_lifecycle_timing_report()), construct_label);
+  // the report is not published by default
+  EXPECT_EQ(autoware_node->count_publishers("/test_ns/test_node/lifecycle_timing"), 0u);
+
+  autoware_node->configure();
+  autoware_node->activate();
+  autoware_node->deactivate();
+  autoware_node->cleanup();
+  autoware_node->shutdown();
+
+  const auto report = autoware_node->get_lifecycle_timing_report();
+  EXPECT_EQ(report.node_name, "/test_ns/test_node");
+  // without mark_constructed(), the derived construction lasts until the first transition
+  const std::vector<std::string> expected_labels{
+    "construct",  "construct_derived_upper_bound", "configure", "activate",
+    "deactivate", "cleanup",                       "shutdown"};
+  EXPECT_EQ(get_labels(report), expected_labels);
+  for (const auto & timing : report.transitions) {
+    EXPECT_TRUE(timing.success) << timing.label;
+  }
+  // the process started before the node was constructed
+  const auto & construct = report.transitions.front();
+  EXPECT_LE(
+    rclcpp::Time(report.process_start_time).nanoseconds(),
+    rclcpp::Time(construct.start_time).nanoseconds());
+}
+
+class DerivedNode : public autoware::node::Node
+{
+public:
+  explicit DerivedNode(const rclcpp::NodeOptions & options) : Node("derived_node", "", options)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    mark_constructed();
+  }
+};
+
+TEST_F(AutowareNodeLifecycleTiming, RecordDerivedConstruction)
+{
+  auto derived_node = std::make_shared<DerivedNode>(node_options_an_);
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  derived_node->configure();
+
+  // the derived construction ends with mark_constructed(), not with the first transition
+  const auto report = derived_node->get_lifecycle_timing_report();
+  const std::vector<std::string> expected_labels{"construct", "construct_derived", "configure"};
+  ASSERT_EQ(get_labels(report), expected_labels);
+  const auto duration = rclcpp::Duration(report.transitions[1].duration);
+  EXPECT_GE(duration, rclcpp::Duration(std::chrono::milliseconds(20)));
+  EXPECT_LT(duration, rclcpp::Duration(std::chrono::milliseconds(100)));
+}
+
+TEST_F(AutowareNodeLifecycleTiming, PublishLatchedReport)
+{
+  node_options_an_.parameter_overrides({{"lifecycle_timing.publish", true}});
+  auto autoware_node =
+    std::make_shared<autoware::node::Node>("test_node", "test_ns", node_options_an_);
+  autoware_node->configure();
+
+  // subscribing after the transition still receives the report
+  auto listener = std::make_shared<rclcpp::Node>("listener");
+  LifecycleTimingReport::ConstSharedPtr received;
+  auto subscription = listener->create_subscription<LifecycleTimingReport>(
+    "/test_ns/test_node/lifecycle_timing", rclcpp::QoS(1).reliable().transient_local(),
+    [&received](const LifecycleTimingReport::ConstSharedPtr report) { received = report; });
+
+  rclcpp::executors::SingleThreadedExecutor executor;
+  executor.add_node(listener);
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while (!received && std::chrono::steady_clock::now() < deadline) {
+    executor.spin_some(std::chrono::milliseconds(10));
+  }
+
+  ASSERT_NE(received, nullptr);
+  const std::vector<std::string> expected_labels{
+    "construct", "construct_derived_upper_bound", "configure"};
+  EXPECT_EQ(get_labels(*received), expected_labels);
+}
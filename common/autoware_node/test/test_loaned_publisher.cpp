@@ -0,0 +1,107 @@
+// Copyright 2024 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <autoware/node/node.hpp>
+#include <rclcpp/rclcpp.hpp>
+
+#include <std_msgs/msg/u_int8_multi_array.hpp>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <memory>
+
+using std_msgs::msg::UInt8MultiArray;
+
+class AutowareNodeLoanedPublisher : public ::testing::Test
+{
+public:
+  void SetUp() override { rclcpp::init(0, nullptr); }
+
+  void TearDown() override { rclcpp::shutdown(); }
+
+  rclcpp::NodeOptions node_options_an_;
+};
+
+TEST_F(AutowareNodeLoanedPublisher, PublishWithFallback)
+{
+  auto autoware_node =
+    std::make_shared<autoware::node::Node>("test_node", "test_ns", node_options_an_);
+  auto publisher =
+    autoware_node->create_loaned_publisher<UInt8MultiArray>("test_topic", rclcpp::QoS(1));
+
+  int fill_count = 0;
+  const auto fill = [&fill_count](UInt8MultiArray & message) {
+    message.data.assign(1024, 0);
+    ++fill_count;
+  };
+
+  // the message is not even filled while the node is inactive
+  EXPECT_FALSE(publisher->publish(fill));
+  EXPECT_EQ(fill_count, 0);
+
+  autoware_node->configure();
+  autoware_node->activate();
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_TRUE(publisher->publish(fill));
+  }
+  EXPECT_EQ(fill_count, 3);
+
+  // messages of variable size cannot be loaned, so they fall back to the pool
+  const auto statistics = publisher->get_statistics();
+  EXPECT_EQ(statistics.loaned_count + statistics.pooled_count, 3u);
+  if (!publisher->can_loan_messages()) {
+    EXPECT_EQ(statistics.pooled_count, 3u);
+  }
+}
+
+TEST_F(AutowareNodeLoanedPublisher, PooledMessageIsMovedToIntraProcessSubscription)
+{
+  auto autoware_node =
+    std::make_shared<autoware::node::Node>("test_node", "test_ns", node_options_an_);
+  rclcpp::PublisherOptions publisher_options;
+  publisher_options.use_intra_process_comm = rclcpp::IntraProcessSetting::Enable;
+  auto publisher = autoware_node->create_loaned_publisher<UInt8MultiArray>(
+    "test_topic", rclcpp::QoS(1), publisher_options);
+  rclcpp::SubscriptionOptions subscription_options;
+  subscription_options.use_intra_process_comm = rclcpp::IntraProcessSetting::Enable;
+  const UInt8MultiArray * received = nullptr;
+  auto subscription = autoware_node->create_subscription<UInt8MultiArray>(
+    "test_topic", rclcpp::QoS(1),
+    [&received](std::unique_ptr<UInt8MultiArray> message) { received = message.release(); },
+    subscription_options);
+  if (publisher->can_loan_messages()) {
+    GTEST_SKIP() << "the middleware loans the messages";
+  }
+
+  autoware_node->configure();
+  autoware_node->activate();
+  const UInt8MultiArray * filled = nullptr;
+  EXPECT_TRUE(publisher->publish([&filled](UInt8MultiArray & message) {
+    message.data.assign(1024, 1);
+    filled = &message;
+  }));
+  rclcpp::executors::SingleThreadedExecutor executor;
+  executor.add_node(autoware_node->get_node_base_interface());
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(3);
+  while (!received && std::chrono::steady_clock::now() < deadline) {
+    executor.spin_some(std::chrono::milliseconds(10));
+  }
+
+  // the pooled message itself is received, rclcpp did not copy it
+  ASSERT_NE(received, nullptr);
+  EXPECT_EQ(received, filled);
+  EXPECT_EQ(received->data.size(), 1024u);
+  delete received;
+}
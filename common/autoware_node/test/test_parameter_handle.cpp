@@ -0,0 +1,127 @@
+// Copyright 2024 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <autoware/node/node.hpp>
+#include <autoware/node/parameter_handle.hpp>
+#include <rclcpp/rclcpp.hpp>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+class AutowareNodeParameterHandle : public ::testing::Test
+{
+public:
+  void SetUp() override { rclcpp::init(0, nullptr); }
+
+  void TearDown() override { rclcpp::shutdown(); }
+
+  rclcpp::NodeOptions node_options_an_;
+};
+
+TEST_F(AutowareNodeParameterHandle, FollowsAcceptedValues)
+{
+  node_options_an_.parameter_overrides({{"gain", 2.0}});
+  auto autoware_node =
+    std::make_shared<autoware::node::Node>("test_node", "test_ns", node_options_an_);
+  const auto gain = autoware_node->declare_parameter_handle<double>(
+    "gain", 1.0, [](const double value) { return value > 0.0 ? "" : "must be positive"; });
+  const auto frame_id = autoware_node->declare_parameter_handle<std::string>("frame_id", "map");
+  const auto count = autoware_node->declare_parameter_handle<int>("count", 3);
+  EXPECT_DOUBLE_EQ(gain->get(), 2.0);
+  EXPECT_EQ(frame_id->get(), "map");
+  EXPECT_EQ(count->get(), 3);
+
+  EXPECT_TRUE(autoware_node->set_parameter(rclcpp::Parameter("gain", 0.5)).successful);
+  EXPECT_DOUBLE_EQ(gain->get(), 0.5);
+  EXPECT_EQ(gain->get_version(), 1u);
+
+  // a rejected value is applied to none of the parameters
+  const auto results = autoware_node->set_parameters_atomically(
+    {rclcpp::Parameter("frame_id", "base_link"), rclcpp::Parameter("gain", -1.0)});
+  EXPECT_FALSE(results.successful);
+  EXPECT_EQ(results.reason, "gain: must be positive");
+  EXPECT_DOUBLE_EQ(gain->get(), 0.5);
+  EXPECT_EQ(frame_id->get(), "map");
+  EXPECT_DOUBLE_EQ(autoware_node->get_parameter("gain").as_double(), 0.5);
+
+  EXPECT_TRUE(
+    autoware_node->set_parameter(rclcpp::Parameter("frame_id", "base_link")).successful);
+  EXPECT_EQ(frame_id->read([](const std::string & value) { return value.size(); }), 9u);
+  EXPECT_TRUE(autoware_node->set_parameter(rclcpp::Parameter("count", 5)).successful);
+  EXPECT_EQ(count->get(), 5);
+}
+
+TEST_F(AutowareNodeParameterHandle, RejectsInvalidInitialValues)
+{
+  node_options_an_.parameter_overrides({{"gain", -2.0}});
+  auto autoware_node =
+    std::make_shared<autoware::node::Node>("test_node", "test_ns", node_options_an_);
+  EXPECT_THROW(
+    autoware_node->declare_parameter_handle<double>(
+      "gain", 1.0, [](const double value) { return value > 0.0 ? "" : "must be positive"; }),
+    rclcpp::exceptions::InvalidParameterValueException);
+}
+
+TEST_F(AutowareNodeParameterHandle, RejectsValuesOfAnotherType)
+{
+  auto autoware_node =
+    std::make_shared<autoware::node::Node>("test_node", "test_ns", node_options_an_);
+  rcl_interfaces::msg::ParameterDescriptor descriptor;
+  descriptor.dynamic_typing = true;
+  const auto gain =
+    autoware_node->declare_parameter_handle<double>("gain", 1.0, nullptr, descriptor);
+
+  // rclcpp accepts the string, but the handle cannot hold it
+  const auto result = autoware_node->set_parameter(rclcpp::Parameter("gain", "fast"));
+  EXPECT_FALSE(result.successful);
+  EXPECT_EQ(result.reason.rfind("gain: ", 0), 0u) << result.reason;
+  EXPECT_DOUBLE_EQ(gain->get(), 1.0);
+  EXPECT_EQ(gain->get_version(), 0u);
+  EXPECT_DOUBLE_EQ(autoware_node->get_parameter("gain").as_double(), 1.0);
+}
+
+TEST(ParameterSnapshot, ReadsConsistentValuesDuringUpdates)
+{
+  autoware::node::ParameterSnapshot<std::vector<int>> snapshot(std::vector<int>(16, 0));
+  std::atomic<bool> running{true};
+  std::atomic<bool> consistent{true};
+  std::vector<std::thread> readers;
+  for (int i = 0; i < 4; ++i) {
+    readers.emplace_back([&]() {
+      while (running) {
+        snapshot.read([&](const std::vector<int> & values) {
+          for (const int value : values) {
+            if (value != values.front()) {
+              consistent = false;
+            }
+          }
+        });
+      }
+    });
+  }
+  for (int i = 1; i <= 1000; ++i) {
+    snapshot.store(std::vector<int>(16, i));
+  }
+  running = false;
+  for (auto & reader : readers) {
+    reader.join();
+  }
+  EXPECT_TRUE(consistent);
+  EXPECT_EQ(snapshot.read([](const std::vector<int> & values) { return values.back(); }), 1000);
+}
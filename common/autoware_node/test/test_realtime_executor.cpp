@@ -0,0 +1,164 @@
+// Copyright 2024 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <autoware/node/node.hpp>
+#include <autoware/node/realtime_executor.hpp>
+#include <rclcpp/rclcpp.hpp>
+
+#include <gtest/gtest.h>
+#include <sched.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+// a CPU the process may run on, as CPU 0 may be excluded by a cpuset
+int get_allowed_cpu()
+{
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  if (sched_getaffinity(0, sizeof(cpu_set), &cpu_set) == 0) {
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+      if (CPU_ISSET(cpu, &cpu_set)) {
+        return cpu;
+      }
+    }
+  }
+  return 0;
+}
+
+class AutowareNodeRealtimeExecutor : public ::testing::Test
+{
+public:
+  void SetUp() override { rclcpp::init(0, nullptr); }
+
+  void TearDown() override { rclcpp::shutdown(); }
+
+  rclcpp::NodeOptions node_options_an_;
+};
+
+TEST_F(AutowareNodeRealtimeExecutor, DedicatedThread)
+{
+  const int cpu = get_allowed_cpu();
+  node_options_an_.parameter_overrides(
+    {{"realtime.control.priority", 0},
+     {"realtime.control.cpu_affinity", std::vector<int64_t>{cpu}}});
+  auto autoware_node =
+    std::make_shared<autoware::node::Node>("test_node", "test_ns", node_options_an_);
+  auto control_group = autoware_node->create_realtime_callback_group("control");
+
+  ASSERT_EQ(autoware_node->get_realtime_callback_groups().size(), 1u);
+  const auto & profile = autoware_node->get_realtime_callback_groups().front().profile;
+  EXPECT_EQ(profile.name, "control");
+  EXPECT_EQ(profile.priority, 0);
+  EXPECT_EQ(profile.cpu_affinity, std::vector<int>{cpu});
+
+  std::atomic<bool> control_called{false};
+  std::atomic<bool> default_called{false};
+  std::thread::id control_thread_id;
+  std::thread::id default_thread_id;
+  int control_cpu = -1;
+  auto control_timer = autoware_node->create_wall_timer(
+    1ms,
+    [&]() {
+      if (!control_called) {
+        control_thread_id = std::this_thread::get_id();
+        control_cpu = sched_getcpu();
+        control_called = true;
+      }
+    },
+    control_group);
+  auto default_timer = autoware_node->create_wall_timer(1ms, [&]() {
+    if (!default_called) {
+      default_thread_id = std::this_thread::get_id();
+      default_called = true;
+    }
+  });
+
+  autoware::node::RealtimeExecutor executor;
+  executor.add_node(autoware_node);
+  std::thread thread_spin([&executor]() { executor.spin(); });
+
+  const auto deadline = std::chrono::steady_clock::now() + 5s;
+  while ((!control_called || !default_called) && std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(1ms);
+  }
+  while (!executor.is_spinning()) {
+    std::this_thread::sleep_for(1ms);
+  }
+  executor.cancel();
+  thread_spin.join();
+
+  ASSERT_TRUE(control_called);
+  ASSERT_TRUE(default_called);
+  EXPECT_NE(control_thread_id, default_thread_id);
+  EXPECT_EQ(control_cpu, cpu);
+}
+
+TEST_F(AutowareNodeRealtimeExecutor, FallbackWithoutPrivileges)
+{
+  // SCHED_FIFO is applied only with privileges, but the callbacks run either way
+  node_options_an_.parameter_overrides({{"realtime.control.priority", 80}});
+  auto autoware_node =
+    std::make_shared<autoware::node::Node>("test_node", "test_ns", node_options_an_);
+  auto control_group = autoware_node->create_realtime_callback_group("control");
+
+  std::atomic<int> count{0};
+  auto timer = autoware_node->create_wall_timer(1ms, [&count]() { ++count; }, control_group);
+
+  autoware::node::RealtimeExecutor executor;
+  executor.add_node(autoware_node);
+  std::thread thread_spin([&executor]() { executor.spin(); });
+
+  const auto deadline = std::chrono::steady_clock::now() + 5s;
+  while (count < 5 && std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(1ms);
+  }
+  while (!executor.is_spinning()) {
+    std::this_thread::sleep_for(1ms);
+  }
+  executor.cancel();
+  thread_spin.join();
+
+  EXPECT_GE(count, 5);
+}
+
+TEST_F(AutowareNodeRealtimeExecutor, CancelBeforeSpinAndRestoreTheProfile)
+{
+  auto autoware_node =
+    std::make_shared<autoware::node::Node>("test_node", "test_ns", node_options_an_);
+
+  autoware::node::ThreadProfile default_profile;
+  default_profile.cpu_affinity = {get_allowed_cpu()};
+  autoware::node::RealtimeExecutor executor(rclcpp::ExecutorOptions(), default_profile);
+  executor.add_node(autoware_node);
+
+  cpu_set_t cpu_set_before;
+  CPU_ZERO(&cpu_set_before);
+  ASSERT_EQ(sched_getaffinity(0, sizeof(cpu_set_before), &cpu_set_before), 0);
+
+  // returns instead of spinning forever, and leaves the calling thread as it was
+  executor.cancel();
+  executor.spin();
+
+  cpu_set_t cpu_set_after;
+  CPU_ZERO(&cpu_set_after);
+  ASSERT_EQ(sched_getaffinity(0, sizeof(cpu_set_after), &cpu_set_after), 0);
+  EXPECT_TRUE(CPU_EQUAL(&cpu_set_before, &cpu_set_after));
+  EXPECT_FALSE(executor.is_spinning());
+}
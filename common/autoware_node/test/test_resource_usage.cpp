@@ -0,0 +1,147 @@
+// Copyright 2024 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <autoware/node/malloc_hook.hpp>
+#include <autoware/node/node.hpp>
+#include <autoware/node/resource_usage.hpp>
+#include <rclcpp/rclcpp.hpp>
+
+#include <diagnostic_msgs/msg/diagnostic_array.hpp>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <memory>
+#include <vector>
+
+AUTOWARE_NODE_DEFINE_MALLOC_HOOK()
+
+using namespace std::chrono_literals;
+
+class AutowareNodeResourceUsage : public ::testing::Test
+{
+public:
+  void SetUp() override { rclcpp::init(0, nullptr); }
+
+  void TearDown() override { rclcpp::shutdown(); }
+
+  rclcpp::NodeOptions node_options_an_;
+};
+
+void busy_wait(const std::chrono::nanoseconds duration)
+{
+  const auto start = autoware::node::ResourceAccount::get_thread_cpu_time();
+  while (autoware::node::ResourceAccount::get_thread_cpu_time() - start <
+         static_cast<uint64_t>(duration.count())) {
+  }
+}
+
+TEST_F(AutowareNodeResourceUsage, Scope)
+{
+  autoware::node::ResourceAccount account;
+  autoware::node::ResourceAccount other_account;
+  {
+    const autoware::node::ResourceAccount::Scope scope(account);
+    busy_wait(10ms);
+    std::vector<char> buffer(1 << 20);
+    {
+      // nested scopes of another account take over, the same account is not counted twice
+      const autoware::node::ResourceAccount::Scope same_scope(account);
+      const autoware::node::ResourceAccount::Scope other_scope(other_account);
+      std::vector<char> other_buffer(1 << 10);
+    }
+  }
+  std::vector<char> unattributed_buffer(1 << 20);
+
+  const auto usage = account.get_usage();
+  EXPECT_GE(usage.cpu_time, 10000000u);
+  EXPECT_GE(usage.allocated_bytes, 1u << 20);
+  EXPECT_LT(usage.allocated_bytes, 2u << 20);
+  EXPECT_EQ(usage.callback_count, 1u);
+  EXPECT_GE(other_account.get_usage().allocated_bytes, 1u << 10);
+  EXPECT_LT(other_account.get_usage().allocated_bytes, 1u << 20);
+}
+
+TEST_F(AutowareNodeResourceUsage, NestedScopePausesTheOuterAccount)
+{
+  autoware::node::ResourceAccount account;
+  autoware::node::ResourceAccount other_account;
+  {
+    const autoware::node::ResourceAccount::Scope scope(account);
+    busy_wait(10ms);
+    {
+      const autoware::node::ResourceAccount::Scope other_scope(other_account);
+      busy_wait(50ms);
+    }
+    busy_wait(10ms);
+  }
+  EXPECT_GE(account.get_usage().cpu_time, 20000000u);
+  EXPECT_LT(account.get_usage().cpu_time, 50000000u);
+  EXPECT_GE(other_account.get_usage().cpu_time, 50000000u);
+}
+
+TEST_F(AutowareNodeResourceUsage, LiveBytes)
+{
+  autoware::node::ResourceAccount account;
+  std::unique_ptr<std::vector<char>> kept;
+  {
+    const autoware::node::ResourceAccount::Scope scope(account);
+    std::vector<char> released(1 << 20);
+    kept = std::make_unique<std::vector<char>>(1 << 16);
+  }
+  const auto usage = account.get_usage();
+  EXPECT_GE(usage.freed_bytes, 1u << 20);
+  EXPECT_GE(usage.free_count, 1u);
+  // only the kept buffer is still held
+  EXPECT_GE(usage.get_live_bytes(), 1 << 16);
+  EXPECT_LT(usage.get_live_bytes(), 1 << 20);
+}
+
+TEST_F(AutowareNodeResourceUsage, MonitoredCallbacksAndDiagnostics)
+{
+  node_options_an_.parameter_overrides({{"resource_usage.diagnostics_period", 0.05}});
+  auto autoware_node =
+    std::make_shared<autoware::node::Node>("test_node", "test_ns", node_options_an_);
+  auto timer = autoware_node->create_monitored_timer("busy", 10ms, []() {
+    busy_wait(1ms);
+    std::vector<char> buffer(1000);
+  });
+
+  auto listener = std::make_shared<rclcpp::Node>("listener");
+  diagnostic_msgs::msg::DiagnosticStatus received;
+  auto subscription = listener->create_subscription<diagnostic_msgs::msg::DiagnosticArray>(
+    "/diagnostics", rclcpp::QoS(10),
+    [&received](const diagnostic_msgs::msg::DiagnosticArray::ConstSharedPtr diagnostics) {
+      for (const auto & status : diagnostics->status) {
+        if (status.hardware_id == "/test_ns/test_node") {
+          received = status;
+        }
+      }
+    });
+
+  rclcpp::executors::SingleThreadedExecutor executor;
+  executor.add_node(autoware_node->get_node_base_interface());
+  executor.add_node(listener);
+  const auto deadline = std::chrono::steady_clock::now() + 5s;
+  while ((autoware_node->get_resource_usage().callback_count < 10 || received.values.empty()) &&
+         std::chrono::steady_clock::now() < deadline) {
+    executor.spin_some(10ms);
+  }
+
+  const auto usage = autoware_node->get_resource_usage();
+  EXPECT_GE(usage.callback_count, 10u);
+  EXPECT_GE(usage.cpu_time, usage.callback_count * 1000000u);
+  EXPECT_GE(usage.allocated_bytes, usage.callback_count * 1000u);
+  EXPECT_FALSE(received.values.empty());
+}
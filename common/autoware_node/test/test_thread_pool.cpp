@@ -0,0 +1,212 @@
+// Copyright 2024 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <autoware/node/node.hpp>
+#include <autoware/node/thread_pool.hpp>
+#include <rclcpp/rclcpp.hpp>
+
+#include <std_msgs/msg/int32.hpp>
+
+#include <gtest/gtest.h>
+#include <pthread.h>
+#include <sched.h>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+using std_msgs::msg::Int32;
+
+class AutowareNodeThreadPool : public ::testing::Test
+{
+public:
+  void SetUp() override { rclcpp::init(0, nullptr); }
+
+  void TearDown() override { rclcpp::shutdown(); }
+
+  rclcpp::NodeOptions node_options_an_;
+};
+
+TEST(ThreadPool, RunsSubmittedAndNestedTasks)
+{
+  EXPECT_GE(autoware::node::ThreadPool::get_default_size(), 1u);
+
+  std::atomic<int> nested_count{0};
+  {
+    autoware::node::ThreadPool pool(4);
+    EXPECT_EQ(pool.size(), 4u);
+
+    std::vector<std::future<int>> futures;
+    for (int i = 0; i < 100; ++i) {
+      futures.push_back(pool.submit([i, &pool, &nested_count]() {
+        pool.post([&nested_count]() { ++nested_count; });
+        return i;
+      }));
+    }
+    int sum = 0;
+    for (auto & future : futures) {
+      sum += future.get();
+    }
+    EXPECT_EQ(sum, 4950);
+
+    // move-only results
+    auto future = pool.submit([value = std::make_unique<int>(3)]() { return *value; });
+    EXPECT_EQ(future.get(), 3);
+
+    auto thrown = pool.submit([]() -> int { throw std::runtime_error("failure"); });
+    EXPECT_THROW(thrown.get(), std::runtime_error);
+  }
+  // the destructor runs the queued tasks
+  EXPECT_EQ(nested_count.load(), 100);
+}
+
+TEST(ThreadPool, ParallelFor)
+{
+  autoware::node::ThreadPool pool(4);
+  std::vector<int> values(10000, 0);
+  pool.parallel_for(0, values.size(), [&values](const size_t index) { values[index] += 1; });
+  EXPECT_EQ(std::accumulate(values.begin(), values.end(), 0), 10000);
+
+  // nested loops do not wait for each other
+  std::atomic<int> count{0};
+  pool.parallel_for(0, 8, [&](const size_t) {
+    pool.parallel_for(0, 100, [&count](const size_t) { ++count; });
+  });
+  EXPECT_EQ(count.load(), 800);
+
+  EXPECT_THROW(
+    pool.parallel_for(
+      0, 100,
+      [](const size_t index) {
+        if (index == 42) {
+          throw std::runtime_error("failure");
+        }
+      }),
+    std::runtime_error);
+}
+
+TEST(ThreadPool, WorkersDoNotInheritThePinningOfTheCreator)
+{
+  cpu_set_t process_cpu_set;
+  ASSERT_EQ(sched_getaffinity(0, sizeof(process_cpu_set), &process_cpu_set), 0);
+  int first_cpu = 0;
+  while (!CPU_ISSET(first_cpu, &process_cpu_set)) {
+    ++first_cpu;
+  }
+
+  int worker_cpu_count = 0;
+  int worker_policy = -1;
+  std::thread creator([&]() {
+    cpu_set_t pinned;
+    CPU_ZERO(&pinned);
+    CPU_SET(first_cpu, &pinned);
+    ASSERT_EQ(pthread_setaffinity_np(pthread_self(), sizeof(pinned), &pinned), 0);
+    autoware::node::ThreadPool pool(2);
+    pool
+      .submit([&]() {
+        cpu_set_t cpu_set;
+        sched_getaffinity(0, sizeof(cpu_set), &cpu_set);
+        worker_cpu_count = CPU_COUNT(&cpu_set);
+        worker_policy = sched_getscheduler(0);
+      })
+      .get();
+  });
+  creator.join();
+  EXPECT_EQ(worker_cpu_count, CPU_COUNT(&process_cpu_set));
+  EXPECT_EQ(worker_policy, SCHED_OTHER);
+}
+
+TEST_F(AutowareNodeThreadPool, AccountsTasksToTheNode)
+{
+  auto autoware_node =
+    std::make_shared<autoware::node::Node>("test_node", "test_ns", node_options_an_);
+  EXPECT_EQ(&autoware_node->get_thread_pool(), &autoware::node::ThreadPool::get_instance());
+
+  auto future = autoware_node->submit_task([]() { return 42; });
+  EXPECT_EQ(future.get(), 42);
+
+  std::vector<int> values(1000, 0);
+  autoware_node->parallel_for(
+    0, values.size(), [&values](const size_t index) { values[index] = 1; }, 100);
+  EXPECT_EQ(std::accumulate(values.begin(), values.end(), 0), 1000);
+
+  const auto & statistics = autoware_node->get_task_statistics();
+  EXPECT_EQ(statistics.submitted_count.load(), 11u);
+  EXPECT_EQ(statistics.completed_count.load(), 11u);
+  EXPECT_EQ(statistics.queueing_delay.snapshot().count, 11u);
+}
+
+TEST_F(AutowareNodeThreadPool, RunsCompletionsOnTheExecutor)
+{
+  auto autoware_node =
+    std::make_shared<autoware::node::Node>("test_node", "test_ns", node_options_an_);
+  autoware_node->configure();
+  autoware_node->activate();
+  auto publisher = autoware_node->create_publisher<Int32>("test_topic", rclcpp::QoS(10));
+
+  rclcpp::executors::SingleThreadedExecutor executor;
+  executor.add_node(autoware_node->get_node_base_interface());
+  const auto executor_thread_id = std::this_thread::get_id();
+
+  std::thread::id completion_thread_id;
+  int result = 0;
+  bool void_completed = false;
+  autoware_node->submit_task(
+    []() { return 21 * 2; },
+    [&](const int value) {
+      completion_thread_id = std::this_thread::get_id();
+      result = value;
+      Int32 message;
+      message.data = value;
+      publisher->publish(message);
+    });
+  autoware_node->submit_task([]() {}, [&]() { void_completed = true; });
+
+  const auto deadline = std::chrono::steady_clock::now() + 3s;
+  while ((result == 0 || !void_completed) && std::chrono::steady_clock::now() < deadline) {
+    executor.spin_some(10ms);
+  }
+  EXPECT_EQ(result, 42);
+  EXPECT_TRUE(void_completed);
+  EXPECT_EQ(completion_thread_id, executor_thread_id);
+}
+
+TEST_F(AutowareNodeThreadPool, DropsCompletionsOfDestroyedNodes)
+{
+  auto autoware_node =
+    std::make_shared<autoware::node::Node>("test_node", "test_ns", node_options_an_);
+  std::promise<void> release;
+  std::promise<void> done;
+  auto released = release.get_future().share();
+  bool completed = false;
+  autoware_node->submit_task(
+    [released, &done]() {
+      released.wait();
+      done.set_value();
+    },
+    [&completed]() { completed = true; });
+  autoware_node.reset();
+  release.set_value();
+  done.get_future().wait();
+
+  // the work finishes after the node, and its completion is not queued anywhere
+  std::this_thread::sleep_for(100ms);
+  EXPECT_FALSE(completed);
+}
@@ -0,0 +1,101 @@
+// Copyright 2024 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <autoware/node/node.hpp>
+#include <autoware/node/timer_coalescer.hpp>
+#include <rclcpp/rclcpp.hpp>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+class AutowareNodeTimerCoalescer : public ::testing::Test
+{
+public:
+  void SetUp() override { rclcpp::init(0, nullptr); }
+
+  void TearDown() override { rclcpp::shutdown(); }
+
+  rclcpp::NodeOptions node_options_an_;
+};
+
+TEST(CoalescedTimer, SkipsExpirationsWhileCallbackIsPending)
+{
+  std::mutex mutex;
+  std::vector<autoware::node::Task> posted;
+  int count = 0;
+  auto timer = std::make_shared<autoware::node::CoalescedTimer>(
+    10ms, 1ms, [&count]() { ++count; }, [&](autoware::node::Task task) {
+      std::lock_guard<std::mutex> lock(mutex);
+      posted.push_back(std::move(task));
+    });
+  autoware::node::TimerCoalescer coalescer;
+  coalescer.add(timer);
+  EXPECT_EQ(coalescer.get_timer_count(), 1u);
+
+  std::this_thread::sleep_for(55ms);
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    ASSERT_EQ(posted.size(), 1u);
+    EXPECT_GE(timer->get_skipped_count(), 3u);
+    posted.front()();
+    EXPECT_EQ(count, 1);
+  }
+
+  timer.reset();
+  EXPECT_EQ(coalescer.get_timer_count(), 0u);
+}
+
+TEST_F(AutowareNodeTimerCoalescer, SharesWakeupsBetweenNodes)
+{
+  std::vector<std::shared_ptr<autoware::node::Node>> nodes;
+  std::vector<autoware::node::CoalescedTimer::SharedPtr> timers;
+  rclcpp::executors::SingleThreadedExecutor executor;
+  int count = 0;
+  const auto before = autoware::node::TimerCoalescer::get_instance().get_statistics();
+  for (int i = 0; i < 10; ++i) {
+    nodes.push_back(std::make_shared<autoware::node::Node>(
+      "test_node_" + std::to_string(i), "test_ns", node_options_an_));
+    executor.add_node(nodes.back()->get_node_base_interface());
+    for (const auto period : {50ms, 100ms}) {
+      timers.push_back(nodes.back()->create_coalesced_timer(period, [&count]() { ++count; }));
+    }
+  }
+  EXPECT_DOUBLE_EQ(nodes.front()->get_parameter("coalesced_timer.tolerance").as_double(), 0.01);
+  EXPECT_EQ(timers.front()->get_tolerance(), 10ms);
+
+  const auto deadline = std::chrono::steady_clock::now() + 500ms;
+  while (std::chrono::steady_clock::now() < deadline) {
+    executor.spin_some(10ms);
+  }
+  const auto after = autoware::node::TimerCoalescer::get_instance().get_statistics();
+  const auto wakeup_count = after.wakeup_count - before.wakeup_count;
+  const auto expiration_count = after.expiration_count - before.expiration_count;
+  EXPECT_GE(count, 100);
+  EXPECT_GE(expiration_count, static_cast<uint64_t>(count));
+  // one wakeup per 50 ms for the 20 timers
+  EXPECT_LE(wakeup_count, 12u);
+
+  timers.clear();
+  const int stopped_count = count;
+  executor.spin_some(100ms);
+  EXPECT_EQ(count, stopped_count);
+}
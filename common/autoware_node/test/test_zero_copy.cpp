@@ -0,0 +1,114 @@
+// Copyright 2024 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <autoware/node/node.hpp>
+#include <rclcpp/rclcpp.hpp>
+
+#include <lifecycle_msgs/msg/state.hpp>
+#include <std_msgs/msg/u_int8_multi_array.hpp>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <memory>
+#include <utility>
+
+using std_msgs::msg::UInt8MultiArray;
+
+class AutowareNodeZeroCopy : public ::testing::Test
+{
+public:
+  void SetUp() override { rclcpp::init(0, nullptr); }
+
+  void TearDown() override { rclcpp::shutdown(); }
+
+  rclcpp::NodeOptions node_options_an_;
+};
+
+TEST_F(AutowareNodeZeroCopy, PublishUniquePtr)
+{
+  auto autoware_node =
+    std::make_shared<autoware::node::Node>("test_node", "test_ns", node_options_an_);
+
+  const UInt8MultiArray * received_message = nullptr;
+  auto subscription = autoware_node->create_zero_copy_subscription<UInt8MultiArray>(
+    "test_topic", rclcpp::QoS(1), [&received_message](std::unique_ptr<UInt8MultiArray> message) {
+      received_message = message.release();
+    });
+  auto publisher =
+    autoware_node->create_zero_copy_publisher<UInt8MultiArray>("test_topic", rclcpp::QoS(1));
+
+  // the publisher follows the lifecycle of the node
+  EXPECT_FALSE(publisher->is_activated());
+  autoware_node->configure();
+  autoware_node->activate();
+  ASSERT_EQ(
+    autoware_node->get_current_state().id(), lifecycle_msgs::msg::State::PRIMARY_STATE_ACTIVE);
+  EXPECT_TRUE(publisher->is_activated());
+
+  auto message = publisher->make_message();
+  message->data.resize(1024 * 1024);
+  const UInt8MultiArray * published_message = message.get();
+  publisher->publish(std::move(message));
+
+  rclcpp::executors::SingleThreadedExecutor executor;
+  executor.add_node(autoware_node->get_node_base_interface());
+  const auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while (received_message == nullptr && std::chrono::steady_clock::now() < timeout) {
+    executor.spin_once(std::chrono::milliseconds(10));
+  }
+
+  // the subscription receives the published message itself
+  ASSERT_NE(received_message, nullptr);
+  EXPECT_EQ(received_message, published_message);
+  delete received_message;
+}
+
+TEST_F(AutowareNodeZeroCopy, FallbackOnTransientLocal)
+{
+  auto autoware_node =
+    std::make_shared<autoware::node::Node>("test_node", "test_ns", node_options_an_);
+
+  // rclcpp throws for an intra-process publisher or subscription with transient local durability
+  const auto qos = rclcpp::QoS(1).transient_local();
+  autoware::node::ZeroCopyPublisher<UInt8MultiArray>::SharedPtr publisher;
+  ASSERT_NO_THROW(
+    publisher = autoware_node->create_zero_copy_publisher<UInt8MultiArray>("test_topic", qos));
+
+  autoware_node->configure();
+  autoware_node->activate();
+  auto message = publisher->make_message();
+  message->data.resize(16);
+  publisher->publish(std::move(message));
+
+  // a late joining subscription still receives the message, which only the middleware keeps
+  const UInt8MultiArray * received_message = nullptr;
+  rclcpp::Subscription<UInt8MultiArray>::SharedPtr subscription;
+  ASSERT_NO_THROW(
+    subscription = autoware_node->create_zero_copy_subscription<UInt8MultiArray>(
+      "test_topic", qos, [&received_message](std::unique_ptr<UInt8MultiArray> message) {
+        received_message = message.release();
+      }));
+
+  rclcpp::executors::SingleThreadedExecutor executor;
+  executor.add_node(autoware_node->get_node_base_interface());
+  const auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while (received_message == nullptr && std::chrono::steady_clock::now() < timeout) {
+    executor.spin_once(std::chrono::milliseconds(10));
+  }
+
+  ASSERT_NE(received_message, nullptr);
+  EXPECT_EQ(received_message->data.size(), 16u);
+  delete received_message;
+}
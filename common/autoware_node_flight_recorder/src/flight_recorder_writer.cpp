@@ -0,0 +1,65 @@
+// Copyright 2024 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <autoware/node/flight_recorder.hpp>
+#include <rclcpp/rclcpp.hpp>
+#include <rcutils/visibility_control_macros.h>
+#include <rosbag2_cpp/writer.hpp>
+#include <rosbag2_storage/storage_options.hpp>
+#include <rosbag2_storage/topic_metadata.hpp>
+
+#include <cstdint>
+#include <string>
+
+namespace autoware::node
+{
+
+namespace
+{
+class Rosbag2FlightRecorderWriter : public FlightRecorderWriter
+{
+public:
+  void open(const std::string & path) override
+  {
+    rosbag2_storage::StorageOptions storage_options;
+    storage_options.uri = path;
+    storage_options.storage_id = "sqlite3";
+    writer_.open(storage_options, {"cdr", "cdr"});
+  }
+
+  void create_topic(const std::string & topic_name, const std::string & type_name) override
+  {
+    writer_.create_topic({topic_name, type_name, "cdr", ""});
+  }
+
+  void write(
+    const rclcpp::SerializedMessage & message, const std::string & topic_name,
+    const std::string & type_name, const int64_t time) override
+  {
+    writer_.write(message, topic_name, type_name, rclcpp::Time(time));
+  }
+
+private:
+  rosbag2_cpp::Writer writer_;
+};
+}  // namespace
+
+}  // namespace autoware::node
+
+extern "C" RCUTILS_EXPORT autoware::node::FlightRecorderWriter *
+autoware_node_create_flight_recorder_writer()
+{
+  return new autoware::node::Rosbag2FlightRecorderWriter();
+}
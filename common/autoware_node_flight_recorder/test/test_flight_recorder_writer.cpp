@@ -0,0 +1,92 @@
+// Copyright 2024 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <autoware/node/flight_recorder.hpp>
+#include <autoware/node/node.hpp>
+#include <rclcpp/rclcpp.hpp>
+#include <rosbag2_cpp/reader.hpp>
+
+#include <std_msgs/msg/string.hpp>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <filesystem>
+#include <memory>
+#include <string>
+
+using namespace std::chrono_literals;
+using std_msgs::msg::String;
+
+class AutowareNodeFlightRecorderWriter : public ::testing::Test
+{
+public:
+  void SetUp() override { rclcpp::init(0, nullptr); }
+
+  void TearDown() override { rclcpp::shutdown(); }
+
+  rclcpp::NodeOptions node_options_an_;
+};
+
+TEST_F(AutowareNodeFlightRecorderWriter, SnapshotToBag)
+{
+  const std::string directory = testing::TempDir() + "flight_recorder_test";
+  std::filesystem::remove_all(directory);
+  node_options_an_.parameter_overrides(
+    {{"flight_recorder.enabled", true},
+     {"flight_recorder.directory", directory},
+     {"flight_recorder.max_messages", 2},
+     {"flight_recorder.topics.test_ns.ignored.max_messages", 0}});
+  auto autoware_node =
+    std::make_shared<autoware::node::Node>("test_node", "test_ns", node_options_an_);
+  ASSERT_NE(autoware_node->get_flight_recorder(), nullptr);
+
+  int received_count = 0;
+  auto subscription = autoware_node->create_monitored_subscription<String>(
+    "input", rclcpp::QoS(10), [&received_count](String::ConstSharedPtr) { ++received_count; });
+  auto ignored_subscription = autoware_node->create_monitored_subscription<String>(
+    "ignored", rclcpp::QoS(10), [](String::ConstSharedPtr) {});
+
+  auto publisher_node = std::make_shared<rclcpp::Node>("publisher_node", "test_ns");
+  auto publisher = publisher_node->create_publisher<String>("input", rclcpp::QoS(10));
+  auto ignored_publisher = publisher_node->create_publisher<String>("ignored", rclcpp::QoS(10));
+
+  rclcpp::executors::SingleThreadedExecutor executor;
+  executor.add_node(autoware_node->get_node_base_interface());
+  const auto deadline = std::chrono::steady_clock::now() + 3s;
+  while (received_count < 3 && std::chrono::steady_clock::now() < deadline) {
+    String message;
+    message.data = "data";
+    publisher->publish(message);
+    ignored_publisher->publish(message);
+    executor.spin_some(10ms);
+  }
+  ASSERT_GE(received_count, 3);
+
+  const std::string path = autoware_node->snapshot_flight_recorder("test");
+  autoware_node->get_flight_recorder()->wait_for_snapshots();
+
+  // only the last messages within the capacity of the recorded topic are written
+  rosbag2_cpp::Reader reader;
+  reader.open(path);
+  size_t count = 0;
+  while (reader.has_next()) {
+    const auto message = reader.read_next();
+    EXPECT_EQ(message->topic_name, "/test_ns/input");
+    ++count;
+  }
+  EXPECT_EQ(count, 2u);
+  std::filesystem::remove_all(directory);
+}
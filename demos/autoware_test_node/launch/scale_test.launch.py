@@ -0,0 +1,64 @@
+# Copyright 2024 The Autoware Contributors
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# Composes num_nodes test nodes, /scale_test/test_node_<i>, into num_containers containers.
+
+from launch import LaunchDescription
+from launch.actions import DeclareLaunchArgument
+from launch.actions import OpaqueFunction
+from launch.substitutions import LaunchConfiguration
+from launch_ros.actions import ComposableNodeContainer
+from launch_ros.descriptions import ComposableNode
+
+
+def launch_setup(context):
+    num_nodes = int(LaunchConfiguration("num_nodes").perform(context))
+    num_containers = max(int(LaunchConfiguration("num_containers").perform(context)), 1)
+    container_executable = LaunchConfiguration("container_executable").perform(context)
+
+    containers = []
+    for container_index in range(num_containers):
+        nodes = [
+            ComposableNode(
+                package="autoware_test_node",
+                plugin="autoware::test_node::TestNode",
+                name=f"test_node_{node_index}",
+                namespace="scale_test",
+                # scale_test reads the construction time from the reports
+                parameters=[{"lifecycle_timing.publish": True}],
+            )
+            for node_index in range(container_index, num_nodes, num_containers)
+        ]
+        containers.append(
+            ComposableNodeContainer(
+                name=f"container_{container_index}",
+                namespace="scale_test",
+                package="rclcpp_components",
+                executable=container_executable,
+                composable_node_descriptions=nodes,
+                output="screen",
+            )
+        )
+    return containers
+
+
+def generate_launch_description():
+    return LaunchDescription(
+        [
+            DeclareLaunchArgument("num_nodes", default_value="100"),
+            DeclareLaunchArgument("num_containers", default_value="1"),
+            DeclareLaunchArgument("container_executable", default_value="component_container"),
+            OpaqueFunction(function=launch_setup),
+        ]
+    )
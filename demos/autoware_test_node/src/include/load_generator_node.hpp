@@ -0,0 +1,54 @@
+// Copyright 2024 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef LOAD_GENERATOR_NODE_HPP_
+#define LOAD_GENERATOR_NODE_HPP_
+
+#include <autoware/node/node.hpp>
+#include <rclcpp_lifecycle/lifecycle_node.hpp>
+
+#include <sensor_msgs/msg/point_cloud2.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace autoware::test_node
+{
+
+/**
+ * @brief Publishes point clouds of a fixed size at a fixed rate on `load_0` ... `load_<n-1>`,
+ * stamped with the publish time, while it is active.
+ */
+class LoadGeneratorNode : public autoware::node::Node
+{
+public:
+  explicit LoadGeneratorNode(const rclcpp::NodeOptions & options = rclcpp::NodeOptions());
+
+  uint64_t get_published_count() const { return published_count_.load(); }
+
+private:
+  void on_publish();
+
+  std::vector<rclcpp_lifecycle::LifecyclePublisher<sensor_msgs::msg::PointCloud2>::SharedPtr>
+    publishers_;
+  rclcpp::TimerBase::SharedPtr publish_timer_;
+  rclcpp::TimerBase::SharedPtr autostart_timer_;
+  size_t message_size_;
+  std::atomic<uint64_t> published_count_{0};
+};
+
+}  // namespace autoware::test_node
+
+#endif  // LOAD_GENERATOR_NODE_HPP_
@@ -0,0 +1,72 @@
+// Copyright 2024 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef LOAD_SINK_NODE_HPP_
+#define LOAD_SINK_NODE_HPP_
+
+#include <autoware/node/latency_histogram.hpp>
+#include <autoware/node/node.hpp>
+
+#include <sensor_msgs/msg/point_cloud2.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace autoware::test_node
+{
+
+struct LoadReport
+{
+  uint64_t count{0};
+  double throughput{0.0};  // [msg/s]
+  double bandwidth{0.0};   // [MB/s]
+  autoware::node::LatencyHistogramSnapshot latency;
+  double process_cpu_usage{0.0};  // [%] of a core
+  double node_cpu_usage{0.0};     // [%] of a core, of the subscription callbacks
+};
+
+/**
+ * @brief Subscribes to the topics of LoadGeneratorNode and reports the end-to-end latency from the
+ * publish time, the throughput and the CPU use every `report_period` seconds.
+ */
+class LoadSinkNode : public autoware::node::Node
+{
+public:
+  explicit LoadSinkNode(const rclcpp::NodeOptions & options = rclcpp::NodeOptions());
+
+  uint64_t get_received_count() const { return received_count_.load(); }
+  // statistics since the previous report, which are then reset
+  LoadReport take_report();
+
+private:
+  void on_message(const sensor_msgs::msg::PointCloud2::ConstSharedPtr & message);
+  void on_report();
+
+  std::vector<rclcpp::Subscription<sensor_msgs::msg::PointCloud2>::SharedPtr> subscriptions_;
+  rclcpp::TimerBase::SharedPtr report_timer_;
+  autoware::node::LatencyHistogram latency_;
+  std::atomic<uint64_t> received_count_{0};
+  std::atomic<uint64_t> received_bytes_{0};
+  uint64_t reported_count_{0};
+  uint64_t reported_bytes_{0};
+  uint64_t reported_process_cpu_time_{0};
+  uint64_t reported_node_cpu_time_{0};
+  std::chrono::steady_clock::time_point reported_time_;
+};
+
+}  // namespace autoware::test_node
+
+#endif  // LOAD_SINK_NODE_HPP_
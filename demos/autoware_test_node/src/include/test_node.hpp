@@ -18,6 +18,11 @@
 #include <autoware/node/node.hpp>
 #include <rclcpp_lifecycle/lifecycle_node.hpp>
 
+#include <std_msgs/msg/u_int64.hpp>
+
+#include <atomic>
+#include <cstdint>
+
 namespace autoware::test_node
 {
 
@@ -25,6 +30,19 @@ class TestNode : public autoware::node::Node
 {
 public:
   explicit TestNode(const rclcpp::NodeOptions & options = rclcpp::NodeOptions());
+
+  uint64_t get_heartbeat_count() const { return heartbeat_count_.load(); }
+
+private:
+  void on_heartbeat();
+
+  rclcpp_lifecycle::LifecyclePublisher<
+    std_msgs::msg::UInt64, autoware::node::PoolAllocator<void>>::SharedPtr heartbeat_publisher_;
+  rclcpp::TimerBase::SharedPtr heartbeat_timer_;
+  autoware::node::CoalescedTimer::SharedPtr heartbeat_coalesced_timer_;
+  // reused, so that publishing does not allocate
+  std_msgs::msg::UInt64 heartbeat_;
+  std::atomic<uint64_t> heartbeat_count_{0};
 };
 
 }  // namespace autoware::test_node
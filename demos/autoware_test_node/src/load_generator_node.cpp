@@ -0,0 +1,78 @@
+// Copyright 2024 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "include/load_generator_node.hpp"
+
+#include <autoware/node/node.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+
+namespace autoware::test_node
+{
+LoadGeneratorNode::LoadGeneratorNode(const rclcpp::NodeOptions & options)
+: autoware::node::Node("load_generator", "", options)
+{
+  message_size_ =
+    static_cast<size_t>(std::max<int64_t>(declare_parameter<int64_t>("message_size", 1024), 0));
+  const double rate = declare_parameter<double>("rate", 100.0);
+  const int64_t num_publishers = declare_parameter<int64_t>("num_publishers", 1);
+  const auto qos_depth = declare_parameter<int64_t>("qos_depth", 10);
+
+  for (int64_t i = 0; i < num_publishers; ++i) {
+    publishers_.push_back(create_publisher<sensor_msgs::msg::PointCloud2>(
+      "load_" + std::to_string(i), rclcpp::QoS(static_cast<size_t>(qos_depth))));
+  }
+  publish_timer_ = create_monitored_timer(
+    "publish", std::chrono::duration<double>(1.0 / std::max(rate, 1e-3)),
+    [this]() { on_publish(); });
+
+  // for the launch files, which cannot trigger lifecycle transitions
+  if (declare_parameter<bool>("autostart", false)) {
+    autostart_timer_ = create_wall_timer(std::chrono::nanoseconds(0), [this]() {
+      autostart_timer_->cancel();
+      configure();
+      activate();
+    });
+  }
+}
+
+void LoadGeneratorNode::on_publish()
+{
+  for (const auto & publisher : publishers_) {
+    if (!publisher->is_activated()) {
+      return;
+    }
+    // a std::unique_ptr is moved to intra-process subscriptions
+    auto message = std::make_unique<sensor_msgs::msg::PointCloud2>();
+    message->header.frame_id = "load";
+    message->height = 1;
+    message->width = static_cast<uint32_t>(message_size_);
+    message->point_step = 1;
+    message->row_step = static_cast<uint32_t>(message_size_);
+    message->is_dense = true;
+    message->data.resize(message_size_);
+    message->header.stamp = now();
+    publisher->publish(std::move(message));
+    published_count_.fetch_add(1);
+  }
+}
+}  // namespace autoware::test_node
+
+#include <rclcpp_components/register_node_macro.hpp>
+RCLCPP_COMPONENTS_REGISTER_NODE(autoware::test_node::LoadGeneratorNode)
@@ -0,0 +1,116 @@
+// Copyright 2024 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "include/load_sink_node.hpp"
+
+#include <autoware/node/node.hpp>
+
+#include <time.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace autoware::test_node
+{
+namespace
+{
+uint64_t get_process_cpu_time()
+{
+  timespec time{};
+  clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &time);
+  return static_cast<uint64_t>(time.tv_sec) * 1000000000 + static_cast<uint64_t>(time.tv_nsec);
+}
+}  // namespace
+
+LoadSinkNode::LoadSinkNode(const rclcpp::NodeOptions & options)
+: autoware::node::Node("load_sink", "", options)
+{
+  const int64_t num_subscriptions = declare_parameter<int64_t>("num_subscriptions", 1);
+  const int64_t num_publishers =
+    std::max<int64_t>(declare_parameter<int64_t>("num_publishers", 1), 1);
+  const auto qos_depth = declare_parameter<int64_t>("qos_depth", 10);
+  const double report_period = declare_parameter<double>("report_period", 1.0);
+
+  // the subscriptions are spread over the topics of the generator
+  for (int64_t i = 0; i < num_subscriptions; ++i) {
+    subscriptions_.push_back(create_monitored_subscription<sensor_msgs::msg::PointCloud2>(
+      "load_" + std::to_string(i % num_publishers), rclcpp::QoS(static_cast<size_t>(qos_depth)),
+      [this](const sensor_msgs::msg::PointCloud2::ConstSharedPtr & message) {
+        on_message(message);
+      }));
+  }
+
+  reported_time_ = std::chrono::steady_clock::now();
+  reported_process_cpu_time_ = get_process_cpu_time();
+  if (report_period > 0.0) {
+    report_timer_ =
+      create_wall_timer(std::chrono::duration<double>(report_period), [this]() { on_report(); });
+  }
+}
+
+void LoadSinkNode::on_message(const sensor_msgs::msg::PointCloud2::ConstSharedPtr & message)
+{
+  const int64_t latency = (now() - rclcpp::Time(message->header.stamp)).nanoseconds();
+  latency_.record(latency > 0 ? static_cast<uint64_t>(latency) : 0);
+  received_count_.fetch_add(1);
+  received_bytes_.fetch_add(message->data.size());
+}
+
+LoadReport LoadSinkNode::take_report()
+{
+  const auto time = std::chrono::steady_clock::now();
+  const double elapsed =
+    std::max(std::chrono::duration<double>(time - reported_time_).count(), 1e-9);
+  const uint64_t count = received_count_.load();
+  const uint64_t bytes = received_bytes_.load();
+  const uint64_t process_cpu_time = get_process_cpu_time();
+  const uint64_t node_cpu_time = get_resource_usage().cpu_time;
+
+  LoadReport report;
+  report.count = count - reported_count_;
+  report.throughput = static_cast<double>(report.count) / elapsed;
+  report.bandwidth = static_cast<double>(bytes - reported_bytes_) / elapsed * 1e-6;
+  report.latency = latency_.snapshot();
+  report.process_cpu_usage =
+    static_cast<double>(process_cpu_time - reported_process_cpu_time_) / elapsed * 1e-7;
+  report.node_cpu_usage =
+    static_cast<double>(node_cpu_time - reported_node_cpu_time_) / elapsed * 1e-7;
+
+  latency_.reset();
+  reported_time_ = time;
+  reported_count_ = count;
+  reported_bytes_ = bytes;
+  reported_process_cpu_time_ = process_cpu_time;
+  reported_node_cpu_time_ = node_cpu_time;
+  return report;
+}
+
+void LoadSinkNode::on_report()
+{
+  const LoadReport report = take_report();
+  RCLCPP_INFO(
+    get_logger(),
+    "%lu msgs, %.1f msg/s, %.2f MB/s, latency [us] p50 %.1f p90 %.1f p99 %.1f max %.1f, "
+    "cpu [%%] process %.1f node %.1f",
+    static_cast<unsigned long>(report.count), report.throughput, report.bandwidth,  // NOLINT
+    report.latency.percentile(50.0) * 1e-3, report.latency.percentile(90.0) * 1e-3,
+    report.latency.percentile(99.0) * 1e-3, report.latency.max * 1e-3, report.process_cpu_usage,
+    report.node_cpu_usage);
+}
+}  // namespace autoware::test_node
+
+#include <rclcpp_components/register_node_macro.hpp>
+RCLCPP_COMPONENTS_REGISTER_NODE(autoware::test_node::LoadSinkNode)
@@ -0,0 +1,336 @@
+// Copyright 2024 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Launches scale_test.launch.py with an increasing number of test nodes, and writes as a CSV row
+// per run the startup, construction, discovery, activation and shutdown times and the memory of
+// the containers.
+//
+// usage: ros2 run autoware_test_node scale_test --ros-args \
+//          -p num_nodes:="[1, 10, 100, 500]" -p num_containers:=1 -p output:=scale_test.csv
+
+#include <rclcpp/rclcpp.hpp>
+
+#include <autoware_node_msgs/msg/lifecycle_timing_report.hpp>
+#include <lifecycle_msgs/msg/transition.hpp>
+#include <lifecycle_msgs/srv/change_state.hpp>
+
+#include <dirent.h>
+#include <signal.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <future>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+using autoware_node_msgs::msg::LifecycleTimingReport;
+using lifecycle_msgs::msg::Transition;
+using lifecycle_msgs::srv::ChangeState;
+using std::chrono::steady_clock;
+
+constexpr char node_namespace[] = "/scale_test";
+constexpr double nan = std::numeric_limits<double>::quiet_NaN();
+
+struct ScaleTestResult
+{
+  int64_t num_nodes{0};
+  int64_t num_containers{0};
+  double startup_time{nan};           // [s] from the launch until all nodes are discovered
+  double construction_time{nan};      // [s] sum of the constructors of autoware::node::Node
+  double max_construction_time{nan};  // [s]
+  double discovery_time{nan};         // [s] from the last construction to the discovery
+  double activation_time{nan};        // [s] to configure and activate all nodes concurrently
+  double rss{nan};                    // [MiB] of the containers
+  double shutdown_time{nan};          // [s] from SIGINT until the launch exits
+};
+
+double to_seconds(const builtin_interfaces::msg::Time & time)
+{
+  return time.sec + time.nanosec * 1e-9;
+}
+
+double to_seconds(const builtin_interfaces::msg::Duration & duration)
+{
+  return duration.sec + duration.nanosec * 1e-9;
+}
+
+double get_elapsed(const steady_clock::time_point start)
+{
+  return std::chrono::duration<double>(steady_clock::now() - start).count();
+}
+
+std::string get_node_name(const int64_t index)
+{
+  return "test_node_" + std::to_string(index);
+}
+
+pid_t start_launch(const int64_t num_nodes, const int64_t num_containers)
+{
+  const std::string num_nodes_argument = "num_nodes:=" + std::to_string(num_nodes);
+  const std::string num_containers_argument = "num_containers:=" + std::to_string(num_containers);
+  const pid_t pid = fork();
+  if (pid == 0) {
+    // in a process group of its own, so that the containers are signaled together
+    setpgid(0, 0);
+    execlp(
+      "ros2", "ros2", "launch", "autoware_test_node", "scale_test.launch.py",
+      num_nodes_argument.c_str(), num_containers_argument.c_str(), nullptr);
+    std::perror("execlp");
+    _exit(1);
+  }
+  setpgid(pid, pid);
+  return pid;
+}
+
+// resident memory of the component containers of the process group
+double get_container_rss(const pid_t process_group)
+{
+  double rss = 0.0;
+  DIR * directory = opendir("/proc");
+  if (!directory) {
+    return nan;
+  }
+  while (const dirent * entry = readdir(directory)) {
+    const pid_t pid = static_cast<pid_t>(std::atoi(entry->d_name));
+    if (pid <= 0 || getpgid(pid) != process_group) {
+      continue;
+    }
+    std::ifstream status("/proc/" + std::to_string(pid) + "/status");
+    std::string line;
+    bool is_container = false;
+    while (std::getline(status, line)) {
+      if (line.rfind("Name:", 0) == 0) {
+        // truncated to 15 characters
+        is_container = line.find("component_conta") != std::string::npos;
+      } else if (is_container && line.rfind("VmRSS:", 0) == 0) {
+        rss += std::stod(line.substr(6)) / 1024.0;
+      }
+    }
+  }
+  closedir(directory);
+  return rss;
+}
+
+class ScaleTest : public rclcpp::Node
+{
+public:
+  ScaleTest() : Node("scale_test")
+  {
+    num_nodes_ = declare_parameter<std::vector<int64_t>>("num_nodes", {1, 10, 50, 100});
+    num_containers_ = std::max<int64_t>(declare_parameter<int64_t>("num_containers", 1), 1);
+    timeout_ = declare_parameter<double>("timeout", 60.0);
+    output_ = declare_parameter<std::string>("output", "scale_test.csv");
+  }
+
+  void run()
+  {
+    std::ofstream output(output_);
+    output << "num_nodes,num_containers,startup_time,construction_time,max_construction_time,"
+              "discovery_time,activation_time,rss,rss_per_node,shutdown_time\n";
+    for (const int64_t num_nodes : num_nodes_) {
+      if (!rclcpp::ok()) {
+        break;
+      }
+      const ScaleTestResult result = run_once(num_nodes);
+      output << result.num_nodes << ',' << result.num_containers << ',' << result.startup_time
+             << ',' << result.construction_time << ',' << result.max_construction_time << ','
+             << result.discovery_time << ',' << result.activation_time << ',' << result.rss << ','
+             << (result.num_nodes > 0 ? result.rss / result.num_nodes : nan) << ','
+             << result.shutdown_time << std::endl;
+      RCLCPP_INFO(
+        get_logger(),
+        "%ld nodes: startup %.2f s, construction %.3f s, discovery %.2f s, activation %.2f s, "
+        "%.1f MiB, shutdown %.2f s",
+        static_cast<long>(num_nodes), result.startup_time, result.construction_time,  // NOLINT
+        result.discovery_time, result.activation_time, result.rss, result.shutdown_time);
+    }
+    RCLCPP_INFO(get_logger(), "Results were written to %s.", output_.c_str());
+  }
+
+private:
+  ScaleTestResult run_once(const int64_t num_nodes)
+  {
+    ScaleTestResult result;
+    result.num_nodes = num_nodes;
+    result.num_containers = num_containers_;
+
+    // subscribed before the launch, the reports are latched anyway
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      reports_.clear();
+    }
+    std::vector<rclcpp::Subscription<LifecycleTimingReport>::SharedPtr> subscriptions;
+    std::vector<rclcpp::Client<ChangeState>::SharedPtr> clients;
+    for (int64_t i = 0; i < num_nodes; ++i) {
+      const std::string name = std::string(node_namespace) + "/" + get_node_name(i);
+      subscriptions.push_back(create_subscription<LifecycleTimingReport>(
+        name + "/lifecycle_timing", rclcpp::QoS(1).reliable().transient_local(),
+        [this](const LifecycleTimingReport::ConstSharedPtr report) {
+          std::lock_guard<std::mutex> lock(mutex_);
+          reports_[report->node_name] = *report;
+        }));
+      clients.push_back(create_client<ChangeState>(name + "/change_state"));
+    }
+
+    const auto launch_time = steady_clock::now();
+    const pid_t pid = start_launch(num_nodes, num_containers_);
+
+    // discovery of all nodes by this process
+    if (wait_until([&]() { return count_discovered_nodes() >= num_nodes; })) {
+      result.startup_time = get_elapsed(launch_time);
+      const double discovered_time = now().seconds();
+      if (wait_until([&]() { return count_reports("construct") >= num_nodes; })) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        double last_construction_end = 0.0;
+        result.construction_time = 0.0;
+        result.max_construction_time = 0.0;
+        for (const auto & [name, report] : reports_) {
+          for (const auto & timing : report.transitions) {
+            if (timing.label == "construct") {
+              const double duration = to_seconds(timing.duration);
+              result.construction_time += duration;
+              result.max_construction_time = std::max(result.max_construction_time, duration);
+              last_construction_end =
+                std::max(last_construction_end, to_seconds(timing.start_time) + duration);
+            }
+          }
+        }
+        result.discovery_time = std::max(discovered_time - last_construction_end, 0.0);
+      }
+
+      const auto activation_start = steady_clock::now();
+      if (
+        change_states(clients, Transition::TRANSITION_CONFIGURE) &&
+        change_states(clients, Transition::TRANSITION_ACTIVATE)) {
+        result.activation_time = get_elapsed(activation_start);
+      }
+      result.rss = get_container_rss(pid);
+    } else {
+      RCLCPP_ERROR(
+        get_logger(), "Not all of the %ld nodes were discovered.",
+        static_cast<long>(num_nodes));  // NOLINT
+    }
+
+    const auto shutdown_start = steady_clock::now();
+    kill(-pid, SIGINT);
+    int status = 0;
+    while (waitpid(pid, &status, WNOHANG) == 0) {
+      if (get_elapsed(shutdown_start) > timeout_) {
+        kill(-pid, SIGKILL);
+        waitpid(pid, &status, 0);
+        return result;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    result.shutdown_time = get_elapsed(shutdown_start);
+    return result;
+  }
+
+  template <typename PredicateT>
+  bool wait_until(PredicateT && predicate) const
+  {
+    const auto start = steady_clock::now();
+    while (rclcpp::ok() && get_elapsed(start) < timeout_) {
+      if (predicate()) {
+        return true;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return false;
+  }
+
+  int64_t count_discovered_nodes() const
+  {
+    const std::string prefix = std::string(node_namespace) + "/test_node_";
+    int64_t count = 0;
+    for (const auto & name : get_node_names()) {
+      count += name.rfind(prefix, 0) == 0 ? 1 : 0;
+    }
+    return count;
+  }
+
+  int64_t count_reports(const std::string & label)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return std::count_if(reports_.begin(), reports_.end(), [&label](const auto & report) {
+      const auto & transitions = report.second.transitions;
+      return std::any_of(transitions.begin(), transitions.end(), [&label](const auto & timing) {
+        return timing.label == label;
+      });
+    });
+  }
+
+  // requests the transition of all nodes at once and waits for the responses
+  bool change_states(
+    const std::vector<rclcpp::Client<ChangeState>::SharedPtr> & clients, const uint8_t transition)
+  {
+    std::vector<rclcpp::Client<ChangeState>::SharedFuture> futures;
+    for (const auto & client : clients) {
+      if (!client->wait_for_service(std::chrono::duration<double>(timeout_))) {
+        RCLCPP_ERROR(get_logger(), "%s is not available.", client->get_service_name());
+        return false;
+      }
+      auto request = std::make_shared<ChangeState::Request>();
+      request->transition.id = transition;
+      futures.push_back(client->async_send_request(request).future.share());
+    }
+    const auto deadline = steady_clock::now() + std::chrono::duration<double>(timeout_);
+    for (const auto & future : futures) {
+      if (
+        future.wait_until(deadline) != std::future_status::ready || !future.get()->success) {
+        RCLCPP_ERROR(get_logger(), "Transition %u failed.", transition);
+        return false;
+      }
+    }
+    return true;
+  }
+
+  std::vector<int64_t> num_nodes_;
+  int64_t num_containers_;
+  double timeout_;
+  std::string output_;
+  std::mutex mutex_;
+  std::map<std::string, LifecycleTimingReport> reports_;
+};
+}  // namespace
+
+int main(int argc, char ** argv)
+{
+  rclcpp::init(argc, argv);
+  auto scale_test = std::make_shared<ScaleTest>();
+  rclcpp::executors::MultiThreadedExecutor executor;
+  executor.add_node(scale_test);
+  std::thread thread_spin([&executor]() { executor.spin(); });
+  scale_test->run();
+  executor.cancel();
+  thread_spin.join();
+  rclcpp::shutdown();
+  return 0;
+}
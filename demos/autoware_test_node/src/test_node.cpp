@@ -16,6 +16,8 @@
 
 #include <autoware/node/node.hpp>
 
+#include <chrono>
+
 namespace autoware::test_node
 {
 TestNode::TestNode(const rclcpp::NodeOptions & options)
@@ -24,6 +26,32 @@ TestNode::TestNode(const rclcpp::NodeOptions & options)
   RCLCPP_DEBUG(
     get_logger(), "TestNode %s constructor was called.",
     get_node_base_interface()->get_fully_qualified_name());
+
+  // disabled by default, so that the scale test measures idle nodes
+  const double heartbeat_period = declare_parameter<double>("heartbeat_period", 0.0);
+  if (heartbeat_period <= 0.0) {
+    return;
+  }
+  heartbeat_publisher_ =
+    create_pooled_publisher<std_msgs::msg::UInt64>("~/heartbeat", rclcpp::QoS(1));
+  const auto period = std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::duration<double>(heartbeat_period));
+  // the timer coalescer allocates for each expiration on its own thread, so that a node in the
+  // zero-allocation mode keeps its heartbeat on a timer of its executor
+  if (get_allocation_monitor()) {
+    heartbeat_timer_ = create_wall_timer(period, [this]() { on_heartbeat(); });
+  } else {
+    heartbeat_coalesced_timer_ = create_coalesced_timer(period, [this]() { on_heartbeat(); });
+  }
+}
+
+void TestNode::on_heartbeat()
+{
+  if (!heartbeat_publisher_->is_activated()) {
+    return;
+  }
+  heartbeat_.data = heartbeat_count_.fetch_add(1) + 1;
+  heartbeat_publisher_->publish(heartbeat_);
 }
 }  // namespace autoware::test_node
 
@@ -0,0 +1,77 @@
+// Copyright 2024 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "include/load_generator_node.hpp"
+#include "include/load_sink_node.hpp"
+
+#include <rclcpp/rclcpp.hpp>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <memory>
+#include <thread>
+
+using namespace std::chrono_literals;
+
+class TestNodeLoadTest : public ::testing::Test
+{
+public:
+  void SetUp() override { rclcpp::init(0, nullptr); }
+
+  void TearDown() override { rclcpp::shutdown(); }
+
+  rclcpp::NodeOptions node_options_an_;
+};
+
+TEST_F(TestNodeLoadTest, GeneratorToSink)
+{
+  node_options_an_.use_intra_process_comms(true);
+  node_options_an_.parameter_overrides(
+    {{"message_size", 4096},
+     {"rate", 200.0},
+     {"num_publishers", 2},
+     {"num_subscriptions", 4},
+     {"report_period", 0.0}});
+  auto generator = std::make_shared<autoware::test_node::LoadGeneratorNode>(node_options_an_);
+  auto sink = std::make_shared<autoware::test_node::LoadSinkNode>(node_options_an_);
+
+  rclcpp::executors::SingleThreadedExecutor executor;
+  executor.add_node(generator->get_node_base_interface());
+  executor.add_node(sink->get_node_base_interface());
+  std::thread thread_spin([&executor]() { executor.spin(); });
+
+  // nothing is published before the activation
+  std::this_thread::sleep_for(100ms);
+  EXPECT_EQ(generator->get_published_count(), 0u);
+
+  generator->configure();
+  generator->activate();
+  std::this_thread::sleep_for(500ms);
+  generator->deactivate();
+  std::this_thread::sleep_for(50ms);
+  executor.cancel();
+  thread_spin.join();
+
+  // every message is received by the two subscriptions of its topic
+  const uint64_t published_count = generator->get_published_count();
+  EXPECT_GT(published_count, 20u);
+  EXPECT_EQ(sink->get_received_count(), 2 * published_count);
+
+  const auto report = sink->take_report();
+  EXPECT_EQ(report.count, 2 * published_count);
+  EXPECT_EQ(report.latency.count, report.count);
+  EXPECT_GT(report.bandwidth, 0.0);
+  EXPECT_GE(report.process_cpu_usage, report.node_cpu_usage);
+}
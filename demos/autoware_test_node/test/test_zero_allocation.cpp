@@ -0,0 +1,122 @@
+// Copyright 2024 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "include/test_node.hpp"
+
+#include <autoware/node/allocation_monitor.hpp>
+#include <autoware/node/malloc_hook.hpp>
+#include <rclcpp/rclcpp.hpp>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <memory>
+#include <thread>
+
+AUTOWARE_NODE_DEFINE_MALLOC_HOOK()
+
+using autoware::node::AllocationMonitor;
+using autoware::node::AllocationPolicy;
+using namespace std::chrono_literals;
+
+class TestNodeZeroAllocation : public ::testing::Test
+{
+public:
+  void SetUp() override { rclcpp::init(0, nullptr); }
+
+  void TearDown() override { rclcpp::shutdown(); }
+
+  rclcpp::NodeOptions node_options_an_;
+};
+
+TEST_F(TestNodeZeroAllocation, HookCountsGuardedAllocations)
+{
+  // called through a volatile pointer, so that the allocation is not elided
+  void * (*volatile allocate)(std::size_t) = std::malloc;
+
+  AllocationMonitor monitor(AllocationPolicy::Report, 0ns);
+  monitor.arm();
+  void * unguarded = allocate(32);
+  AllocationMonitor::set_thread_monitor(&monitor);
+  void * guarded = allocate(64);
+  AllocationMonitor::set_thread_monitor(nullptr);
+  monitor.disarm();
+  std::free(unguarded);
+  std::free(guarded);
+
+  EXPECT_TRUE(AllocationMonitor::is_hook_installed());
+  EXPECT_EQ(monitor.get_allocation_count(), 1u);
+  EXPECT_EQ(monitor.get_last_allocation_size(), 64u);
+}
+
+TEST_F(TestNodeZeroAllocation, PolicyAppliesToTheThreadsOfItsMonitor)
+{
+  void * (*volatile allocate)(std::size_t) = std::malloc;
+
+  // the aborting monitor of another node is armed, but does not guard this thread
+  AllocationMonitor aborting_monitor(AllocationPolicy::Abort, 0ns);
+  AllocationMonitor reporting_monitor(AllocationPolicy::Report, 0ns);
+  aborting_monitor.arm();
+  reporting_monitor.arm();
+  AllocationMonitor::set_thread_monitor(&reporting_monitor);
+  void * guarded = allocate(64);
+  AllocationMonitor::set_thread_monitor(nullptr);
+  aborting_monitor.disarm();
+  reporting_monitor.disarm();
+  std::free(guarded);
+
+  EXPECT_EQ(aborting_monitor.get_allocation_count(), 0u);
+  EXPECT_EQ(reporting_monitor.get_allocation_count(), 1u);
+}
+
+TEST_F(TestNodeZeroAllocation, SteadyStateIsAllocationFree)
+{
+  node_options_an_.parameter_overrides(
+    {{"zero_allocation.enabled", true},
+     {"zero_allocation.warmup", 0.2},
+     {"heartbeat_period", 0.005}});
+  auto test_node = std::make_shared<autoware::test_node::TestNode>(node_options_an_);
+  ASSERT_NE(test_node->get_memory_pool(), nullptr);
+  const auto monitor = test_node->get_allocation_monitor();
+  ASSERT_NE(monitor, nullptr);
+
+  // the heartbeat of the node runs on the executor thread, which is the only one it uses
+  rclcpp::executors::SingleThreadedExecutor executor(test_node->get_pooled_executor_options());
+  executor.add_node(test_node->get_node_base_interface());
+  std::thread thread_spin([&executor, &monitor]() {
+    AllocationMonitor::set_thread_monitor(monitor.get());
+    executor.spin();
+    AllocationMonitor::set_thread_monitor(nullptr);
+  });
+
+  test_node->configure();
+  test_node->activate();
+  EXPECT_TRUE(monitor->is_armed());
+  std::this_thread::sleep_for(1s);
+  const uint64_t allocation_count = monitor->get_allocation_count();
+  const uint64_t heartbeat_count = test_node->get_heartbeat_count();
+  test_node->deactivate();
+  EXPECT_FALSE(monitor->is_armed());
+
+  while (!executor.is_spinning()) {
+    std::this_thread::sleep_for(1ms);
+  }
+  executor.cancel();
+  thread_spin.join();
+
+  EXPECT_GT(heartbeat_count, 50u);
+  EXPECT_EQ(allocation_count, 0u) << "last allocation of " << monitor->get_last_allocation_size()
+                                  << " bytes";
+}